@@ -29,6 +29,7 @@
 #include <stdint.h>
 
 #include "splash/splash.h"
+#include "splash/DistributedDomainCollector.hpp"
 
 using namespace splash;
 
@@ -38,6 +39,9 @@ using namespace splash;
  *
  * The program expects the base part to a distributed libSplash file, i.e.
  * 'my_data', given that you have files like 'my_data_0_0_0.h5', ...
+ *
+ * Afterwards, all processes read the complete domain collectively using
+ * the DistributedDomainCollector class.
  */
 
 void filesToProcesses(int mpiSize, int mpiRank, int fileMPISize,
@@ -199,6 +203,54 @@ int main(int argc, char **argv)
         dc.close();
     }
 
+    // Collective read of merged files: every file is opened by a single
+    // process and the data is sent to the processes requesting it.
+    // Here, only the first process requests the complete domain.
+    {
+        DistributedDomainCollector ddc(MPI_COMM_WORLD, 100);
+        fAttr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fAttr.mpiSize.set(file_mpi_size);
+        ddc.open(filename.c_str(), fAttr);
+
+        size_t num_ids = 0;
+        ddc.getEntryIDs(NULL, &num_ids);
+
+        if (num_ids > 0)
+        {
+            int32_t *ids = new int32_t[num_ids];
+            ddc.getEntryIDs(ids, &num_ids);
+
+            size_t num_entries = 0;
+            ddc.getEntriesForID(ids[0], NULL, &num_entries);
+
+            if (num_entries > 0)
+            {
+                DataCollector::DCEntry *entries = new DataCollector::DCEntry[num_entries];
+                ddc.getEntriesForID(ids[0], entries, &num_entries);
+
+                const char *name = entries[0].name.c_str();
+                Domain request;
+                if (mpi_rank == 0)
+                    request = ddc.getGlobalDomain(ids[0], name);
+
+                DomainCollector::DomDataClass dataClass = DomainCollector::UndefinedType;
+                DataContainer *container = ddc.readDomainCollective(ids[0], name,
+                        request, &dataClass);
+
+                std::cout << mpi_rank << ": collectively read " <<
+                        container->getNumElements() << " elements of " <<
+                        name << std::endl;
+
+                delete container;
+                delete[] entries;
+            }
+
+            delete[] ids;
+        }
+
+        ddc.close();
+    }
+
     MPI_Finalize();
 
     return 0;
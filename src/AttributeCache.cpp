@@ -0,0 +1,272 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "splash/core/AttributeCache.hpp"
+#include "splash/core/H5IdWrapper.hpp"
+
+namespace splash
+{
+
+    static size_t findName(const std::vector<const char*> &names, const char *name)
+    {
+        size_t index = 0;
+        while (index < names.size() && strcmp(name, names[index]) != 0)
+            index++;
+
+        return index;
+    }
+
+    AttributeCache::AttributeCache(size_t maxObjects) :
+    maxObjects(maxObjects)
+    {
+    }
+
+    AttributeCache::~AttributeCache()
+    {
+        clear();
+    }
+
+    void AttributeCache::setMaxObjects(size_t maxObjects)
+    {
+        this->maxObjects = maxObjects;
+        if (objects.size() > maxObjects)
+            clear();
+    }
+
+    size_t AttributeCache::getMaxObjects() const
+    {
+        return maxObjects;
+    }
+
+    bool AttributeCache::isFixedSize(hid_t type)
+    {
+        switch (H5Tget_class(type))
+        {
+            case H5T_VLEN:
+                return false;
+            case H5T_STRING:
+                return H5Tis_variable_str(type) == 0;
+            case H5T_ARRAY:
+            {
+                H5TypeId super(H5Tget_super(type));
+                return super && isFixedSize(super);
+            }
+            case H5T_COMPOUND:
+            {
+                const int nmembers = H5Tget_nmembers(type);
+                for (int i = 0; i < nmembers; ++i)
+                {
+                    H5TypeId member(H5Tget_member_type(type, (unsigned) i));
+                    if (!member || !isFixedSize(member))
+                        return false;
+                }
+                return nmembers >= 0;
+            }
+            default:
+                return true;
+        }
+    }
+
+    herr_t AttributeCache::loadCallback(hid_t location, const char *name,
+            const H5A_info_t* /*info*/, void *op_data)
+    {
+        LoadParam *param = (LoadParam*) op_data;
+
+        const size_t index = findName(param->names, name);
+        if (index == param->names.size())
+            return 0;
+
+        param->found[index] = true;
+        param->numFound++;
+
+        H5AttributeId attr(H5Aopen(location, name, H5P_DEFAULT));
+        if (!attr)
+            return -1;
+
+        hid_t type = H5Aget_type(attr);
+        if (type < 0)
+            return -1;
+
+        // variable-length data is read on request only
+        if (!isFixedSize(type))
+        {
+            H5Tclose(type);
+            return 0;
+        }
+
+        H5DataspaceId dsp(H5Aget_space(attr));
+        const hssize_t elements = dsp ? H5Sget_simple_extent_npoints(dsp) : -1;
+        if (elements < 0)
+        {
+            H5Tclose(type);
+            return -1;
+        }
+
+        Value &value = (*param->values)[name];
+        value.type = type;
+        value.elements = elements;
+        value.data.resize(std::max(H5Tget_size(type) * value.elements, (size_t) 1));
+
+        if (H5Aread(attr, type, &(value.data[0])) < 0)
+            return -1;
+
+        param->numRead++;
+
+        // stop iterating when all attributes have been found
+        return (param->numFound == param->names.size()) ? 1 : 0;
+    }
+
+    size_t AttributeCache::load(const std::string &key, hid_t parent,
+            const DCAttribute::BulkEntry *entries, size_t count)
+    throw (DCException)
+    {
+        if (maxObjects == 0)
+            return 0;
+
+        if (objects.size() >= maxObjects && objects.find(key) == objects.end())
+            clear();
+
+        LoadParam param;
+        param.values = &(objects[key]);
+        param.numFound = 0;
+        param.numRead = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (param.values->find(entries[i].name) == param.values->end() &&
+                    findName(param.names, entries[i].name) == param.names.size())
+                param.names.push_back(entries[i].name);
+        }
+
+        if (param.names.empty())
+            return 0;
+
+        param.found.assign(param.names.size(), false);
+
+        if (H5Aiterate2(parent, H5_INDEX_NAME, H5_ITER_NATIVE, NULL,
+                loadCallback, &param) < 0)
+        {
+            closeValues(*(param.values));
+            objects.erase(key);
+            throw DCException(std::string("Exception for AttributeCache::load: "
+                    "failed to read attributes (") + key + std::string(")"));
+        }
+
+        // remember attributes which do not exist
+        for (size_t i = 0; i < param.names.size(); ++i)
+        {
+            if (!param.found[i])
+            {
+                Value &value = (*param.values)[param.names[i]];
+                value.type = -1;
+                value.elements = 0;
+            }
+        }
+
+        return param.numRead;
+    }
+
+    bool AttributeCache::isMissing(const std::string &key,
+            const DCAttribute::BulkEntry *entries, size_t count) const
+    {
+        ObjectMap::const_iterator object = objects.find(key);
+        if (object == objects.end())
+            return false;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            ValueMap::const_iterator iter = object->second.find(entries[i].name);
+            if (iter != object->second.end() && iter->second.type < 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    bool AttributeCache::read(const std::string &key,
+            const DCAttribute::BulkEntry *entries, size_t count)
+    throw (DCException)
+    {
+        ObjectMap::const_iterator object = objects.find(key);
+        if (object == objects.end())
+            return false;
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            ValueMap::const_iterator iter = object->second.find(entries[i].name);
+            if (iter == object->second.end())
+                return false;
+
+            const Value &value = iter->second;
+            if (value.type < 0)
+                return false;
+
+            const size_t src_size = H5Tget_size(value.type) * value.elements;
+            const size_t dst_size = H5Tget_size(entries[i].type) * value.elements;
+
+            if (H5Tequal(value.type, entries[i].type) > 0)
+            {
+                memcpy(entries[i].data, &(value.data[0]), src_size);
+                continue;
+            }
+
+            // convert in place in a buffer large enough for both datatypes
+            std::vector<uint8_t> buffer(std::max(std::max(src_size, dst_size), (size_t) 1));
+            std::vector<uint8_t> background(buffer.size(), 0);
+            memcpy(&(buffer[0]), &(value.data[0]), src_size);
+
+            if (H5Tconvert(value.type, entries[i].type, value.elements,
+                    &(buffer[0]), &(background[0]), H5P_DEFAULT) < 0)
+                throw DCException(std::string("Exception for AttributeCache::read: "
+                        "failed to convert attribute (") + entries[i].name + std::string(")"));
+
+            memcpy(entries[i].data, &(buffer[0]), dst_size);
+        }
+
+        return true;
+    }
+
+    void AttributeCache::closeValues(ValueMap &values)
+    {
+        for (ValueMap::iterator iter = values.begin(); iter != values.end(); ++iter)
+        {
+            if (iter->second.type >= 0)
+                H5Tclose(iter->second.type);
+        }
+        values.clear();
+    }
+
+    void AttributeCache::clear()
+    {
+        for (ObjectMap::iterator iter = objects.begin(); iter != objects.end(); ++iter)
+            closeValues(iter->second);
+        objects.clear();
+    }
+
+    size_t AttributeCache::getNumObjects() const
+    {
+        return objects.size();
+    }
+
+}
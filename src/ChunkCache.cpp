@@ -0,0 +1,125 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "splash/core/ChunkCache.hpp"
+
+namespace splash
+{
+
+    ChunkCache::ChunkCache(size_t maxBytes) :
+    size(0),
+    maxBytes(maxBytes)
+    {
+    }
+
+    void ChunkCache::setMaxBytes(size_t maxBytes)
+    {
+        this->maxBytes = maxBytes;
+        evict(maxBytes);
+    }
+
+    size_t ChunkCache::getMaxBytes() const
+    {
+        return maxBytes;
+    }
+
+    bool ChunkCache::LessChunkKey::operator()(const ChunkKey &a,
+            const ChunkKey &b) const
+    {
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+        {
+            if (a.origin[i] != b.origin[i])
+                return a.origin[i] < b.origin[i];
+        }
+
+        return a.key < b.key;
+    }
+
+    ChunkCache::ChunkKey ChunkCache::makeKey(const std::string &key,
+            const Dimensions &origin)
+    {
+        ChunkKey chunk_key;
+        chunk_key.key = key;
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            chunk_key.origin[i] = origin[i];
+
+        return chunk_key;
+    }
+
+    const std::vector<uint8_t> *ChunkCache::find(const std::string &key,
+            const Dimensions &origin)
+    {
+        ChunkMap::iterator iter = lookup.find(makeKey(key, origin));
+        if (iter == lookup.end())
+            return NULL;
+
+        chunks.splice(chunks.begin(), chunks, iter->second);
+        return &(iter->second->second);
+    }
+
+    void ChunkCache::insert(const std::string &key, const Dimensions &origin,
+            std::vector<uint8_t> &data)
+    {
+        const ChunkKey chunk_key = makeKey(key, origin);
+
+        ChunkMap::iterator iter = lookup.find(chunk_key);
+        if (iter != lookup.end())
+        {
+            size -= iter->second->second.size();
+            chunks.erase(iter->second);
+            lookup.erase(iter);
+        }
+
+        if (data.size() > maxBytes)
+            return;
+
+        evict(maxBytes - data.size());
+
+        chunks.push_front(std::make_pair(chunk_key, std::vector<uint8_t>()));
+        chunks.front().second.swap(data);
+        lookup[chunk_key] = chunks.begin();
+        size += chunks.front().second.size();
+    }
+
+    void ChunkCache::evict(size_t maxBytes)
+    {
+        while (size > maxBytes)
+        {
+            size -= chunks.back().second.size();
+            lookup.erase(chunks.back().first);
+            chunks.pop_back();
+        }
+    }
+
+    void ChunkCache::clear()
+    {
+        chunks.clear();
+        lookup.clear();
+        size = 0;
+    }
+
+    size_t ChunkCache::getSize() const
+    {
+        return size;
+    }
+
+}
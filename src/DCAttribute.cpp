@@ -24,6 +24,8 @@
 #include "splash/core/DCAttribute.hpp"
 #include "splash/core/H5IdWrapper.hpp"
 #include <cassert>
+#include <cstring>
+#include <vector>
 
 namespace splash
 {
@@ -33,6 +35,52 @@ namespace splash
                 std::string("] ") + msg);
     }
 
+    typedef struct
+    {
+        const DCAttribute::BulkEntry *entries;
+        size_t count;
+        // entries found so far
+        std::vector<bool> found;
+        size_t numFound;
+        // read found attributes, otherwise only mark them
+        bool read;
+        const char *error;
+    } FindAttributesParam;
+
+    herr_t DCAttribute::findAttributesCallback(hid_t location, const char *name,
+            const H5A_info_t* /*info*/, void *op_data)
+    {
+        FindAttributesParam *param = (FindAttributesParam*) op_data;
+
+        for (size_t i = 0; i < param->count; ++i)
+        {
+            if (param->found[i] || strcmp(name, param->entries[i].name) != 0)
+                continue;
+
+            if (param->read)
+            {
+                H5AttributeId attr(H5Aopen(location, name, H5P_DEFAULT));
+                if (!attr)
+                {
+                    param->error = "Attribute could not be opened for reading";
+                    return -1;
+                }
+
+                if (H5Aread(attr, param->entries[i].type, param->entries[i].data) < 0)
+                {
+                    param->error = "Attribute could not be read";
+                    return -1;
+                }
+            }
+
+            param->found[i] = true;
+            param->numFound++;
+        }
+
+        // stop iterating when all entries have been found
+        return (param->numFound == param->count) ? 1 : 0;
+    }
+
     AttributeInfo DCAttribute::readAttributeInfo(const char* name, hid_t parent)
     throw (DCException)
     {
@@ -90,4 +138,81 @@ namespace splash
         writeAttribute(name, type, parent, 1u, dims, src);
     }
 
+    size_t DCAttribute::readAttributes(hid_t parent, const BulkEntry *entries,
+            size_t count, bool required)
+    throw (DCException)
+    {
+        if (count == 0)
+            return 0;
+
+        FindAttributesParam param;
+        param.entries = entries;
+        param.count = count;
+        param.found.assign(count, false);
+        param.numFound = 0;
+        param.read = true;
+        param.error = NULL;
+
+        if (H5Aiterate2(parent, H5_INDEX_NAME, H5_ITER_NATIVE, NULL,
+                findAttributesCallback, &param) < 0)
+        {
+            for (size_t i = 0; i < count; ++i)
+            {
+                if (!param.found[i])
+                    throw DCException(getExceptionString(entries[i].name,
+                            param.error ? param.error : "Attributes could not be iterated"));
+            }
+        }
+
+        for (size_t i = 0; i < count && required; ++i)
+        {
+            if (!param.found[i])
+                throw DCException(getExceptionString(entries[i].name,
+                        "Attribute could not be opened for reading"));
+        }
+
+        return param.numFound;
+    }
+
+    void DCAttribute::writeAttributes(hid_t parent, const BulkEntry *entries, size_t count)
+    throw (DCException)
+    {
+        if (count == 0)
+            return;
+
+        // find existing attributes in one pass instead of H5Aexists for each
+        FindAttributesParam param;
+        param.entries = entries;
+        param.count = count;
+        param.found.assign(count, false);
+        param.numFound = 0;
+        param.read = false;
+        param.error = NULL;
+
+        if (H5Aiterate2(parent, H5_INDEX_NAME, H5_ITER_NATIVE, NULL,
+                findAttributesCallback, &param) < 0)
+            throw DCException(getExceptionString(entries[0].name,
+                    "Attributes could not be iterated"));
+
+        H5DataspaceId dsp(H5Screate(H5S_SCALAR));
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            H5AttributeId attr;
+            if (param.found[i])
+                attr.reset(H5Aopen(parent, entries[i].name, H5P_DEFAULT));
+            else
+                attr.reset(H5Acreate(parent, entries[i].name, entries[i].type, dsp,
+                        H5P_DEFAULT, H5P_DEFAULT));
+
+            if (!attr)
+                throw DCException(getExceptionString(entries[i].name,
+                        "Attribute could not be opened or created"));
+
+            if (H5Awrite(attr, entries[i].type, entries[i].data) < 0)
+                throw DCException(getExceptionString(entries[i].name,
+                        "Attribute could not be written"));
+        }
+    }
+
 }
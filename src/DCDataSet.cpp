@@ -25,6 +25,8 @@
 #include <string>
 #include <sstream>
 #include <cassert>
+#include <cstring>
+#include <algorithm>
 
 #include "splash/sdc_defines.hpp"
 
@@ -418,6 +420,131 @@ namespace splash
         return size;
     }
 
+    bool DCDataSet::getChunkSize(Dimensions &chunkSize)
+    throw (DCException)
+    {
+        if (!opened)
+            throw DCException(getExceptionString("getChunkSize: dataset is not opened"));
+
+        hid_t plist = H5Dget_create_plist(dataset);
+        if (plist < 0)
+            throw DCException(getExceptionString("getChunkSize: failed to get creation property list"));
+
+        chunkSize.set(1, 1, 1);
+        const bool chunked = (H5Pget_layout(plist) == H5D_CHUNKED);
+        if (chunked)
+        {
+            H5Pget_chunk(plist, ndims, chunkSize.getPointer());
+            chunkSize.swapDims(ndims);
+        }
+
+        H5Pclose(plist);
+        return chunked;
+    }
+
+    bool DCDataSet::getRawExtents(std::vector<haddr_t> &addresses,
+            std::vector<Dimensions> &origins,
+            Dimensions &extentSize)
+    throw (DCException)
+    {
+        if (!opened)
+            throw DCException(getExceptionString("getRawExtents: dataset is not opened"));
+
+        addresses.clear();
+        origins.clear();
+
+        const Dimensions size = getSize();
+        if (size.getScalarSize() == 0)
+            return false;
+
+        // with other drivers, addresses do not map to offsets in one file,
+        // and with a user block, addresses are relative to its end
+        hid_t file = H5Iget_file_id(dataset);
+        hid_t fapl = H5Fget_access_plist(file);
+        hid_t fcpl = H5Fget_create_plist(file);
+        hsize_t userblock_size = 0;
+        const bool sec2 = (H5Pget_driver(fapl) == H5FD_SEC2);
+        const bool userblock = (H5Pget_userblock(fcpl, &userblock_size) < 0 ||
+                userblock_size != 0);
+        H5Pclose(fcpl);
+        H5Pclose(fapl);
+        H5Fclose(file);
+
+        if (!sec2 || userblock)
+            return false;
+
+        hid_t plist = H5Dget_create_plist(dataset);
+        if (plist < 0)
+            throw DCException(getExceptionString("getRawExtents: failed to get creation property list"));
+
+        const H5D_layout_t layout = H5Pget_layout(plist);
+        const int num_filters = H5Pget_nfilters(plist);
+        const int num_external = H5Pget_external_count(plist);
+
+        Dimensions chunk_size(1, 1, 1);
+        if (layout == H5D_CHUNKED)
+        {
+            H5Pget_chunk(plist, ndims, chunk_size.getPointer());
+            chunk_size.swapDims(ndims);
+        }
+
+        H5Pclose(plist);
+
+        // only unfiltered data stored in this file is copied raw
+        if (num_filters != 0 || num_external != 0)
+            return false;
+
+        if (layout == H5D_CONTIGUOUS)
+        {
+            haddr_t address = H5Dget_offset(dataset);
+            if (address == HADDR_UNDEF)
+                return false;
+
+            addresses.push_back(address);
+            origins.push_back(Dimensions(0, 0, 0));
+            extentSize = size;
+            return true;
+        }
+
+#if H5_VERSION_GE(1, 10, 5)
+        if (layout != H5D_CHUNKED)
+            return false;
+
+        // unallocated chunks contain fill values which only HDF5 provides
+        hsize_t expected_chunks = 1;
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            expected_chunks *= (size[i] + chunk_size[i] - 1) / chunk_size[i];
+
+        hsize_t num_chunks = 0;
+        if (H5Dget_num_chunks(dataset, dataspace, &num_chunks) < 0 ||
+                num_chunks != expected_chunks)
+            return false;
+
+        addresses.resize(num_chunks);
+        origins.resize(num_chunks, Dimensions(0, 0, 0));
+        for (hsize_t i = 0; i < num_chunks; ++i)
+        {
+            unsigned filter_mask = 0;
+            hsize_t storage_size = 0;
+            if (H5Dget_chunk_info(dataset, dataspace, i, origins[i].getPointer(),
+                    &filter_mask, &(addresses[i]), &storage_size) < 0 ||
+                    addresses[i] == HADDR_UNDEF)
+            {
+                addresses.clear();
+                origins.clear();
+                return false;
+            }
+
+            origins[i].swapDims(ndims);
+        }
+
+        extentSize = chunk_size;
+        return true;
+#else
+        return false;
+#endif
+    }
+
     std::string DCDataSet::getName()
     {
         return name;
@@ -442,6 +569,20 @@ namespace splash
             uint32_t& srcNDims,
             void* dst)
     throw (DCException)
+    {
+        read(dstBuffer, dstOffset, srcSize, srcOffset, Dimensions(1, 1, 1),
+                sizeRead, srcNDims, dst);
+    }
+
+    void DCDataSet::read(Dimensions dstBuffer,
+            Dimensions dstOffset,
+            Dimensions srcSize,
+            Dimensions srcOffset,
+            Dimensions srcStride,
+            Dimensions& sizeRead,
+            uint32_t& srcNDims,
+            void* dst)
+    throw (DCException)
     {
         log_msg(2, "DCDataSet::read (%s)", name.c_str());
 
@@ -463,19 +604,22 @@ namespace splash
                     " dstBuffer     = %s\n"
                     " dstOffset     = %s\n"
                     " srcSize       = %s\n"
-                    " srcOffset     = %s\n",
+                    " srcOffset     = %s\n"
+                    " srcStride     = %s\n",
                     (long long unsigned) ndims,
                     getLogicalSize().toString().c_str(),
                     getPhysicalSize().toString().c_str(),
                     dstBuffer.toString().c_str(),
                     dstOffset.toString().c_str(),
                     srcSize.toString().c_str(),
-                    srcOffset.toString().c_str());
+                    srcOffset.toString().c_str(),
+                    srcStride.toString().c_str());
 
             dstBuffer.swapDims(ndims);
             dstOffset.swapDims(ndims);
             srcSize.swapDims(ndims);
             srcOffset.swapDims(ndims);
+            srcStride.swapDims(ndims);
 
             hid_t dst_dataspace = H5Screate_simple(ndims, dstBuffer.getPointer(), NULL);
             if (dst_dataspace < 0)
@@ -493,8 +637,8 @@ namespace splash
             if (!dst || srcSize.getScalarSize() == 0) {
                 H5Sselect_none(dataspace);
             } else {
-                if (H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, srcOffset.getPointer(), NULL,
-                        srcSize.getPointer(), NULL) < 0 ||
+                if (H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, srcOffset.getPointer(),
+                        srcStride.getPointer(), srcSize.getPointer(), NULL) < 0 ||
                         H5Sselect_valid(dataspace) <= 0)
                     throw DCException(getExceptionString("read: Source dataspace hyperslab selection is not valid!"));
             }
@@ -589,19 +733,269 @@ namespace splash
         }
     }
 
+    void DCDataSet::write(const MultiSelection &select, const void* data)
+    throw (DCException)
+    {
+        log_msg(2, "DCDataSet::write (%s, %llu blocks)", name.c_str(),
+                (long long unsigned) select.blocks.size());
+
+        transferBlocks(select, true, const_cast<void*> (data));
+    }
+
+    void DCDataSet::read(const MultiSelection &select, void* dst)
+    throw (DCException)
+    {
+        log_msg(2, "DCDataSet::read (%s, %llu blocks)", name.c_str(),
+                (long long unsigned) select.blocks.size());
+
+        transferBlocks(select, false, dst);
+    }
+
+    void DCDataSet::transferBlocks(const MultiSelection &select, bool write, void *buf)
+    throw (DCException)
+    {
+        if (!opened)
+            throw DCException(getExceptionString("transferBlocks: Dataset has not been opened/created"));
+
+        log_msg(3,
+                "\n ndims         = %llu\n"
+                " logical_size  = %s\n"
+                " select        = %s\n",
+                (long long unsigned) ndims,
+                getLogicalSize().toString().c_str(),
+                select.toString().c_str());
+
+        if (getLogicalSize().getScalarSize() == 0)
+            return;
+
+        // empty blocks would be ignored by HDF5 anyway
+        std::vector<MultiSelection::Block> blocks;
+        for (std::vector<MultiSelection::Block>::const_iterator iter = select.blocks.begin();
+                iter != select.blocks.end(); ++iter)
+        {
+            if (iter->count.getScalarSize() > 0)
+                blocks.push_back(*iter);
+        }
+
+        // HDF5 traverses union selections in row-major order instead of
+        // the order of the blocks, so the blocks can only be mapped directly
+        // if they are ordered equally in buffer and dataset.
+        // Otherwise they are copied to a staging buffer which has the
+        // same layout as the bounding box of the blocks in the dataset.
+        std::vector<MultiSelection::Block> buffer_blocks(blocks);
+        Dimensions buffer_size(select.size);
+        uint8_t *stage = NULL;
+        const size_t type_size = getDataTypeSize();
+
+        if (buf && !isOrderPreserving(blocks))
+        {
+            Dimensions stage_start(blocks[0].datasetOffset);
+            Dimensions stage_end(blocks[0].datasetOffset + blocks[0].count);
+
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                for (uint32_t d = 0; d < DSP_DIM_MAX; ++d)
+                {
+                    stage_start[d] = std::min(stage_start[d], blocks[i].datasetOffset[d]);
+                    stage_end[d] = std::max(stage_end[d],
+                            blocks[i].datasetOffset[d] + blocks[i].count[d]);
+                }
+
+                for (size_t j = 0; j < i; ++j)
+                {
+                    bool overlap = true;
+                    for (uint32_t d = 0; d < ndims; ++d)
+                    {
+                        if (blocks[i].datasetOffset[d] >= blocks[j].datasetOffset[d] + blocks[j].count[d] ||
+                                blocks[j].datasetOffset[d] >= blocks[i].datasetOffset[d] + blocks[i].count[d])
+                            overlap = false;
+                    }
+
+                    if (overlap)
+                        throw DCException(getExceptionString("transferBlocks: Blocks overlap in dataset"));
+                }
+            }
+
+            buffer_size = stage_end - stage_start;
+            log_msg(3, "staging blocks in buffer of size %s", buffer_size.toString().c_str());
+
+            stage = new uint8_t[buffer_size.getScalarSize() * type_size];
+
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                const Dimensions stage_offset(blocks[i].datasetOffset - stage_start);
+
+                if (write)
+                    copyBlock(blocks[i], select.size, (uint8_t*) buf,
+                        buffer_size, stage_offset, stage, type_size, true);
+
+                buffer_blocks[i] = MultiSelection::Block(blocks[i].count, stage_offset,
+                        blocks[i].datasetOffset, Dimensions(1, 1, 1));
+            }
+        }
+
+        hid_t dsp_buffer = -1;
+        try
+        {
+            buffer_size.swapDims(ndims);
+            dsp_buffer = H5Screate_simple(ndims, buffer_size.getPointer(), NULL);
+            if (dsp_buffer < 0)
+                throw DCException(getExceptionString("transferBlocks: Failed to create buffer dataspace"));
+
+            if (!buf || blocks.empty())
+            {
+                H5Sselect_none(dsp_buffer);
+                H5Sselect_none(dataspace);
+            } else
+            {
+                selectBlocks(dsp_buffer, buffer_blocks, true);
+                selectBlocks(dataspace, blocks, false);
+            }
+
+            void *xfer_buf = stage ? stage : (blocks.empty() ? NULL : buf);
+
+            if (write)
+            {
+                if (H5Dwrite(dataset, this->datatype, dsp_buffer, dataspace,
+                        dsetWriteProperties, xfer_buf) < 0)
+                    throw DCException(getExceptionString("transferBlocks: Failed to write dataset"));
+            } else
+            {
+                if (H5Dread(dataset, this->datatype, dsp_buffer, dataspace,
+                        dsetReadProperties, xfer_buf) < 0)
+                    throw DCException(getExceptionString("transferBlocks: Failed to read dataset"));
+
+                if (stage)
+                {
+                    buffer_size.swapDims(ndims);
+                    for (size_t i = 0; i < blocks.size(); ++i)
+                        copyBlock(blocks[i], select.size, (uint8_t*) buf,
+                            buffer_size, buffer_blocks[i].bufferOffset, stage,
+                            type_size, false);
+                }
+            }
+        } catch (const DCException &e)
+        {
+            if (dsp_buffer >= 0)
+                H5Sclose(dsp_buffer);
+            delete[] stage;
+            throw e;
+        }
+
+        H5Sclose(dsp_buffer);
+        delete[] stage;
+    }
+
+    void DCDataSet::selectBlocks(hid_t space,
+            const std::vector<MultiSelection::Block> &blocks, bool bufferSide)
+    throw (DCException)
+    {
+        for (size_t i = 0; i < blocks.size(); ++i)
+        {
+            Dimensions count(blocks[i].count);
+            Dimensions offset(bufferSide ? blocks[i].bufferOffset : blocks[i].datasetOffset);
+            Dimensions stride(bufferSide ? blocks[i].bufferStride : Dimensions(1, 1, 1));
+
+            count.swapDims(ndims);
+            offset.swapDims(ndims);
+            stride.swapDims(ndims);
+
+            if (H5Sselect_hyperslab(space, (i == 0) ? H5S_SELECT_SET : H5S_SELECT_OR,
+                    offset.getPointer(), stride.getPointer(), count.getPointer(), NULL) < 0)
+                throw DCException(getExceptionString("selectBlocks: Failed to select hyperslab"));
+        }
+
+        if (H5Sselect_valid(space) <= 0)
+            throw DCException(getExceptionString("selectBlocks: Union hyperslab selection is not valid!"));
+    }
+
+    bool DCDataSet::isOrderPreserving(const std::vector<MultiSelection::Block> &blocks)
+    {
+        if (blocks.size() < 2)
+            return true;
+
+        // blocks must follow each other along the slowest varying
+        // dimension in both dataset and buffer
+        const uint32_t dim = ndims - 1;
+
+        std::vector<std::pair<hsize_t, size_t> > order;
+        for (size_t i = 0; i < blocks.size(); ++i)
+            order.push_back(std::make_pair(blocks[i].datasetOffset[dim], i));
+        std::sort(order.begin(), order.end());
+
+        for (size_t k = 1; k < order.size(); ++k)
+        {
+            const MultiSelection::Block &a = blocks[order[k - 1].second];
+            const MultiSelection::Block &b = blocks[order[k].second];
+
+            if (a.datasetOffset[dim] + a.count[dim] > b.datasetOffset[dim])
+                return false;
+
+            if (a.bufferOffset[dim] + (a.count[dim] - 1) * a.bufferStride[dim] >=
+                    b.bufferOffset[dim])
+                return false;
+        }
+
+        return true;
+    }
+
+    void DCDataSet::copyBlock(const MultiSelection::Block &block,
+            const Dimensions bufferSize, uint8_t *buffer,
+            const Dimensions stageSize, const Dimensions stageOffset,
+            uint8_t *stage, size_t typeSize, bool toStage)
+    {
+        const Dimensions &count = block.count;
+        const Dimensions &offset = block.bufferOffset;
+        const Dimensions &stride = block.bufferStride;
+        const size_t row_bytes = (stride[0] == 1) ? count[0] * typeSize : typeSize;
+        const size_t row_elements = (stride[0] == 1) ? count[0] : 1;
+
+        for (size_t z = 0; z < count[2]; ++z)
+            for (size_t y = 0; y < count[1]; ++y)
+                for (size_t x = 0; x < count[0]; x += row_elements)
+                {
+                    const size_t buffer_index =
+                            ((offset[2] + z * stride[2]) * bufferSize[1] +
+                            offset[1] + y * stride[1]) * bufferSize[0] +
+                            offset[0] + x * stride[0];
+                    const size_t stage_index =
+                            ((stageOffset[2] + z) * stageSize[1] +
+                            stageOffset[1] + y) * stageSize[0] +
+                            stageOffset[0] + x;
+
+                    if (toStage)
+                        memcpy(stage + stage_index * typeSize,
+                            buffer + buffer_index * typeSize, row_bytes);
+                    else
+                        memcpy(buffer + buffer_index * typeSize,
+                            stage + stage_index * typeSize, row_bytes);
+                }
+    }
+
     void DCDataSet::append(size_t count, size_t offset, size_t stride, const void* data)
     throw (DCException)
+    {
+        append(count, offset, stride, count, 0, data);
+    }
+
+    void DCDataSet::append(size_t count, size_t offset, size_t stride,
+            size_t totalCount, size_t totalOffset, const void* data)
+    throw (DCException)
     {
         log_msg(2, "DCDataSet::append");
 
         if (!opened)
             throw DCException(getExceptionString("append: Dataset has not been opened/created."));
 
+        if (totalOffset + count > totalCount)
+            throw DCException(getExceptionString("append: Write exceeds extended region"));
+
         log_msg(3, "logical_size = %s", getLogicalSize().toString().c_str());
 
         Dimensions target_offset(getLogicalSize());
-        // extend size (dataspace) of existing dataset with count elements
-        getLogicalSize()[0] += count;
+        target_offset[0] += totalOffset;
+        // extend size (dataspace) of existing dataset with totalCount elements
+        getLogicalSize()[0] += totalCount;
 
         hsize_t * max_dims = new hsize_t[ndims];
         for (size_t i = 0; i < ndims; ++i)
@@ -618,29 +1012,35 @@ namespace splash
         if (H5Dset_extent(dataset, getLogicalSize().getPointer()) < 0)
             throw DCException(getExceptionString("append: Failed to extend dataset"));
 
-        // select the region in the target DataSpace to write to
-        Dimensions dim_data(count, 1, 1);
-        if (H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, target_offset.getPointer(),
-                NULL, dim_data.getPointer(), NULL) < 0 ||
-                H5Sselect_valid(dataspace) < 0)
-            throw DCException(getExceptionString("append: Invalid target hyperslap selection"));
-
         // append data to the dataset.
         // select the region in the source DataSpace to read from
+        Dimensions dim_data(count, 1, 1);
         Dimensions dim_src(offset + count * stride, 1, 1);
+        if (count == 0)
+            dim_src.set(1, 1, 1);
+
         hid_t dsp_src = H5Screate_simple(1, dim_src.getPointer(), NULL);
         if (dsp_src < 0)
             throw DCException(getExceptionString("append: Failed to create src dataspace while appending"));
 
-        if (H5Sselect_hyperslab(dsp_src, H5S_SELECT_SET, Dimensions(offset, 0, 0).getPointer(),
-                Dimensions(stride, 1, 1).getPointer(), dim_data.getPointer(), NULL) < 0 ||
-                H5Sselect_valid(dsp_src) < 0)
-            throw DCException(getExceptionString("append: Invalid source hyperslap selection"));
-
         if (!data || (count == 0))
         {
+            // writers without data still take part in (collective) transfers
             H5Sselect_none(dataspace);
+            H5Sselect_none(dsp_src);
             data = NULL;
+        } else
+        {
+            // select the region in the target DataSpace to write to
+            if (H5Sselect_hyperslab(dataspace, H5S_SELECT_SET, target_offset.getPointer(),
+                    NULL, dim_data.getPointer(), NULL) < 0 ||
+                    H5Sselect_valid(dataspace) < 0)
+                throw DCException(getExceptionString("append: Invalid target hyperslap selection"));
+
+            if (H5Sselect_hyperslab(dsp_src, H5S_SELECT_SET, Dimensions(offset, 0, 0).getPointer(),
+                    Dimensions(stride, 1, 1).getPointer(), dim_data.getPointer(), NULL) < 0 ||
+                    H5Sselect_valid(dsp_src) < 0)
+                throw DCException(getExceptionString("append: Invalid source hyperslap selection"));
         }
 
         if (H5Dwrite(dataset, this->datatype, dsp_src, dataspace, dsetWriteProperties, data) < 0)
@@ -142,6 +142,17 @@ namespace splash
 
     bool DCGroup::exists(H5Handle base, std::string path)
     {
+        // H5Lexists fails for nested paths with missing intermediate groups,
+        // so every prefix of the path is checked
+        size_t pos = path.find('/', 1);
+        while (pos != std::string::npos)
+        {
+            if (H5Lexists(base, path.substr(0, pos).c_str(), H5P_DEFAULT) != H5_TRUE)
+                return false;
+
+            pos = path.find('/', pos + 1);
+        }
+
         return (H5Lexists(base, path.c_str(), H5P_DEFAULT) == H5_TRUE);
     }
 
@@ -209,7 +220,7 @@ namespace splash
                     hid_t dataset_id = H5Oopen_by_idx(base, ".", H5_INDEX_NAME, H5_ITER_INC, i, H5P_DEFAULT);
                     hid_t datatype_id = H5Dget_type(dataset_id);
                     param->entries[param->count].colType = generateCollectionType(datatype_id);
-                    H5Dclose(datatype_id);
+                    H5Tclose(datatype_id);
                     H5Oclose(dataset_id);
                 }
 
@@ -0,0 +1,444 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+
+#include "splash/core/DCStatistics.hpp"
+#include "splash/core/DCAttribute.hpp"
+#include "splash/core/H5IdWrapper.hpp"
+#include "splash/core/logging.hpp"
+#include "splash/basetypes/ColTypeDim.hpp"
+#include "splash/sdc_defines.hpp"
+
+namespace splash
+{
+
+    template<typename T>
+    static bool isNumber(T value)
+    {
+        // false for NaN only
+        return value == value;
+    }
+
+    template<typename T>
+    static void accumulateBlocks(const T *data, const Selection &select,
+            const Dimensions datasetOffset, const Dimensions blockSize,
+            const Dimensions firstBlock, const Dimensions numBlocks,
+            T *minMax, std::vector<bool> &valid)
+    {
+        for (size_t z = 0; z < select.count[2]; ++z)
+            for (size_t y = 0; y < select.count[1]; ++y)
+            {
+                const size_t src_row = ((select.offset[2] + z * select.stride[2]) *
+                        select.size[1] + select.offset[1] + y * select.stride[1]) *
+                        select.size[0] + select.offset[0];
+                const size_t block_row =
+                        ((datasetOffset[2] + z) / blockSize[2] - firstBlock[2]) * numBlocks[1] +
+                        (datasetOffset[1] + y) / blockSize[1] - firstBlock[1];
+
+                for (size_t x = 0; x < select.count[0]; ++x)
+                {
+                    const T value = data[src_row + x * select.stride[0]];
+                    if (!isNumber(value))
+                        continue;
+
+                    const size_t block = block_row * numBlocks[0] +
+                            (datasetOffset[0] + x) / blockSize[0] - firstBlock[0];
+                    T *block_min_max = minMax + 2 * block;
+
+                    if (!valid[block] || !isNumber(block_min_max[0]))
+                    {
+                        block_min_max[0] = value;
+                        block_min_max[1] = value;
+                        valid[block] = true;
+                    } else
+                    {
+                        if (value < block_min_max[0])
+                            block_min_max[0] = value;
+                        if (value > block_min_max[1])
+                            block_min_max[1] = value;
+                    }
+                }
+            }
+
+        // only NaN (integer blocks are never empty)
+        for (size_t i = 0; i < valid.size(); ++i)
+            if (!valid[i])
+            {
+                minMax[2 * i] = std::numeric_limits<T>::quiet_NaN();
+                minMax[2 * i + 1] = std::numeric_limits<T>::quiet_NaN();
+            }
+    }
+
+    template<typename T>
+    static void selectBlocks(const T *minMax, double minValue, double maxValue,
+            std::vector<bool> &candidates)
+    {
+        for (size_t i = 0; i < candidates.size(); ++i)
+            candidates[i] = ((double) minMax[2 * i] <= maxValue) &&
+                ((double) minMax[2 * i + 1] >= minValue);
+    }
+
+    template<typename T>
+    static void filterValues(const T *buffer, const Dimensions bufferSize,
+            const Dimensions bufferOffset, const Dimensions datasetSize,
+            double minValue, double maxValue, std::vector<uint64_t> &indices)
+    {
+        for (size_t z = 0; z < bufferSize[2]; ++z)
+            for (size_t y = 0; y < bufferSize[1]; ++y)
+            {
+                const T *row = buffer + (z * bufferSize[1] + y) * bufferSize[0];
+                const uint64_t dataset_row = ((bufferOffset[2] + z) * datasetSize[1] +
+                        bufferOffset[1] + y) * datasetSize[0] + bufferOffset[0];
+
+                for (size_t x = 0; x < bufferSize[0]; ++x)
+                {
+                    const double value = (double) row[x];
+                    if (value >= minValue && value <= maxValue)
+                        indices.push_back(dataset_row + x);
+                }
+            }
+    }
+
+    static void computeBlocks(DCDataType type, const void *data,
+            const Selection &select, const Dimensions datasetOffset,
+            const Dimensions blockSize, const Dimensions firstBlock,
+            const Dimensions numBlocks, void *minMax, std::vector<bool> &valid)
+    {
+        switch (type)
+        {
+            case DCDT_FLOAT32:
+                accumulateBlocks((const float*) data, select, datasetOffset,
+                        blockSize, firstBlock, numBlocks, (float*) minMax, valid);
+                break;
+            case DCDT_FLOAT64:
+                accumulateBlocks((const double*) data, select, datasetOffset,
+                        blockSize, firstBlock, numBlocks, (double*) minMax, valid);
+                break;
+            case DCDT_INT32:
+                accumulateBlocks((const int32_t*) data, select, datasetOffset,
+                        blockSize, firstBlock, numBlocks, (int32_t*) minMax, valid);
+                break;
+            case DCDT_INT64:
+                accumulateBlocks((const int64_t*) data, select, datasetOffset,
+                        blockSize, firstBlock, numBlocks, (int64_t*) minMax, valid);
+                break;
+            case DCDT_UINT32:
+                accumulateBlocks((const uint32_t*) data, select, datasetOffset,
+                        blockSize, firstBlock, numBlocks, (uint32_t*) minMax, valid);
+                break;
+            case DCDT_UINT64:
+                accumulateBlocks((const uint64_t*) data, select, datasetOffset,
+                        blockSize, firstBlock, numBlocks, (uint64_t*) minMax, valid);
+                break;
+            default:
+                break;
+        }
+    }
+
+    DCDataType DCStatistics::getDataType(hid_t datatype)
+    {
+        const H5T_class_t type_class = H5Tget_class(datatype);
+        const size_t type_size = H5Tget_size(datatype);
+
+        if (type_class == H5T_FLOAT)
+        {
+            if (type_size == sizeof (float))
+                return DCDT_FLOAT32;
+            if (type_size == sizeof (double))
+                return DCDT_FLOAT64;
+        }
+
+        if (type_class == H5T_INTEGER)
+        {
+            const bool is_signed = (H5Tget_sign(datatype) != H5T_SGN_NONE);
+            if (type_size == sizeof (int32_t))
+                return is_signed ? DCDT_INT32 : DCDT_UINT32;
+            if (type_size == sizeof (int64_t))
+                return is_signed ? DCDT_INT64 : DCDT_UINT64;
+        }
+
+        return DCDT_UNKNOWN;
+    }
+
+    Dimensions DCStatistics::getNumBlocks(const Dimensions datasetSize,
+            const Dimensions blockSize)
+    {
+        Dimensions num_blocks(0, 0, 0);
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            num_blocks[i] = (datasetSize[i] + blockSize[i] - 1) / blockSize[i];
+
+        return num_blocks;
+    }
+
+    void DCStatistics::write(hid_t group, const std::string &name,
+            const CollectionType &colType, const Dimensions blockSize,
+            const Selection &select, const void *data)
+    throw (DCException)
+    {
+        const DCDataType type = getDataType(colType.getDataType());
+        if (type == DCDT_UNKNOWN)
+            throw DCException("DCStatistics::write: unsupported datatype");
+
+        const Dimensions num_blocks = getNumBlocks(select.count, blockSize);
+        const size_t stats_elements = 2 * num_blocks.getScalarSize();
+
+        std::vector<uint8_t> min_max(stats_elements * colType.getSize());
+        std::vector<bool> valid(num_blocks.getScalarSize(), false);
+
+        DCDataSet dataset(name);
+        dataset.create(colType, group, Dimensions(stats_elements, 1, 1), 1,
+                false, false);
+
+        if (stats_elements > 0)
+        {
+            computeBlocks(type, data, select, Dimensions(0, 0, 0), blockSize,
+                    Dimensions(0, 0, 0), num_blocks, &(min_max[0]), valid);
+            dataset.write(Selection(Dimensions(stats_elements, 1, 1)),
+                    Dimensions(0, 0, 0), &(min_max[0]));
+        }
+
+        dataset.close();
+
+        writeAttributes(group, name, blockSize, select.count);
+    }
+
+    bool DCStatistics::append(hid_t group, const std::string &name,
+            const CollectionType &colType, size_t blockElements,
+            uint64_t oldSize, size_t count, size_t offset, size_t stride,
+            const void *data)
+    throw (DCException)
+    {
+        const DCDataType type = getDataType(colType.getDataType());
+        if (type == DCDT_UNKNOWN)
+            throw DCException("DCStatistics::append: unsupported datatype");
+
+        Dimensions block_size(blockElements, 1, 1);
+        if (oldSize > 0)
+        {
+            // existing statistics must describe exactly the existing data
+            Dimensions data_size;
+            if (!readAttributes(group, name, block_size, data_size) ||
+                    data_size != Dimensions(oldSize, 1, 1))
+                return false;
+        }
+
+        DCDataSet dataset(name);
+        if (count == 0)
+        {
+            if (oldSize == 0)
+            {
+                dataset.create(colType, group, Dimensions(0, 1, 1), 1, false, true);
+                dataset.close();
+                writeAttributes(group, name, block_size, Dimensions(0, 1, 1));
+            }
+            return true;
+        }
+
+        // blocks touched by the new elements, the first may be incomplete
+        const uint64_t first_block = oldSize / block_size[0];
+        const uint64_t num_blocks = (oldSize + count - 1) / block_size[0] - first_block + 1;
+        const bool partial = (oldSize % block_size[0]) != 0;
+        const size_t type_size = colType.getSize();
+
+        std::vector<uint8_t> min_max(2 * num_blocks * type_size);
+        std::vector<bool> valid(num_blocks, false);
+
+        Dimensions size_read;
+        uint32_t src_ndims = 0;
+        if (oldSize > 0)
+        {
+            if (!dataset.open(group))
+                return false;
+
+            if (partial)
+            {
+                dataset.read(Dimensions(2, 1, 1), Dimensions(0, 0, 0),
+                        Dimensions(2, 1, 1), Dimensions(2 * first_block, 0, 0),
+                        size_read, src_ndims, &(min_max[0]));
+                valid[0] = true;
+            }
+        }
+
+        computeBlocks(type, data,
+                Selection(Dimensions(offset + count * stride, 1, 1),
+                Dimensions(count, 1, 1), Dimensions(offset, 0, 0),
+                Dimensions(stride, 1, 1)),
+                Dimensions(oldSize, 0, 0), block_size,
+                Dimensions(first_block, 0, 0), Dimensions(num_blocks, 1, 1),
+                &(min_max[0]), valid);
+
+        if (oldSize == 0)
+        {
+            dataset.create(colType, group, Dimensions(2 * num_blocks, 1, 1), 1,
+                    false, true);
+            dataset.write(Selection(Dimensions(2 * num_blocks, 1, 1)),
+                    Dimensions(0, 0, 0), &(min_max[0]));
+        } else
+        {
+            if (partial)
+                dataset.write(Selection(Dimensions(2, 1, 1)),
+                    Dimensions(2 * first_block, 0, 0), &(min_max[0]));
+
+            const size_t first_new = partial ? 1 : 0;
+            if (num_blocks > first_new)
+                dataset.append(2 * (num_blocks - first_new), 2 * first_new, 1,
+                    &(min_max[0]));
+        }
+
+        dataset.close();
+
+        writeAttributes(group, name, block_size, Dimensions(oldSize + count, 1, 1));
+        return true;
+    }
+
+    bool DCStatistics::getCandidates(hid_t group, const std::string &name,
+            const Dimensions datasetSize, double minValue, double maxValue,
+            Dimensions &blockSize, std::vector<bool> &candidates)
+    throw (DCException)
+    {
+        Dimensions data_size;
+        if (!readAttributes(group, name, blockSize, data_size) ||
+                data_size != datasetSize)
+        {
+            log_msg(3, "DCStatistics: no statistics for %s", name.c_str());
+            return false;
+        }
+
+        DCDataSet dataset(name);
+        if (!dataset.open(group))
+            return false;
+
+        const size_t num_blocks = getNumBlocks(datasetSize, blockSize).getScalarSize();
+        const DCDataType type = dataset.getDCDataType();
+        if (dataset.getSize()[0] != 2 * num_blocks || num_blocks == 0)
+        {
+            dataset.close();
+            return false;
+        }
+
+        std::vector<uint8_t> min_max(2 * num_blocks * dataset.getDataTypeSize());
+        Dimensions size_read;
+        uint32_t src_ndims = 0;
+        dataset.read(Dimensions(2 * num_blocks, 1, 1), Dimensions(0, 0, 0),
+                size_read, src_ndims, &(min_max[0]));
+        dataset.close();
+
+        candidates.assign(num_blocks, false);
+        switch (type)
+        {
+            case DCDT_FLOAT32:
+                selectBlocks((const float*) &(min_max[0]), minValue, maxValue, candidates);
+                break;
+            case DCDT_FLOAT64:
+                selectBlocks((const double*) &(min_max[0]), minValue, maxValue, candidates);
+                break;
+            case DCDT_INT32:
+                selectBlocks((const int32_t*) &(min_max[0]), minValue, maxValue, candidates);
+                break;
+            case DCDT_INT64:
+                selectBlocks((const int64_t*) &(min_max[0]), minValue, maxValue, candidates);
+                break;
+            case DCDT_UINT32:
+                selectBlocks((const uint32_t*) &(min_max[0]), minValue, maxValue, candidates);
+                break;
+            case DCDT_UINT64:
+                selectBlocks((const uint64_t*) &(min_max[0]), minValue, maxValue, candidates);
+                break;
+            default:
+                return false;
+        }
+
+        return true;
+    }
+
+    void DCStatistics::filter(DCDataType type, const void *buffer,
+            const Dimensions bufferSize, const Dimensions bufferOffset,
+            const Dimensions datasetSize, double minValue, double maxValue,
+            std::vector<uint64_t> &indices)
+    {
+        switch (type)
+        {
+            case DCDT_FLOAT32:
+                filterValues((const float*) buffer, bufferSize, bufferOffset,
+                        datasetSize, minValue, maxValue, indices);
+                break;
+            case DCDT_FLOAT64:
+                filterValues((const double*) buffer, bufferSize, bufferOffset,
+                        datasetSize, minValue, maxValue, indices);
+                break;
+            case DCDT_INT32:
+                filterValues((const int32_t*) buffer, bufferSize, bufferOffset,
+                        datasetSize, minValue, maxValue, indices);
+                break;
+            case DCDT_INT64:
+                filterValues((const int64_t*) buffer, bufferSize, bufferOffset,
+                        datasetSize, minValue, maxValue, indices);
+                break;
+            case DCDT_UINT32:
+                filterValues((const uint32_t*) buffer, bufferSize, bufferOffset,
+                        datasetSize, minValue, maxValue, indices);
+                break;
+            case DCDT_UINT64:
+                filterValues((const uint64_t*) buffer, bufferSize, bufferOffset,
+                        datasetSize, minValue, maxValue, indices);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void DCStatistics::writeAttributes(hid_t group, const std::string &name,
+            const Dimensions blockSize, const Dimensions datasetSize)
+    throw (DCException)
+    {
+        H5ObjectId dataset(H5Oopen(group, name.c_str(), H5P_DEFAULT));
+        if (!dataset)
+            throw DCException("DCStatistics::writeAttributes: failed to open statistics");
+
+        ColTypeDim dim_t;
+        DCAttribute::writeAttribute(SDC_ATTR_BLOCK_SIZE, dim_t.getDataType(),
+                dataset, blockSize.getPointer());
+        DCAttribute::writeAttribute(SDC_ATTR_DATA_SIZE, dim_t.getDataType(),
+                dataset, datasetSize.getPointer());
+    }
+
+    bool DCStatistics::readAttributes(hid_t group, const std::string &name,
+            Dimensions &blockSize, Dimensions &datasetSize)
+    throw (DCException)
+    {
+        if (H5Lexists(group, name.c_str(), H5P_DEFAULT) <= 0)
+            return false;
+
+        H5ObjectId dataset(H5Oopen(group, name.c_str(), H5P_DEFAULT));
+        if (!dataset ||
+                H5Aexists(dataset, SDC_ATTR_BLOCK_SIZE) <= 0 ||
+                H5Aexists(dataset, SDC_ATTR_DATA_SIZE) <= 0)
+            return false;
+
+        DCAttribute::readAttribute(SDC_ATTR_BLOCK_SIZE, dataset, blockSize.getPointer());
+        DCAttribute::readAttribute(SDC_ATTR_DATA_SIZE, dataset, datasetSize.getPointer());
+
+        return blockSize.getScalarSize() > 0;
+    }
+
+}
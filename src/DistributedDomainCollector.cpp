@@ -0,0 +1,623 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <limits>
+#include <sstream>
+
+#include "splash/DistributedDomainCollector.hpp"
+#include "splash/core/DCDataSet.hpp"
+#include "splash/core/DCGroup.hpp"
+#include "splash/core/logging.hpp"
+
+namespace splash
+{
+
+    // messages between two processes are matched in the order
+    // of posting, so all data of a read can use the same tag
+    static const int TAG_DOMAIN_DATA = 1;
+
+    /**
+     * Creates the type of a box within a 3D buffer (x varying fastest).
+     *
+     * @return false if the sizes exceed the range of MPI
+     */
+    static bool createSubarrayType(const Dimensions &bufferSize,
+            const Dimensions &boxSize, const Dimensions &boxOffset,
+            MPI_Datatype elementType, MPI_Datatype *type)
+    {
+        int sizes[DSP_DIM_MAX], sub_sizes[DSP_DIM_MAX], starts[DSP_DIM_MAX];
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+        {
+            if (bufferSize[i] > (uint64_t) std::numeric_limits<int>::max())
+                return false;
+
+            sizes[DSP_DIM_MAX - 1 - i] = bufferSize[i];
+            sub_sizes[DSP_DIM_MAX - 1 - i] = boxSize[i];
+            starts[DSP_DIM_MAX - 1 - i] = boxOffset[i];
+        }
+
+        if (MPI_Type_create_subarray(DSP_DIM_MAX, sizes, sub_sizes, starts,
+                MPI_ORDER_C, elementType, type) != MPI_SUCCESS)
+            return false;
+
+        return (MPI_Type_commit(type) == MPI_SUCCESS);
+    }
+
+    /**
+     * Point-to-point message of readDomainCollective.
+     */
+    typedef struct
+    {
+        void *buffer;
+        int count;
+        MPI_Datatype type;
+        int peer;
+        // subarray types are freed after the transfer
+        bool ownsType;
+    } Transfer;
+
+    std::string DistributedDomainCollector::getExceptionString(std::string func,
+            std::string msg, const char *info)
+    {
+        std::stringstream full_msg;
+        full_msg << "Exception for DistributedDomainCollector::" << func <<
+                ": " << msg;
+
+        if (info != NULL)
+            full_msg << " (" << info << ")";
+
+        return full_msg.str();
+    }
+
+    DistributedDomainCollector::DistributedDomainCollector(MPI_Comm comm,
+            uint32_t maxFileHandles) :
+    DomainCollector(maxFileHandles),
+    comm(MPI_COMM_NULL),
+    mpiRank(0),
+    mpiSize(1)
+    {
+        if (MPI_Comm_dup(comm, &(this->comm)) != MPI_SUCCESS)
+            throw DCException(getExceptionString("DistributedDomainCollector",
+                "failed to duplicate MPI communicator", NULL));
+
+        MPI_Comm_rank(this->comm, &mpiRank);
+        MPI_Comm_size(this->comm, &mpiSize);
+    }
+
+    DistributedDomainCollector::~DistributedDomainCollector()
+    {
+        int finalized = 0;
+        MPI_Finalized(&finalized);
+
+        if ((comm != MPI_COMM_NULL) && !finalized)
+        {
+            MPI_Comm_free(&comm);
+            comm = MPI_COMM_NULL;
+        }
+    }
+
+    void DistributedDomainCollector::checkStatus(std::string func, bool failed)
+    throw (DCException)
+    {
+        int local_failed = failed ? 1 : 0;
+        int global_failed = 0;
+
+        if (MPI_Allreduce(&local_failed, &global_failed, 1, MPI_INT, MPI_MAX,
+                comm) != MPI_SUCCESS)
+            throw DCException(getExceptionString(func, "MPI_Allreduce failed", NULL));
+
+        if (global_failed != 0)
+            throw DCException(getExceptionString(func,
+                "failed to read data on at least one process", NULL));
+    }
+
+    DomainCollector::DomainIndexEntry &DistributedDomainCollector::getDomainIndexCollective(
+            int32_t id, const char* name)
+    throw (DCException)
+    {
+        DomainIndexEntry *cached = findDomainIndex(id, name);
+        if (cached != NULL)
+            return *cached;
+
+        std::vector<DomainTableEntry> table;
+        if (readMergedDomainTable(id, name, table))
+        {
+            DomainIndexEntry &entry = addDomainIndex(id, name, table);
+
+            log_msg(2, "built domain index for %d/%s from domain table with %llu files",
+                    id, name, (long long unsigned) entry.index.getSize());
+
+            return entry;
+        }
+
+        Dimensions mpi_size(1, 1, 1);
+        if (fileStatus == FST_MERGING)
+            mpi_size.set(mpiTopology);
+
+        // files are read round-robin, process r reads files r, r + mpiSize, ...
+        const size_t num_files = mpi_size.getScalarSize();
+        const size_t rows_per_rank = (num_files + mpiSize - 1) / mpiSize;
+        const size_t row_size = DomainTableEntry::NUM_COLUMNS;
+
+        // status of this process followed by its rows
+        std::vector<uint64_t> local_rows(1 + rows_per_rank * row_size, 0);
+        try
+        {
+            for (size_t i = 0; i < rows_per_rank; ++i)
+            {
+                const size_t file = mpiRank + i * mpiSize;
+                if (file >= num_files)
+                    break;
+
+                const Dimensions mpi_position(file % mpi_size[0],
+                        (file / mpi_size[0]) % mpi_size[1],
+                        file / (mpi_size[0] * mpi_size[1]));
+
+                DomainTableEntry file_entry;
+                readFileDomain(mpi_position, id, name, file_entry);
+                file_entry.toRow(&(local_rows[1 + i * row_size]));
+            }
+
+            local_rows[0] = 1;
+        } catch (const DCException &e)
+        {
+            log_msg(0, "readDomainCollective: %s", e.what());
+        }
+
+        std::vector<uint64_t> rows(local_rows.size() * mpiSize);
+        if (MPI_Allgather(&(local_rows[0]), local_rows.size(), MPI_UNSIGNED_LONG_LONG,
+                &(rows[0]), local_rows.size(), MPI_UNSIGNED_LONG_LONG,
+                comm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("readDomainCollective",
+                "MPI_Allgather failed", NULL));
+
+        table.resize(num_files);
+        for (int r = 0; r < mpiSize; ++r)
+        {
+            const uint64_t *rank_rows = &(rows[r * local_rows.size()]);
+            if (rank_rows[0] == 0)
+                throw DCException(getExceptionString("readDomainCollective",
+                    "failed to read domain information on at least one process", name));
+
+            for (size_t i = 0; i < rows_per_rank; ++i)
+            {
+                const size_t file = r + i * mpiSize;
+                if (file < num_files)
+                    table[file].fromRow(rank_rows + 1 + i * row_size);
+            }
+        }
+
+        DomainIndexEntry &entry = addDomainIndex(id, name, table);
+
+        log_msg(2, "built domain index for %d/%s with %llu files on %d processes",
+                id, name, (long long unsigned) entry.index.getSize(), mpiSize);
+
+        return entry;
+    }
+
+    DataContainer *DistributedDomainCollector::readDomainCollective(int32_t id,
+            const char* name,
+            const Domain requestDomain,
+            DomDataClass* dataClass)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("readDomainCollective",
+                "parameter name is NULL", NULL));
+
+        if ((fileStatus != FST_MERGING) && (fileStatus != FST_READING))
+            throw DCException(getExceptionString("readDomainCollective",
+                "this access is not permitted", NULL));
+
+        DomainIndexEntry &entry = getDomainIndexCollective(id, name);
+
+        // requests of all processes
+        std::vector<uint64_t> plan(2 * DSP_DIM_MAX * mpiSize);
+        uint64_t local_request[2 * DSP_DIM_MAX];
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+        {
+            local_request[i] = requestDomain.getOffset()[i];
+            local_request[DSP_DIM_MAX + i] = requestDomain.getSize()[i];
+        }
+
+        if (MPI_Allgather(local_request, 2 * DSP_DIM_MAX, MPI_UNSIGNED_LONG_LONG,
+                &(plan[0]), 2 * DSP_DIM_MAX, MPI_UNSIGNED_LONG_LONG,
+                comm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("readDomainCollective",
+                "MPI_Allgather failed", NULL));
+
+        // files required by every process (in the order of readDomain)
+        // and the processes requiring every file
+        const size_t num_files = entry.mpiPositions.size();
+        std::vector<Domain> requests(mpiSize);
+        std::vector<std::vector<size_t> > rank_files(mpiSize);
+        std::vector<std::vector<int> > file_ranks(num_files);
+
+        for (int r = 0; r < mpiSize; ++r)
+        {
+            const uint64_t *request = &(plan[r * 2 * DSP_DIM_MAX]);
+            requests[r] = Domain(
+                    Dimensions(request[0], request[1], request[2]),
+                    Dimensions(request[3], request[4], request[5]));
+
+            // zero request sizes will not intersect with anything
+            if (requests[r].getSize().getScalarSize() == 0)
+                continue;
+
+            std::vector<size_t> files;
+            entry.index.query(requests[r], files);
+            sortByDomainOffset(files, entry.clientDomains);
+
+            for (std::vector<size_t>::const_iterator iter = files.begin();
+                    iter != files.end(); ++iter)
+            {
+                // Poly files without elements are skipped by readDomain
+                if ((entry.dataClass == PolyType) &&
+                        (entry.dataSizes[*iter].getScalarSize() == 0))
+                    continue;
+
+                rank_files[r].push_back(*iter);
+                file_ranks[*iter].push_back(r);
+            }
+        }
+
+        // every required file is read by a single process (round-robin)
+        std::vector<size_t> read_files;
+        std::vector<int> file_owners(num_files, -1);
+        for (size_t f = 0; f < num_files; ++f)
+        {
+            if (!file_ranks[f].empty())
+            {
+                file_owners[f] = read_files.size() % mpiSize;
+                read_files.push_back(f);
+            }
+        }
+
+        DataContainer *data_container = new DataContainer();
+        if (read_files.empty())
+        {
+            log_msg(2, "readDomainCollective: no data found");
+            return data_container;
+        }
+
+        // process 0 reads the first file and broadcasts the datatype
+        // (status, datatype size, DCDataType, ndims)
+        uint64_t meta[4] = {0, 0, 0, 0};
+        if (mpiRank == 0)
+        {
+            try
+            {
+                std::string group_path, dset_name;
+                DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+                DCGroup group;
+                group.open(handles.get(entry.mpiPositions[read_files[0]]), group_path);
+
+                DCDataSet dataset(dset_name);
+                dataset.open(group.getHandle());
+                meta[1] = dataset.getDataTypeSize();
+                meta[2] = dataset.getDCDataType();
+                meta[3] = dataset.getNDims();
+                dataset.close();
+
+                meta[0] = 1;
+            } catch (const DCException &e)
+            {
+                log_msg(0, "readDomainCollective: %s", e.what());
+            }
+        }
+
+        if (MPI_Bcast(meta, 4, MPI_UNSIGNED_LONG_LONG, 0, comm) != MPI_SUCCESS)
+        {
+            delete data_container;
+            throw DCException(getExceptionString("readDomainCollective",
+                "MPI_Bcast failed", NULL));
+        }
+
+        if (meta[0] == 0)
+        {
+            delete data_container;
+            throw DCException(getExceptionString("readDomainCollective",
+                "failed to read datatype on rank 0", name));
+        }
+
+        const size_t datatype_size = meta[1];
+        const DCDataType dc_datatype = (DCDataType) meta[2];
+        const uint32_t ndims = meta[3];
+
+        // Read the files of this process. For Grid data, the bounding box
+        // of the intersections with all requests is read once.
+        std::vector<std::vector<uint8_t> > buffers(num_files);
+        std::vector<Domain> boxes(num_files);
+        bool failed = false;
+        size_t num_read = 0;
+
+        try
+        {
+            for (std::vector<size_t>::const_iterator iter = read_files.begin();
+                    iter != read_files.end(); ++iter)
+            {
+                const size_t f = *iter;
+                if (file_owners[f] != mpiRank)
+                    continue;
+
+                const Dimensions &mpi_position = entry.mpiPositions[f];
+                Dimensions size_read;
+                uint32_t src_ndims = 0;
+
+                if (entry.dataClass == GridType)
+                {
+                    Dimensions box_start, box_end;
+                    for (std::vector<int>::const_iterator r = file_ranks[f].begin();
+                            r != file_ranks[f].end(); ++r)
+                    {
+                        Dimensions dst_offset, src_size, src_offset;
+                        getGridIntersection(entry.clientDomains[f], requests[*r],
+                                ndims, dst_offset, src_size, src_offset);
+
+                        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+                        {
+                            if (r == file_ranks[f].begin() || src_offset[i] < box_start[i])
+                                box_start[i] = src_offset[i];
+                            if (r == file_ranks[f].begin() ||
+                                    src_offset[i] + src_size[i] > box_end[i])
+                                box_end[i] = src_offset[i] + src_size[i];
+                        }
+                    }
+
+                    boxes[f] = Domain(box_start, box_end - box_start);
+                    buffers[f].resize(boxes[f].getSize().getScalarSize() * datatype_size);
+
+                    readDataSet(handles.get(mpi_position), id, name,
+                            boxes[f].getSize(),
+                            Dimensions(0, 0, 0),
+                            boxes[f].getSize(),
+                            boxes[f].getOffset(),
+                            size_read,
+                            src_ndims,
+                            &(buffers[f][0]));
+
+                    if (!(size_read == boxes[f].getSize()))
+                        throw DCException(getExceptionString("readDomainCollective",
+                            "Sizes are not equal but should be (2).", NULL));
+                } else
+                {
+                    buffers[f].resize(entry.dataSizes[f].getScalarSize() * datatype_size);
+
+                    readCompleteDataSet(handles.get(mpi_position), id, name,
+                            entry.dataSizes[f],
+                            Dimensions(0, 0, 0),
+                            Dimensions(0, 0, 0),
+                            size_read,
+                            src_ndims,
+                            &(buffers[f][0]));
+
+                    if (!(size_read == entry.dataSizes[f]))
+                        throw DCException(getExceptionString("readDomainCollective",
+                            "Sizes are not equal but should be (1).", NULL));
+                }
+
+                num_read++;
+            }
+        } catch (const DCException &e)
+        {
+            log_msg(0, "readDomainCollective: %s", e.what());
+            failed = true;
+        }
+
+        try
+        {
+            checkStatus("readDomainCollective", failed);
+        } catch (const DCException &e)
+        {
+            delete data_container;
+            throw e;
+        }
+
+        log_msg(2, "readDomainCollective: process %d read %llu of %llu files",
+                mpiRank, (long long unsigned) num_read,
+                (long long unsigned) read_files.size());
+
+        // allocate results of this process as in readDomain
+        const std::vector<size_t> &files = rank_files[mpiRank];
+        std::vector<DomainData*> targets(num_files, NULL);
+
+        if (!files.empty())
+        {
+            if (entry.dataClass == GridType)
+            {
+                DomainData *target = new DomainData(requestDomain,
+                        requestDomain.getSize(), datatype_size, dc_datatype, allocator);
+                data_container->add(target);
+
+                for (std::vector<size_t>::const_iterator iter = files.begin();
+                        iter != files.end(); ++iter)
+                    targets[*iter] = target;
+            } else
+            {
+                for (std::vector<size_t>::const_iterator iter = files.begin();
+                        iter != files.end(); ++iter)
+                {
+                    targets[*iter] = new DomainData(entry.clientDomains[*iter],
+                            entry.dataSizes[*iter], datatype_size, dc_datatype,
+                            allocator);
+                    data_container->add(targets[*iter]);
+                }
+            }
+
+            if (dataClass != NULL)
+                *dataClass = entry.dataClass;
+        }
+
+        // Receive the parts of all required files directly into the
+        // results and send the parts of the files read by this process,
+        // both in the order of the read files.
+        MPI_Datatype element_type;
+        MPI_Type_contiguous(datatype_size, MPI_BYTE, &element_type);
+        MPI_Type_commit(&element_type);
+
+        // Create the types of all messages first. Messages are only posted
+        // if this succeeds on all processes, otherwise a peer would wait
+        // for a message which is never posted.
+        std::vector<Transfer> receives;
+        std::vector<Transfer> sends;
+        bool valid = true;
+
+        for (std::vector<size_t>::const_iterator iter = read_files.begin();
+                iter != read_files.end(); ++iter)
+        {
+            const size_t f = *iter;
+            if (targets[f] == NULL)
+                continue;
+
+            Transfer transfer;
+            transfer.buffer = targets[f]->getData();
+            transfer.peer = file_owners[f];
+
+            if (entry.dataClass == GridType)
+            {
+                Dimensions dst_offset, src_size, src_offset;
+                getGridIntersection(entry.clientDomains[f], requestDomain,
+                        ndims, dst_offset, src_size, src_offset);
+
+                if (!createSubarrayType(requestDomain.getSize(), src_size, dst_offset,
+                        element_type, &(transfer.type)))
+                {
+                    valid = false;
+                    continue;
+                }
+
+                transfer.count = 1;
+                transfer.ownsType = true;
+            } else
+            {
+                const size_t count = entry.dataSizes[f].getScalarSize();
+                if (count > (size_t) std::numeric_limits<int>::max())
+                {
+                    valid = false;
+                    continue;
+                }
+
+                transfer.count = count;
+                transfer.type = element_type;
+                transfer.ownsType = false;
+            }
+
+            receives.push_back(transfer);
+        }
+
+        for (std::vector<size_t>::const_iterator iter = read_files.begin();
+                iter != read_files.end(); ++iter)
+        {
+            const size_t f = *iter;
+            if (file_owners[f] != mpiRank)
+                continue;
+
+            for (std::vector<int>::const_iterator r = file_ranks[f].begin();
+                    r != file_ranks[f].end(); ++r)
+            {
+                Transfer transfer;
+                transfer.buffer = &(buffers[f][0]);
+                transfer.peer = *r;
+
+                if (entry.dataClass == GridType)
+                {
+                    Dimensions dst_offset, src_size, src_offset;
+                    getGridIntersection(entry.clientDomains[f], requests[*r],
+                            ndims, dst_offset, src_size, src_offset);
+
+                    if (!createSubarrayType(boxes[f].getSize(), src_size,
+                            src_offset - boxes[f].getOffset(), element_type,
+                            &(transfer.type)))
+                    {
+                        valid = false;
+                        continue;
+                    }
+
+                    transfer.count = 1;
+                    transfer.ownsType = true;
+                } else
+                {
+                    const size_t count = entry.dataSizes[f].getScalarSize();
+                    if (count > (size_t) std::numeric_limits<int>::max())
+                    {
+                        valid = false;
+                        continue;
+                    }
+
+                    transfer.count = count;
+                    transfer.type = element_type;
+                    transfer.ownsType = false;
+                }
+
+                sends.push_back(transfer);
+            }
+        }
+
+        bool all_valid = true;
+        try
+        {
+            checkStatus("readDomainCollective", !valid);
+        } catch (const DCException&)
+        {
+            all_valid = false;
+        }
+
+        int result = MPI_SUCCESS;
+        if (all_valid)
+        {
+            std::vector<MPI_Request> mpi_requests(receives.size() + sends.size());
+            for (size_t i = 0; i < receives.size(); ++i)
+                MPI_Irecv(receives[i].buffer, receives[i].count, receives[i].type,
+                        receives[i].peer, TAG_DOMAIN_DATA, comm, &(mpi_requests[i]));
+
+            for (size_t i = 0; i < sends.size(); ++i)
+                MPI_Isend(sends[i].buffer, sends[i].count, sends[i].type,
+                        sends[i].peer, TAG_DOMAIN_DATA, comm,
+                        &(mpi_requests[receives.size() + i]));
+
+            if (!mpi_requests.empty())
+                result = MPI_Waitall(mpi_requests.size(), &(mpi_requests[0]),
+                    MPI_STATUSES_IGNORE);
+        }
+
+        for (size_t i = 0; i < receives.size(); ++i)
+            if (receives[i].ownsType)
+                MPI_Type_free(&(receives[i].type));
+
+        for (size_t i = 0; i < sends.size(); ++i)
+            if (sends[i].ownsType)
+                MPI_Type_free(&(sends[i].type));
+
+        MPI_Type_free(&element_type);
+
+        if (!all_valid || (result != MPI_SUCCESS))
+        {
+            delete data_container;
+            throw DCException(getExceptionString("readDomainCollective",
+                all_valid ? "MPI_Waitall failed" : "data too large for MPI transfer", name));
+        }
+
+        return data_container;
+    }
+
+}
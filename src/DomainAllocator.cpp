@@ -0,0 +1,170 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <algorithm>
+
+#include "splash/domains/DomainAllocator.hpp"
+
+namespace splash
+{
+
+    // size and alignment of transparent huge pages on x86_64
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    AlignedAllocator::AlignedAllocator(size_t alignment, bool hugePages) :
+    alignment(std::max(alignment, sizeof (void*))),
+    hugePages(hugePages)
+    {
+    }
+
+    void* AlignedAllocator::allocate(size_t bytes) throw (DCException)
+    {
+        const bool huge = hugePages && (bytes >= HUGE_PAGE_SIZE);
+
+        void *ptr = NULL;
+        if (posix_memalign(&ptr, huge ? std::max(alignment, HUGE_PAGE_SIZE) : alignment,
+                std::max(bytes, (size_t) 1)) != 0)
+            throw DCException("AlignedAllocator::allocate: failed to allocate memory");
+
+#if defined(MADV_HUGEPAGE)
+        // only a hint, buffers are still usable without huge pages
+        if (huge)
+            madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+
+        return ptr;
+    }
+
+    void AlignedAllocator::deallocate(void *ptr, size_t)
+    {
+        free(ptr);
+    }
+
+    PoolAllocator::PoolAllocator(DomainAllocator &upstream, size_t maxBytes) :
+    upstream(upstream),
+    maxBytes(maxBytes),
+    pooledBytes(0)
+    {
+    }
+
+    PoolAllocator::~PoolAllocator()
+    {
+        release();
+    }
+
+    void* PoolAllocator::allocate(size_t bytes) throw (DCException)
+    {
+        std::multimap<size_t, void*>::iterator iter = pool.find(bytes);
+        if (iter != pool.end())
+        {
+            void *ptr = iter->second;
+            pool.erase(iter);
+            pooledBytes -= bytes;
+            return ptr;
+        }
+
+        return upstream.allocate(bytes);
+    }
+
+    void PoolAllocator::deallocate(void *ptr, size_t bytes)
+    {
+        if (pooledBytes + bytes > maxBytes)
+        {
+            upstream.deallocate(ptr, bytes);
+            return;
+        }
+
+        pool.insert(std::make_pair(bytes, ptr));
+        pooledBytes += bytes;
+    }
+
+    void PoolAllocator::release()
+    {
+        for (std::multimap<size_t, void*>::iterator iter = pool.begin();
+                iter != pool.end(); ++iter)
+            upstream.deallocate(iter->second, iter->first);
+
+        pool.clear();
+        pooledBytes = 0;
+    }
+
+    size_t PoolAllocator::getPooledBytes() const
+    {
+        return pooledBytes;
+    }
+
+    ArenaAllocator::ArenaAllocator(size_t blockSize, size_t alignment) :
+    blockAllocator(alignment, true),
+    blockSize(blockSize),
+    alignment(std::max(alignment, (size_t) 1)),
+    currentBlock(0),
+    currentOffset(0)
+    {
+    }
+
+    ArenaAllocator::~ArenaAllocator()
+    {
+        for (size_t i = 0; i < blocks.size(); ++i)
+            blockAllocator.deallocate(blocks[i].first, blocks[i].second);
+    }
+
+    void* ArenaAllocator::allocate(size_t bytes) throw (DCException)
+    {
+        // keep following buffers aligned
+        const size_t aligned_bytes = std::max(
+                (bytes + alignment - 1) / alignment * alignment, alignment);
+
+        while (currentBlock < blocks.size())
+        {
+            if (currentOffset + aligned_bytes <= blocks[currentBlock].second)
+            {
+                void *ptr = blocks[currentBlock].first + currentOffset;
+                currentOffset += aligned_bytes;
+                return ptr;
+            }
+
+            currentBlock++;
+            currentOffset = 0;
+        }
+
+        const size_t new_size = std::max(blockSize, aligned_bytes);
+        blocks.push_back(std::make_pair(
+                (uint8_t*) blockAllocator.allocate(new_size), new_size));
+        currentBlock = blocks.size() - 1;
+        currentOffset = aligned_bytes;
+
+        return blocks.back().first;
+    }
+
+    void ArenaAllocator::deallocate(void*, size_t)
+    {
+    }
+
+    void ArenaAllocator::reset()
+    {
+        currentBlock = 0;
+        currentOffset = 0;
+    }
+
+}
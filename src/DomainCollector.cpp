@@ -23,6 +23,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <iterator>
+#include <map>
 #include <math.h>
 
 #include "splash/basetypes/basetypes.hpp"
@@ -30,13 +33,54 @@
 #include "splash/core/DCDataSet.hpp"
 #include "splash/core/DCGroup.hpp"
 #include "splash/core/DCAttribute.hpp"
+#include "splash/core/DCStatistics.hpp"
 #include "splash/core/logging.hpp"
+#if defined(SPLASH_HAVE_THREADS)
+#include "splash/core/GridReadPool.hpp"
+#endif
 
 namespace splash
 {
 
+    /**
+     * Orders file positions by the offsets of their domains,
+     * the last dimension varying slowest.
+     */
+    class LowerDomainOffset
+    {
+    public:
+
+        LowerDomainOffset(const std::vector<Domain> &domains_) :
+        domains(domains_)
+        {
+        }
+
+        bool operator()(size_t a, size_t b) const
+        {
+            const Dimensions offset_a = domains[a].getOffset();
+            const Dimensions offset_b = domains[b].getOffset();
+
+            for (int d = DSP_DIM_MAX - 1; d >= 0; --d)
+            {
+                if (offset_a[d] != offset_b[d])
+                    return offset_a[d] < offset_b[d];
+            }
+
+            return false;
+        }
+
+    private:
+        const std::vector<Domain> &domains;
+    };
+
     DomainCollector::DomainCollector(uint32_t maxFileHandles) :
-    SerialDataCollector(maxFileHandles)
+    SerialDataCollector(maxFileHandles),
+    allocator(NULL),
+    readThreads(1),
+    lazyPageSize(256 * 1024),
+    lazyPageCache(64 * 1024 * 1024),
+    packedDomainAttributes(false),
+    separateDomainAttributes(true)
     {
     }
 
@@ -82,8 +126,16 @@ namespace splash
         Dimensions domain_size;
         Dimensions domain_offset;
 
-        readAttributeInfo(id, name, DOMCOL_ATTR_SIZE, &mpi_position).read(domain_size.getPointer(), domain_size.getSize());
-        readAttributeInfo(id, name, DOMCOL_ATTR_OFFSET, &mpi_position).read(domain_offset.getPointer(), domain_offset.getSize());
+        DomainAttribute attribute;
+        if (readPackedDomainAttribute(id, name, &mpi_position, attribute))
+            return attribute.localDomain;
+
+        ColTypeDim dim_t;
+        const AttributeEntry entries[] = {
+            {DOMCOL_ATTR_SIZE, &dim_t, domain_size.getPointer()},
+            {DOMCOL_ATTR_OFFSET, &dim_t, domain_offset.getPointer()}
+        };
+        readAttributes(id, name, entries, 2, &mpi_position);
 
         return Domain(domain_offset, domain_size);
     }
@@ -98,151 +150,536 @@ namespace splash
     {
         ColTypeInt32 int_t;
         ColTypeDim dim_t;
+        ColTypeDomainAttribute domain_t;
+
+        Domain local_domain(localDomain);
+        Domain global_domain(globalDomain);
+
+        DomainAttribute::Packed packed;
+        DomainAttribute(localDomain, globalDomain, dataClass).toPacked(packed);
+
+        std::vector<DCAttribute::BulkEntry> entries;
+        if (packedDomainAttributes)
+        {
+            DCAttribute::BulkEntry entry = {DOMCOL_ATTR_DOMAIN, domain_t.getDataType(), &packed};
+            entries.push_back(entry);
+        }
+
+        if (!packedDomainAttributes || separateDomainAttributes)
+        {
+            const DCAttribute::BulkEntry separate[] = {
+                {DOMCOL_ATTR_CLASS, int_t.getDataType(), &dataClass},
+                {DOMCOL_ATTR_SIZE, dim_t.getDataType(), local_domain.getSize().getPointer()},
+                {DOMCOL_ATTR_OFFSET, dim_t.getDataType(), local_domain.getOffset().getPointer()},
+                {DOMCOL_ATTR_GLOBAL_SIZE, dim_t.getDataType(), global_domain.getSize().getPointer()},
+                {DOMCOL_ATTR_GLOBAL_OFFSET, dim_t.getDataType(), global_domain.getOffset().getPointer()}
+            };
+            entries.insert(entries.end(), separate, separate + 5);
+        }
 
         hid_t dset_handle = openDatasetHandle(id, name, NULL);
 
-        DCAttribute::writeAttribute(DOMCOL_ATTR_CLASS, int_t.getDataType(),
-                dset_handle, &dataClass);
-        DCAttribute::writeAttribute(DOMCOL_ATTR_SIZE, dim_t.getDataType(),
-                dset_handle, localDomain.getSize().getPointer());
-        DCAttribute::writeAttribute(DOMCOL_ATTR_OFFSET, dim_t.getDataType(),
-                dset_handle, localDomain.getOffset().getPointer());
-        DCAttribute::writeAttribute(DOMCOL_ATTR_GLOBAL_SIZE, dim_t.getDataType(),
-                dset_handle, globalDomain.getSize().getPointer());
-        DCAttribute::writeAttribute(DOMCOL_ATTR_GLOBAL_OFFSET, dim_t.getDataType(),
-                dset_handle, globalDomain.getOffset().getPointer());
+        try
+        {
+            DCAttribute::writeAttributes(dset_handle, &(entries[0]), entries.size());
+        } catch (const DCException&)
+        {
+            closeDatasetHandle(dset_handle);
+            throw;
+        }
 
         closeDatasetHandle(dset_handle);
     }
 
-    bool DomainCollector::readDomainInfoForRank(
+    void DomainCollector::setReadThreads(uint32_t numThreads)
+    {
+        readThreads = std::max(numThreads, (uint32_t) 1);
+    }
+
+    void DomainCollector::setLazyPageCache(size_t pageSize, size_t maxBytes)
+    {
+        lazyPageSize = pageSize;
+        lazyPageCache.setMaxBytes(maxBytes);
+    }
+
+    void DomainCollector::setAllocator(DomainAllocator *allocator)
+    {
+        this->allocator = allocator;
+    }
+
+    void DomainCollector::setPackedDomainAttributes(bool enabled, bool writeSeparate)
+    {
+        packedDomainAttributes = enabled;
+        separateDomainAttributes = writeSeparate;
+    }
+
+    bool DomainCollector::readPackedDomainAttribute(int32_t id,
+            const char *name,
+            Dimensions *mpiPosition,
+            DomainAttribute &attribute)
+    throw (DCException)
+    {
+        ColTypeDomainAttribute domain_t;
+        DomainAttribute::Packed packed;
+
+        const DCAttribute::BulkEntry entry = {DOMCOL_ATTR_DOMAIN, domain_t.getDataType(), &packed};
+        if (!readAttributesInternal(id, name, &entry, 1, mpiPosition, false))
+            return false;
+
+        attribute.fromPacked(packed);
+        return true;
+    }
+
+    void DomainCollector::close()
+    {
+        domainIndices.clear();
+        lazyPageCache.clear();
+        lazyPage.clear();
+        SerialDataCollector::close();
+    }
+
+    void DomainCollector::readDomainAttributes(
             Dimensions mpiPosition,
             int32_t id,
             const char* name,
-            const Domain requestDomain,
-            Domain &fileDomain)
+            Domain &clientDomain,
+            Dimensions &dataSize,
+            DomDataClass &dataClass)
     throw (DCException)
     {
+        Domain local_client_domain, global_client_domain;
+
+        DomainAttribute attribute;
+        if (readPackedDomainAttribute(id, name, &mpiPosition, attribute))
         {
-            hid_t dset_handle = openDatasetHandle(id, name, &mpiPosition);
-            Dimensions global_domain_offset;
+            local_client_domain = attribute.localDomain;
+            global_client_domain = attribute.globalDomain;
+            dataClass = attribute.dataClass;
+        } else
+        {
+            ColTypeInt32 int_t;
+            ColTypeDim dim_t;
+
+            // a single call per file, attributes are cached while reading
+            const AttributeEntry entries[] = {
+                {DOMCOL_ATTR_OFFSET, &dim_t, local_client_domain.getOffset().getPointer()},
+                {DOMCOL_ATTR_SIZE, &dim_t, local_client_domain.getSize().getPointer()},
+                {DOMCOL_ATTR_GLOBAL_OFFSET, &dim_t, global_client_domain.getOffset().getPointer()},
+                {DOMCOL_ATTR_GLOBAL_SIZE, &dim_t, global_client_domain.getSize().getPointer()},
+                {DOMCOL_ATTR_CLASS, &int_t, &dataClass}
+            };
+            readAttributes(id, name, entries, 5, &mpiPosition);
+        }
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_OFFSET, dset_handle,
-                    fileDomain.getOffset().getPointer());
+        clientDomain = Domain(
+                local_client_domain.getOffset() + global_client_domain.getOffset(),
+                local_client_domain.getSize());
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_SIZE, dset_handle,
-                    fileDomain.getSize().getPointer());
+        readSizeInternal(handles.get(mpiPosition), id, name, dataSize);
+    }
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_GLOBAL_OFFSET, dset_handle,
-                    global_domain_offset.getPointer());
+    DomainCollector::DomainIndexEntry &DomainCollector::getDomainIndex(
+            int32_t id, const char* name)
+    throw (DCException)
+    {
+        DomainIndexEntry *cached = findDomainIndex(id, name);
+        if (cached != NULL)
+            return *cached;
+
+        // a domain table in the first file describes all files,
+        // so the other files need not be opened for planning
+        std::vector<DomainTableEntry> table;
+        if (readMergedDomainTable(id, name, table))
+        {
+            DomainIndexEntry &entry = addDomainIndex(id, name, table);
 
-            fileDomain.getOffset() += global_domain_offset;
+            log_msg(2, "built domain index for %d/%s from domain table with %llu files",
+                    id, name, (long long unsigned) entry.index.getSize());
 
-            closeDatasetHandle(dset_handle);
+            return entry;
         }
 
-        // zero request sizes will not intersect with anything
-        if (requestDomain.getSize() == Dimensions(0, 0, 0))
+        Dimensions mpi_size(1, 1, 1);
+        if (fileStatus == FST_MERGING)
+            mpi_size.set(mpiTopology);
+
+        for (size_t z = 0; z < mpi_size[2]; ++z)
+            for (size_t y = 0; y < mpi_size[1]; ++y)
+                for (size_t x = 0; x < mpi_size[0]; ++x)
+                {
+                    table.push_back(DomainTableEntry());
+                    readFileDomain(Dimensions(x, y, z), id, name, table.back());
+                }
+
+        DomainIndexEntry &entry = addDomainIndex(id, name, table);
+
+        log_msg(2, "built domain index for %d/%s with %llu files",
+                id, name, (long long unsigned) entry.index.getSize());
+
+        return entry;
+    }
+
+    DomainCollector::DomainIndexEntry *DomainCollector::findDomainIndex(
+            int32_t id, const char* name)
+    {
+        std::map<std::pair<int32_t, std::string>, DomainIndexEntry>::iterator iter =
+                domainIndices.find(std::make_pair(id, std::string(name)));
+        if (iter == domainIndices.end())
+            return NULL;
+
+        return &(iter->second);
+    }
+
+    bool DomainCollector::readMergedDomainTable(int32_t id,
+            const char* name,
+            std::vector<DomainTableEntry> &table)
+    throw (DCException)
+    {
+        if (fileStatus != FST_MERGING)
             return false;
 
-        return Domain::testIntersection(requestDomain, fileDomain);
+        const Dimensions mpi_size = mpiTopology;
+        if (!readDomainTable(id, name, table) ||
+                (table.size() != mpi_size.getScalarSize()))
+        {
+            table.clear();
+            return false;
+        }
+
+        for (std::vector<DomainTableEntry>::const_iterator iter = table.begin();
+                iter != table.end(); ++iter)
+        {
+            for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+                if (iter->mpiPosition[i] >= mpi_size[i])
+                    throw DCException("DomainCollector::readDomain: Domain table does not match MPI topology.");
+        }
+
+        return true;
     }
 
-    void DomainCollector::readGridInternal(
-            DataContainer *dataContainer,
-            Dimensions mpiPosition,
+    void DomainCollector::readFileDomain(Dimensions mpiPosition,
             int32_t id,
             const char* name,
-            const Domain &clientDomain,
-            const Domain &requestDomain
-            )
+            DomainTableEntry &entry)
     throw (DCException)
     {
-        log_msg(3, "dataclass = Grid");
+        Domain client_domain;
+        Dimensions data_size;
+        DomDataClass data_class = UndefinedType;
 
-        // When the first intersection is found, the whole destination
-        // buffer is allocated and added to the container.
-        if (dataContainer->getNumSubdomains() == 0)
+        readDomainAttributes(mpiPosition, id, name,
+                client_domain, data_size, data_class);
+
+        log_msg(3,
+                "mpi_position %s: clientdom. = %s data size = %s",
+                mpiPosition.toString().c_str(),
+                client_domain.toString().c_str(),
+                data_size.toString().c_str());
+
+        const bool emptyRequest = (data_size.getScalarSize() == 1 &&
+                client_domain.getSize().getScalarSize() == 0);
+
+        if (data_class == GridType && data_size != client_domain.getSize() &&
+                !emptyRequest)
+            throw DCException("DomainCollector::readDomain: Size of data must match domain size for Grid data.");
+
+        entry = DomainTableEntry(mpiPosition, client_domain,
+                Dimensions(0, 0, 0), data_size, data_class);
+    }
+
+    DomainCollector::DomainIndexEntry &DomainCollector::addDomainIndex(
+            int32_t id,
+            const char* name,
+            const std::vector<DomainTableEntry> &table)
+    throw (DCException)
+    {
+        DomainIndexEntry entry;
+        entry.dataClass = UndefinedType;
+
+        for (std::vector<DomainTableEntry>::const_iterator iter = table.begin();
+                iter != table.end(); ++iter)
         {
-            std::stringstream group_id_name;
-            group_id_name << SDC_GROUP_DATA << "/" << id;
-            std::string group_id_string = group_id_name.str();
+            if (entry.dataClass == UndefinedType)
+                entry.dataClass = iter->dataClass;
+            else if (iter->dataClass != entry.dataClass)
+                throw DCException("DomainCollector::readDomain: Data classes in files are inconsistent!");
+
+            entry.mpiPositions.push_back(iter->mpiPosition);
+            entry.clientDomains.push_back(iter->domain);
+            entry.dataSizes.push_back(iter->elements);
+        }
 
-            DCGroup group;
-            group.open(handles.get(mpiPosition), group_id_string);
+        entry.index.build(entry.clientDomains);
 
-            size_t datatype_size = 0;
-            DCDataType dc_datatype = DCDT_UNKNOWN;
+        return domainIndices.insert(std::make_pair(
+                std::make_pair(id, std::string(name)), entry)).first->second;
+    }
 
-            try
-            {
-                DCDataSet tmp_dataset(name);
-                tmp_dataset.open(group.getHandle());
+    void DomainCollector::writeDomainTable(int32_t id,
+            const char* name,
+            const std::vector<DomainTableEntry> &entries)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException("DomainCollector::writeDomainTable: parameter name is NULL");
 
-                datatype_size = tmp_dataset.getDataTypeSize();
-                dc_datatype = tmp_dataset.getDCDataType();
+        if ((fileStatus == FST_CLOSED) || (fileStatus == FST_READING) ||
+                (fileStatus == FST_MERGING))
+            throw DCException("DomainCollector::writeDomainTable: this access is not permitted");
 
-                tmp_dataset.close();
-            } catch (const DCException& e)
-            {
-                throw e;
-            }
+        if (entries.empty())
+            throw DCException("DomainCollector::writeDomainTable: domain table is empty");
 
-            group.close();
+        std::vector<uint64_t> rows(entries.size() * DomainTableEntry::NUM_COLUMNS);
+        for (size_t i = 0; i < entries.size(); ++i)
+            entries[i].toRow(&(rows[i * DomainTableEntry::NUM_COLUMNS]));
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_HEADER "/" DOMCOL_GROUP_TABLE,
+                id, group_path, dset_name);
+
+        DCGroup group;
+        group.openCreate(handles.get(0), group_path);
+
+        ColTypeUInt64 uint64_type;
+        const Dimensions size(rows.size(), 1, 1);
+
+        DCDataSet dataset(dset_name);
+        dataset.create(uint64_type, group.getHandle(), size, 1, false, false);
+        dataset.write(Selection(size), Dimensions(0, 0, 0), &(rows[0]));
+        dataset.close();
+
+        log_msg(2, "wrote domain table for %d/%s with %llu entries",
+                id, name, (long long unsigned) entries.size());
+    }
+
+    bool DomainCollector::readDomainTable(int32_t id,
+            const char* name,
+            std::vector<DomainTableEntry> &entries)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException("DomainCollector::readDomainTable: parameter name is NULL");
+
+        if ((fileStatus != FST_MERGING) && (fileStatus != FST_READING))
+            throw DCException("DomainCollector::readDomainTable: this access is not permitted");
+
+        entries.clear();
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_HEADER "/" DOMCOL_GROUP_TABLE,
+                id, group_path, dset_name);
+
+        H5Handle h5File = handles.get(Dimensions(0, 0, 0));
+        if (!DCGroup::exists(h5File, group_path + std::string("/") + dset_name))
+            return false;
+
+        DCGroup group;
+        group.open(h5File, group_path);
 
-            DomainData *target_data = new DomainData(
-                    requestDomain, requestDomain.getSize(),
-                    datatype_size, dc_datatype);
+        DCDataSet dataset(dset_name);
+        dataset.open(group.getHandle());
 
-            dataContainer->add(target_data);
+        const Dimensions size = dataset.getSize();
+        if (size.getScalarSize() % DomainTableEntry::NUM_COLUMNS != 0)
+            throw DCException("DomainCollector::readDomainTable: invalid domain table");
+
+        std::vector<uint64_t> rows(size.getScalarSize());
+        if (!rows.empty())
+        {
+            Dimensions size_read;
+            uint32_t src_ndims = 0;
+            dataset.read(size, Dimensions(0, 0, 0), size_read, src_ndims, &(rows[0]));
         }
 
-        // Compute the offsets and sizes for reading and
-        // writing this intersection.
-        Dimensions dst_offset(0, 0, 0);
-        Dimensions src_size(1, 1, 1);
-        Dimensions src_offset(0, 0, 0);
+        dataset.close();
 
-        Dimensions client_start = clientDomain.getOffset();
-        Dimensions client_size = clientDomain.getSize();
+        entries.resize(rows.size() / DomainTableEntry::NUM_COLUMNS);
+        for (size_t i = 0; i < entries.size(); ++i)
+            entries[i].fromRow(&(rows[i * DomainTableEntry::NUM_COLUMNS]));
 
-        size_t ndims = getNDims(handles.get(mpiPosition), id, name);
+        return true;
+    }
+
+    void DomainCollector::addGridTarget(
+            DataContainer *dataContainer,
+            Dimensions mpiPosition,
+            int32_t id,
+            const char* name,
+            const Domain &requestDomain,
+            const Dimensions &stride)
+    throw (DCException)
+    {
+        std::stringstream group_id_name;
+        group_id_name << SDC_GROUP_DATA << "/" << id;
+        std::string group_id_string = group_id_name.str();
+
+        DCGroup group;
+        group.open(handles.get(mpiPosition), group_id_string);
+
+        size_t datatype_size = 0;
+        DCDataType dc_datatype = DCDT_UNKNOWN;
+
+        try
+        {
+            DCDataSet tmp_dataset(name);
+            tmp_dataset.open(group.getHandle());
+
+            datatype_size = tmp_dataset.getDataTypeSize();
+            dc_datatype = tmp_dataset.getDCDataType();
+
+            tmp_dataset.close();
+        } catch (const DCException& e)
+        {
+            throw e;
+        }
+
+        group.close();
+
+        DomainData *target_data = new DomainData(
+                requestDomain, getStridedSize(requestDomain.getSize(), stride),
+                datatype_size, dc_datatype, allocator);
+
+        dataContainer->add(target_data);
+    }
+
+    Dimensions DomainCollector::getStridedSize(const Dimensions &size,
+            const Dimensions &stride)
+    {
+        Dimensions strided_size;
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            strided_size[i] = (size[i] + stride[i] - 1) / stride[i];
+
+        return strided_size;
+    }
+
+    void DomainCollector::sortByDomainOffset(std::vector<size_t> &files,
+            const std::vector<Domain> &clientDomains)
+    {
+        std::stable_sort(files.begin(), files.end(),
+                LowerDomainOffset(clientDomains));
+    }
+
+    void DomainCollector::getGridIntersection(
+            const Domain &clientDomain,
+            const Domain &requestDomain,
+            uint32_t ndims,
+            Dimensions &dstOffset,
+            Dimensions &srcSize,
+            Dimensions &srcOffset)
+    {
+        dstOffset.set(0, 0, 0);
+        srcSize.set(1, 1, 1);
+        srcOffset.set(0, 0, 0);
+
+        const Dimensions &client_start = clientDomain.getOffset();
+        const Dimensions &client_size = clientDomain.getSize();
         const Dimensions &request_offset = requestDomain.getOffset();
         const Dimensions &request_size = requestDomain.getSize();
 
         for (uint32_t i = 0; i < ndims; ++i)
         {
-            dst_offset[i] = std::max((int64_t) clientDomain.getOffset()[i] - (int64_t) request_offset[i], (int64_t) 0);
-
-            dst_offset[i] = std::max((int64_t) clientDomain.getOffset()[i] -
+            dstOffset[i] = std::max((int64_t) client_start[i] -
                     (int64_t) request_offset[i], (int64_t) 0);
 
             if (request_offset[i] <= client_start[i])
             {
                 // request starts before/equal client offset
-                src_offset[i] = 0;
+                srcOffset[i] = 0;
 
                 if (request_offset[i] + request_size[i] >= client_start[i] + client_size[i])
                     // end of request stretches beyond client limits
-                    src_size[i] = client_size[i];
+                    srcSize[i] = client_size[i];
                 else
                     // end of request within client limits
-                    src_size[i] = request_offset[i] + request_size[i] - client_start[i];
+                    srcSize[i] = request_offset[i] + request_size[i] - client_start[i];
             } else
             {
                 // request starts after client offset
-                src_offset[i] = request_offset[i] - client_start[i];
+                srcOffset[i] = request_offset[i] - client_start[i];
 
                 if (request_offset[i] + request_size[i] >= client_start[i] + client_size[i])
                     // end of request stretches beyond client limits
-                    src_size[i] = client_size[i] - src_offset[i];
+                    srcSize[i] = client_size[i] - srcOffset[i];
                 else
                     // end of request within client limits
-                    src_size[i] = request_offset[i] + request_size[i] -
-                        (client_start[i] + src_offset[i]);
+                    srcSize[i] = request_offset[i] + request_size[i] -
+                        (client_start[i] + srcOffset[i]);
             }
         }
 
+        assert(srcSize[0] <= request_size[0]);
+        assert(srcSize[1] <= request_size[1]);
+        assert(srcSize[2] <= request_size[2]);
+    }
+
+    bool DomainCollector::getGridIntersection(
+            const Domain &clientDomain,
+            const Domain &requestDomain,
+            const Dimensions &stride,
+            uint32_t ndims,
+            Dimensions &dstOffset,
+            Dimensions &srcSize,
+            Dimensions &srcOffset)
+    {
+        dstOffset.set(0, 0, 0);
+        srcSize.set(1, 1, 1);
+        srcOffset.set(0, 0, 0);
+
+        const Dimensions &client_start = clientDomain.getOffset();
+        const Dimensions &client_size = clientDomain.getSize();
+        const Dimensions &request_offset = requestDomain.getOffset();
+        const Dimensions &request_size = requestDomain.getSize();
+
+        for (uint32_t i = 0; i < ndims; ++i)
+        {
+            const uint64_t start = std::max(client_start[i], request_offset[i]);
+            const uint64_t end = std::min(client_start[i] + client_size[i],
+                    request_offset[i] + request_size[i]);
+
+            // first element of the intersection on the strided request grid
+            const uint64_t first = request_offset[i] +
+                    (start - request_offset[i] + stride[i] - 1) / stride[i] * stride[i];
+            if (first >= end)
+                return false;
+
+            dstOffset[i] = (first - request_offset[i]) / stride[i];
+            srcOffset[i] = first - client_start[i];
+            srcSize[i] = (end - first + stride[i] - 1) / stride[i];
+        }
+
+        return true;
+    }
+
+    void DomainCollector::readGridInternal(
+            DataContainer *dataContainer,
+            Dimensions mpiPosition,
+            int32_t id,
+            const char* name,
+            const Domain &clientDomain,
+            const Domain &requestDomain,
+            const Dimensions &stride
+            )
+    throw (DCException)
+    {
+        log_msg(3, "dataclass = Grid");
+
+        // When the first intersection is found, the whole destination
+        // buffer is allocated and added to the container.
+        if (dataContainer->getNumSubdomains() == 0)
+            addGridTarget(dataContainer, mpiPosition, id, name, requestDomain, stride);
+
+        // Compute the offsets and sizes for reading and
+        // writing this intersection.
+        Dimensions dst_offset, src_size, src_offset;
+        size_t ndims = getNDims(handles.get(mpiPosition), id, name);
+        if (!getGridIntersection(clientDomain, requestDomain, stride, ndims,
+                dst_offset, src_size, src_offset))
+        {
+            log_msg(3, "skipping file without strided elements");
+            return;
+        }
+
         log_msg(3,
                 "clientDomain.getSize() = %s\n"
                 "dst_offset = %s "
@@ -253,18 +690,15 @@ namespace splash
                 src_size.toString().c_str(),
                 src_offset.toString().c_str());
 
-        assert(src_size[0] <= request_size[0]);
-        assert(src_size[1] <= request_size[1]);
-        assert(src_size[2] <= request_size[2]);
-
         // read intersecting partition into destination buffer
         Dimensions elements_read(0, 0, 0);
         uint32_t src_dims = 0;
         readDataSet(handles.get(mpiPosition), id, name,
-                dataContainer->getIndex(0)->getSize(),
+                dataContainer->getIndex(0)->getElements(),
                 dst_offset,
                 src_size,
                 src_offset,
+                stride,
                 elements_read,
                 src_dims,
                 dataContainer->getIndex(0)->getData());
@@ -273,6 +707,97 @@ namespace splash
             throw DCException("DomainCollector::readGridInternal: Sizes are not equal but should be (2).");
     }
 
+#if defined(SPLASH_HAVE_THREADS)
+    void DomainCollector::readGridThreaded(
+            DataContainer *dataContainer,
+            DomainIndexEntry &entry,
+            const std::vector<size_t> &files,
+            int32_t id,
+            const char* name,
+            const Domain &requestDomain)
+    throw (DCException)
+    {
+        const Dimensions no_stride(1, 1, 1);
+        addGridTarget(dataContainer, entry.mpiPositions[files[0]], id, name,
+                requestDomain, no_stride);
+        DomainData *target = dataContainer->getIndex(0);
+
+        if (entry.rawLocations.empty())
+        {
+            RawLocation unknown;
+            unknown.ndims = 0;
+            entry.rawLocations.resize(entry.mpiPositions.size(), unknown);
+        }
+
+        // Workers copy the raw data of unfiltered datasets while this thread
+        // opens the next files with HDF5. Other datasets (e.g. compressed)
+        // are read with HDF5 by this thread.
+        GridReadPool pool(target->getData(), target->getSize(), target->getTypeSize());
+        pool.start(readThreads);
+
+        size_t num_direct = 0;
+        for (std::vector<size_t>::const_iterator iter = files.begin();
+                iter != files.end(); ++iter)
+        {
+            const Dimensions &mpi_position = entry.mpiPositions[*iter];
+            RawLocation &location = entry.rawLocations[*iter];
+
+            // locations are kept with the index, so later reads
+            // of this dataset need no HDF5 calls for this file
+            if (location.ndims == 0)
+            {
+                H5Handle h5File = handles.get(mpi_position);
+
+                std::string group_path, dset_name;
+                DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+                DCGroup group;
+                group.open(h5File, group_path);
+
+                DCDataSet dataset(dset_name);
+                dataset.open(group.getHandle());
+                dataset.getRawExtents(location.addresses, location.origins,
+                        location.extentSize);
+                location.ndims = dataset.getNDims();
+                dataset.close();
+                group.close();
+
+                ssize_t name_length = H5Fget_name(h5File, NULL, 0);
+                if (name_length < 0)
+                    throw DCException("DomainCollector::readGridThreaded: Failed to get filename.");
+
+                std::vector<char> filename(name_length + 1);
+                H5Fget_name(h5File, &(filename[0]), filename.size());
+                location.filename.assign(&(filename[0]));
+            }
+
+            if (location.addresses.empty())
+            {
+                readGridInternal(dataContainer, mpi_position, id, name,
+                        entry.clientDomains[*iter], requestDomain, no_stride);
+                continue;
+            }
+
+            GridReadPool::Job job;
+            getGridIntersection(entry.clientDomains[*iter], requestDomain,
+                    location.ndims, job.dstOffset, job.srcSize, job.srcOffset);
+
+            job.filename = location.filename;
+            job.addresses = location.addresses;
+            job.origins = location.origins;
+            job.extentSize = location.extentSize;
+            pool.add(job);
+            num_direct++;
+        }
+
+        pool.finish();
+
+        log_msg(3, "read %llu of %llu files with %u threads",
+                (long long unsigned) num_direct, (long long unsigned) files.size(),
+                readThreads);
+    }
+#endif
+
     void DomainCollector::readPolyInternal(
             DataContainer *dataContainer,
             Dimensions mpiPosition,
@@ -280,402 +805,806 @@ namespace splash
             const char* name,
             const Dimensions &dataSize,
             const Domain &clientDomain,
+            const Dimensions &stride,
             bool lazyLoad
             )
     throw (DCException)
     {
         log_msg(3, "dataclass = Poly");
 
-        if (dataSize.getScalarSize() > 0)
+        if (dataSize.getScalarSize() > 0)
+        {
+            std::stringstream group_id_name;
+            group_id_name << SDC_GROUP_DATA << "/" << id;
+            std::string group_id_string = group_id_name.str();
+
+            DCGroup group;
+            group.open(handles.get(mpiPosition), group_id_string);
+
+            size_t datatype_size = 0;
+            DCDataType dc_datatype = DCDT_UNKNOWN;
+
+            try
+            {
+                DCDataSet tmp_dataset(name);
+                tmp_dataset.open(group.getHandle());
+
+                datatype_size = tmp_dataset.getDataTypeSize();
+                dc_datatype = tmp_dataset.getDCDataType();
+
+                tmp_dataset.close();
+            } catch (const DCException& e)
+            {
+                throw e;
+            }
+
+            group.close();
+
+            const Dimensions elements = getStridedSize(dataSize, stride);
+            DomainData *client_data = NULL;
+            if (lazyLoad && lazyPageCache.getMaxBytes() > 0)
+                client_data = new DomainData(clientDomain,
+                    elements, datatype_size, dc_datatype, allocator, this);
+            else
+                client_data = new DomainData(clientDomain,
+                    elements, datatype_size, dc_datatype, allocator);
+
+            if (lazyLoad)
+            {
+                client_data->setLoadingReference(PolyType,
+                        handles.get(mpiPosition), id, name,
+                        dataSize,
+                        Dimensions(0, 0, 0),
+                        dataSize,
+                        Dimensions(0, 0, 0));
+            } else if (elements != dataSize)
+            {
+                Dimensions size_read;
+                uint32_t src_ndims = 0;
+                readDataSet(handles.get(mpiPosition), id, name,
+                        elements,
+                        Dimensions(0, 0, 0),
+                        elements,
+                        Dimensions(0, 0, 0),
+                        stride,
+                        size_read,
+                        src_ndims,
+                        client_data->getData());
+
+                if (!(size_read == elements))
+                    throw DCException("DomainCollector::readPolyInternal: Sizes are not equal but should be (1).");
+            } else
+            {
+                Dimensions size_read;
+                uint32_t src_ndims = 0;
+                readCompleteDataSet(handles.get(mpiPosition), id, name,
+                        dataSize,
+                        Dimensions(0, 0, 0),
+                        Dimensions(0, 0, 0),
+                        size_read,
+                        src_ndims,
+                        client_data->getData());
+
+                if (!(size_read == dataSize))
+                    throw DCException("DomainCollector::readPolyInternal: Sizes are not equal but should be (1).");
+            }
+
+            dataContainer->add(client_data);
+        } else
+        {
+            log_msg(3, "skipping entry with 0 elements");
+        }
+    }
+
+    // unselected elements between two selected ones which are read
+    // anyway to save a separate block
+    static const uint64_t MAX_POLY_RUN_GAP = 64;
+
+    void DomainCollector::getElementRuns(const std::vector<uint64_t> &indices,
+            uint64_t maxGap, ElementRuns &runs)
+    {
+        runs.clear();
+
+        for (std::vector<uint64_t>::const_iterator iter = indices.begin();
+                iter != indices.end(); ++iter)
+        {
+            if (!runs.empty() && *iter <= runs.back().second + maxGap)
+                runs.back().second = *iter + 1;
+            else
+                runs.push_back(std::make_pair(*iter, *iter + 1));
+        }
+    }
+
+    void DomainCollector::intersectElementRuns(const ElementRuns &runs1,
+            const ElementRuns &runs2, ElementRuns &result)
+    {
+        result.clear();
+
+        ElementRuns::const_iterator iter1 = runs1.begin();
+        ElementRuns::const_iterator iter2 = runs2.begin();
+        while (iter1 != runs1.end() && iter2 != runs2.end())
+        {
+            const uint64_t first = std::max(iter1->first, iter2->first);
+            const uint64_t second = std::min(iter1->second, iter2->second);
+            if (first < second)
+                result.push_back(std::make_pair(first, second));
+
+            if (iter1->second < iter2->second)
+                ++iter1;
+            else
+                ++iter2;
+        }
+    }
+
+    void DomainCollector::readElementRuns(DCDataSet &dataset,
+            const ElementRuns &runs,
+            std::vector<uint8_t> &buffer)
+    throw (DCException)
+    {
+        uint64_t elements = 0;
+        for (ElementRuns::const_iterator iter = runs.begin();
+                iter != runs.end(); ++iter)
+            elements += iter->second - iter->first;
+
+        buffer.resize(elements * dataset.getDataTypeSize());
+        if (elements == 0)
+            return;
+
+        MultiSelection select(Dimensions(elements, 1, 1));
+        uint64_t buffer_offset = 0;
+        for (ElementRuns::const_iterator iter = runs.begin();
+                iter != runs.end(); ++iter)
+        {
+            select.add(Dimensions(iter->second - iter->first, 1, 1),
+                    Dimensions(buffer_offset, 0, 0),
+                    Dimensions(iter->first, 0, 0));
+            buffer_offset += iter->second - iter->first;
+        }
+
+        dataset.read(select, &(buffer[0]));
+    }
+
+    void DomainCollector::selectPolyElements(
+            Dimensions mpiPosition,
+            int32_t id,
+            const std::vector<std::string> &positionNames,
+            const Domain &requestDomain,
+            uint64_t numElements,
+            std::vector<uint64_t> &indices)
+    throw (DCException)
+    {
+        indices.clear();
+
+        const Dimensions data_size(numElements, 1, 1);
+        std::vector<double> min_values, max_values;
+        for (size_t i = 0; i < positionNames.size(); ++i)
+        {
+            const uint64_t start = requestDomain.getOffset()[i];
+            const uint64_t end = start + requestDomain.getSize()[i];
+            // the filter is inclusive, the domain excludes its end
+            min_values.push_back((double) start);
+            max_values.push_back(nextafter((double) end, (double) start));
+        }
+
+        // restrict to blocks of all position datasets which may contain
+        // particles inside the request
+        ElementRuns runs(1, std::make_pair((uint64_t) 0, numElements));
+        for (size_t i = 0; i < positionNames.size() && !runs.empty(); ++i)
+        {
+            std::string stats_path, stats_name;
+            DCDataSet::getFullDataPath(positionNames[i], SDC_GROUP_STATISTICS, id,
+                    stats_path, stats_name);
+            if (!DCGroup::exists(handles.get(mpiPosition), stats_path))
+                continue;
+
+            DCGroup stats_group;
+            stats_group.open(handles.get(mpiPosition), stats_path);
+
+            Dimensions block_size;
+            std::vector<bool> candidates;
+            if (!DCStatistics::getCandidates(stats_group.getHandle(), stats_name,
+                    data_size, min_values[i], max_values[i], block_size, candidates))
+                continue;
+
+            ElementRuns block_runs;
+            for (size_t b = 0; b < candidates.size(); ++b)
+            {
+                if (!candidates[b])
+                    continue;
+
+                const uint64_t first = b * block_size[0];
+                const uint64_t second = std::min(first + (uint64_t) block_size[0], numElements);
+                if (!block_runs.empty() && block_runs.back().second == first)
+                    block_runs.back().second = second;
+                else
+                    block_runs.push_back(std::make_pair(first, second));
+            }
+
+            ElementRuns tmp_runs;
+            intersectElementRuns(runs, block_runs, tmp_runs);
+            runs.swap(tmp_runs);
+        }
+
+        std::string group_path, dset_name;
+        std::vector<uint8_t> buffer;
+
+        // filter by every position, reading only the particles which
+        // are still selected
+        for (size_t i = 0; i < positionNames.size() && !runs.empty(); ++i)
+        {
+            DCDataSet::getFullDataPath(positionNames[i], SDC_GROUP_DATA, id,
+                    group_path, dset_name);
+
+            DCGroup group;
+            group.open(handles.get(mpiPosition), group_path);
+
+            DCDataSet dataset(dset_name.c_str());
+            dataset.open(group.getHandle());
+
+            const DCDataType type = dataset.getDCDataType();
+            const size_t type_size = dataset.getDataTypeSize();
+
+            if (type == DCDT_UNKNOWN ||
+                    (type_size != sizeof (int32_t) && type_size != sizeof (int64_t)))
+            {
+                dataset.close();
+                throw DCException(std::string("DomainCollector::readPolyDomain: "
+                        "datatype of position dataset is not supported: ") + positionNames[i]);
+            }
+
+            if (dataset.getSize() != data_size)
+            {
+                dataset.close();
+                throw DCException(std::string("DomainCollector::readPolyDomain: "
+                        "size of position dataset does not match: ") + positionNames[i]);
+            }
+
+            readElementRuns(dataset, runs, buffer);
+            dataset.close();
+
+            std::vector<uint64_t> dim_indices;
+            size_t buffer_offset = 0;
+            for (ElementRuns::const_iterator iter = runs.begin();
+                    iter != runs.end(); ++iter)
+            {
+                const uint64_t run_size = iter->second - iter->first;
+                DCStatistics::filter(type, &(buffer[buffer_offset]),
+                        Dimensions(run_size, 1, 1), Dimensions(iter->first, 0, 0),
+                        data_size, min_values[i], max_values[i], dim_indices);
+                buffer_offset += run_size * type_size;
+            }
+
+            if (i == 0)
+                indices.swap(dim_indices);
+            else
+            {
+                std::vector<uint64_t> tmp_indices;
+                std::set_intersection(indices.begin(), indices.end(),
+                        dim_indices.begin(), dim_indices.end(),
+                        std::back_inserter(tmp_indices));
+                indices.swap(tmp_indices);
+            }
+
+            getElementRuns(indices, MAX_POLY_RUN_GAP, runs);
+        }
+    }
+
+    void DomainCollector::readPolyElements(
+            DataContainer *dataContainer,
+            Dimensions mpiPosition,
+            int32_t id,
+            const char* name,
+            const Domain &clientDomain,
+            uint64_t numElements,
+            const std::vector<uint64_t> &indices)
+    throw (DCException)
+    {
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCGroup group;
+        group.open(handles.get(mpiPosition), group_path);
+
+        DCDataSet dataset(dset_name.c_str());
+        dataset.open(group.getHandle());
+
+        if (dataset.getSize() != Dimensions(numElements, 1, 1))
+        {
+            dataset.close();
+            throw DCException(std::string("DomainCollector::readPolyDomain: "
+                    "size of dataset does not match position datasets: ") + name);
+        }
+
+        const size_t type_size = dataset.getDataTypeSize();
+        const DCDataType type = dataset.getDCDataType();
+
+        ElementRuns runs;
+        getElementRuns(indices, MAX_POLY_RUN_GAP, runs);
+
+        std::vector<uint8_t> buffer;
+        readElementRuns(dataset, runs, buffer);
+        dataset.close();
+
+        DomainData *client_data = new DomainData(clientDomain,
+                Dimensions(indices.size(), 1, 1), type_size, type, allocator);
+        uint8_t *dst = (uint8_t*) client_data->getData();
+
+        // gather selected elements from the runs read
+        size_t buffer_offset = 0;
+        std::vector<uint64_t>::const_iterator index = indices.begin();
+        for (ElementRuns::const_iterator iter = runs.begin();
+                iter != runs.end(); ++iter)
+        {
+            for (; index != indices.end() && *index < iter->second; ++index)
+            {
+                memcpy(dst, &(buffer[buffer_offset + (*index - iter->first) * type_size]),
+                        type_size);
+                dst += type_size;
+            }
+            buffer_offset += (iter->second - iter->first) * type_size;
+        }
+
+        dataContainer->add(client_data);
+    }
+
+    void DomainCollector::readPolyDomain(int32_t id,
+            const Domain requestDomain,
+            const std::vector<std::string> &positionNames,
+            const std::vector<std::string> &names,
+            std::vector<DataContainer*> &containers)
+    throw (DCException)
+    {
+        if ((fileStatus != FST_MERGING) && (fileStatus != FST_READING))
+            throw DCException("DomainCollector::readPolyDomain: this access is not permitted");
+
+        if (positionNames.empty() || positionNames.size() > DSP_DIM_MAX)
+            throw DCException("DomainCollector::readPolyDomain: invalid number of position datasets");
+
+        containers.clear();
+        for (size_t n = 0; n < names.size(); ++n)
+            containers.push_back(new DataContainer());
+
+        // zero request sizes will not intersect with anything
+        if (requestDomain.getSize().getScalarSize() == 0)
+            return;
+
+        const uint32_t ndims = positionNames.size();
+        const Dimensions &request_offset = requestDomain.getOffset();
+        const Dimensions &request_size = requestDomain.getSize();
+
+        try
         {
-            std::stringstream group_id_name;
-            group_id_name << SDC_GROUP_DATA << "/" << id;
-            std::string group_id_string = group_id_name.str();
+            DomainIndexEntry &entry = getDomainIndex(id, positionNames[0].c_str());
+            if (entry.dataClass != PolyType)
+                throw DCException("DomainCollector::readPolyDomain: position datasets must be Poly data");
 
-            DCGroup group;
-            group.open(handles.get(mpiPosition), group_id_string);
+            std::vector<size_t> files;
+            entry.index.query(requestDomain, files);
+            sortByDomainOffset(files, entry.clientDomains);
 
-            size_t datatype_size = 0;
-            DCDataType dc_datatype = DCDT_UNKNOWN;
+            uint64_t elements_total = 0;
+            uint64_t elements_selected = 0;
 
-            try
+            for (std::vector<size_t>::const_iterator iter = files.begin();
+                    iter != files.end(); ++iter)
             {
-                DCDataSet tmp_dataset(name);
-                tmp_dataset.open(group.getHandle());
+                const Dimensions &mpi_position = entry.mpiPositions[*iter];
+                const Dimensions &data_size = entry.dataSizes[*iter];
+                const Domain &client_domain = entry.clientDomains[*iter];
 
-                datatype_size = tmp_dataset.getDataTypeSize();
-                dc_datatype = tmp_dataset.getDCDataType();
+                const uint64_t num_elements = data_size.getScalarSize();
+                if (num_elements == 0)
+                    continue;
 
-                tmp_dataset.close();
-            } catch (const DCException& e)
-            {
-                throw e;
-            }
+                elements_total += num_elements;
 
-            group.close();
+                // particles are expected inside the domain of their file
+                bool inside = true;
+                for (uint32_t i = 0; i < ndims; ++i)
+                {
+                    if (client_domain.getOffset()[i] < request_offset[i] ||
+                            client_domain.getOffset()[i] + client_domain.getSize()[i] >
+                            request_offset[i] + request_size[i])
+                        inside = false;
+                }
 
-            DomainData *client_data = new DomainData(clientDomain,
-                    dataSize, datatype_size, dc_datatype);
+                if (inside)
+                {
+                    for (size_t n = 0; n < names.size(); ++n)
+                        readPolyInternal(containers[n], mpi_position, id,
+                            names[n].c_str(), data_size, client_domain,
+                            Dimensions(1, 1, 1), false);
 
-            if (lazyLoad)
-            {
-                client_data->setLoadingReference(PolyType,
-                        handles.get(mpiPosition), id, name,
-                        dataSize,
-                        Dimensions(0, 0, 0),
-                        Dimensions(0, 0, 0),
-                        Dimensions(0, 0, 0));
-            } else
-            {
-                Dimensions size_read;
-                uint32_t src_ndims = 0;
-                readCompleteDataSet(handles.get(mpiPosition), id, name,
-                        dataSize,
-                        Dimensions(0, 0, 0),
-                        Dimensions(0, 0, 0),
-                        size_read,
-                        src_ndims,
-                        client_data->getData());
+                    elements_selected += num_elements;
+                    continue;
+                }
 
-                if (!(size_read == dataSize))
-                    throw DCException("DomainCollector::readPolyInternal: Sizes are not equal but should be (1).");
+                std::vector<uint64_t> indices;
+                selectPolyElements(mpi_position, id, positionNames, requestDomain,
+                        num_elements, indices);
+
+                if (indices.empty())
+                    continue;
+
+                for (size_t n = 0; n < names.size(); ++n)
+                    readPolyElements(containers[n], mpi_position, id,
+                        names[n].c_str(), client_domain, num_elements, indices);
+
+                elements_selected += indices.size();
             }
 
-            dataContainer->add(client_data);
-        } else
+            log_msg(2, "readPolyDomain: %llu of %llu particles selected",
+                    (long long unsigned) elements_selected,
+                    (long long unsigned) elements_total);
+        } catch (const DCException&)
         {
-            log_msg(3, "skipping entry with 0 elements");
+            for (size_t n = 0; n < containers.size(); ++n)
+                delete containers[n];
+            containers.clear();
+            throw;
         }
     }
 
-    bool DomainCollector::readDomainDataForRank(
-            DataContainer *dataContainer,
-            DomDataClass *dataClass,
-            Dimensions mpiPosition,
-            int32_t id,
+    DataContainer *DomainCollector::readDomain(int32_t id,
             const char* name,
-            const Domain requestDomain,
+            Domain requestDomain,
+            DomDataClass* dataClass,
             bool lazyLoad)
     throw (DCException)
     {
-        log_msg(3, "loading from mpi_position %s", mpiPosition.toString().c_str());
-
-        bool readResult = false;
-        Domain local_client_domain, global_client_domain;
-        Dimensions data_size;
-        DomDataClass tmp_data_class = UndefinedType;
-
-        {
-            hid_t dset_handle = openDatasetHandle(id, name, &mpiPosition);
+        return readDomainInternal(id, name, requestDomain, Dimensions(1, 1, 1),
+                dataClass, lazyLoad);
+    }
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_OFFSET, dset_handle,
-                    local_client_domain.getOffset().getPointer());
+    DataContainer *DomainCollector::readDomain(int32_t id,
+            const char* name,
+            Domain requestDomain,
+            Dimensions stride,
+            DomDataClass* dataClass)
+    throw (DCException)
+    {
+        if (stride.getScalarSize() == 0)
+            throw DCException("DomainCollector::readDomain: stride must not be zero");
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_SIZE, dset_handle,
-                    local_client_domain.getSize().getPointer());
+        return readDomainInternal(id, name, requestDomain, stride, dataClass, false);
+    }
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_GLOBAL_OFFSET, dset_handle,
-                    global_client_domain.getOffset().getPointer());
+    DataContainer *DomainCollector::readDomainInternal(int32_t id,
+            const char* name,
+            const Domain &requestDomain,
+            const Dimensions &stride,
+            DomDataClass* dataClass,
+            bool lazyLoad)
+    throw (DCException)
+    {
+        if ((fileStatus != FST_MERGING) && (fileStatus != FST_READING))
+            throw DCException("DomainCollector::readDomain: this access is not permitted");
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_GLOBAL_SIZE, dset_handle,
-                    global_client_domain.getSize().getPointer());
+        DataContainer *data_container = new DataContainer();
 
-            DCAttribute::readAttribute(DOMCOL_ATTR_CLASS, dset_handle,
-                    &tmp_data_class);
+        log_msg(3,
+                "requestDomain = %s ",
+                requestDomain.toString().c_str());
 
-            closeDatasetHandle(dset_handle);
+        // zero request sizes will not intersect with anything
+        if (requestDomain.getSize().getScalarSize() == 0)
+        {
+            log_msg(2, "readDomain: no data found");
+            return data_container;
         }
 
-        Domain client_domain(
-                local_client_domain.getOffset() + global_client_domain.getOffset(),
-                local_client_domain.getSize());
-
-        readSizeInternal(handles.get(mpiPosition), id, name, data_size);
-
-        log_msg(3,
-                "clientdom. = %s "
-                "requestdom.= %s "
-                "data size  = %s",
-                client_domain.toString().c_str(),
-                requestDomain.toString().c_str(),
-                data_size.toString().c_str());
+        DomainIndexEntry &entry = getDomainIndex(id, name);
 
-        const bool emptyRequest = (data_size.getScalarSize() == 1 &&
-                client_domain.getSize().getScalarSize() == 0);
+        std::vector<size_t> files;
+        entry.index.query(requestDomain, files);
 
-        if (tmp_data_class == GridType && data_size != client_domain.getSize() &&
-                !emptyRequest)
+        if (files.empty())
         {
-            std::cout << data_size.toString() << ", " << client_domain.getSize().toString() << std::endl;
-            throw DCException("DomainCollector::readDomain: Size of data must match domain size for Grid data.");
+            log_msg(2, "readDomain: no data found");
+            return data_container;
         }
 
-        if (*dataClass == UndefinedType)
-        {
-            *dataClass = tmp_data_class;
-        } else
-            if (tmp_data_class != *dataClass)
+        // read files in the order of their domains, starting with the
+        // lowest corner of the requested domain, which is not necessarily
+        // at mpi_pos(0,0,0) for periodically moving (e.g. moving window)
+        // simulations
+        sortByDomainOffset(files, entry.clientDomains);
+
+#if defined(SPLASH_HAVE_THREADS)
+        // the worker threads copy contiguous rows only
+        if ((entry.dataClass == GridType) && (readThreads > 1) && (files.size() > 1) &&
+                (stride == Dimensions(1, 1, 1)))
         {
-            throw DCException("DomainCollector::readDomain: Data classes in files are inconsistent!");
+            readGridThreaded(data_container, entry, files, id, name, requestDomain);
+            files.clear();
         }
+#endif
 
-        // test on intersection and add new DomainData to the container if necessary
-        if (Domain::testIntersection(requestDomain, client_domain))
+        for (std::vector<size_t>::const_iterator iter = files.begin();
+                iter != files.end(); ++iter)
         {
-            readResult = true;
+            const Dimensions &mpi_position = entry.mpiPositions[*iter];
+            log_msg(3, "loading from mpi_position %s", mpi_position.toString().c_str());
 
-            switch (*dataClass)
+            switch (entry.dataClass)
             {
                 case PolyType:
                     // Poly data has no internal grid structure,
                     // so the whole chunk has to be read and is added to the DataContainer.
-                    readPolyInternal(dataContainer, mpiPosition, id, name,
-                            data_size, client_domain, lazyLoad);
+                    readPolyInternal(data_container, mpi_position, id, name,
+                            entry.dataSizes[*iter], entry.clientDomains[*iter],
+                            stride, lazyLoad);
                     break;
                 case GridType:
                     // For Grid data, only the subchunk is read into its target position
                     // in the destination buffer.
-                    readGridInternal(dataContainer, mpiPosition, id, name,
-                            client_domain, requestDomain);
+                    readGridInternal(data_container, mpi_position, id, name,
+                            entry.clientDomains[*iter], requestDomain, stride);
                     break;
                 default:
-                    return false;
+                    break;
             }
-        } else
-        {
-            log_msg(3, "no loading from this MPI position required");
         }
 
-        return readResult;
+        if (dataClass != NULL)
+            *dataClass = entry.dataClass;
+
+        return data_container;
     }
 
-    DataContainer *DomainCollector::readDomain(int32_t id,
+    void DomainCollector::readFileBlock(Dimensions mpiPosition,
+            int32_t id,
             const char* name,
-            Domain requestDomain,
-            DomDataClass* dataClass,
-            bool lazyLoad)
+            const MultiSelection &select,
+            void* dst)
     throw (DCException)
     {
-        if ((fileStatus != FST_MERGING) && (fileStatus != FST_READING))
-            throw DCException("DomainCollector::readDomain: this access is not permitted");
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
 
-        DataContainer *data_container = new DataContainer();
-        Dimensions request_offset = requestDomain.getOffset();
+        DCGroup group;
+        group.open(handles.get(mpiPosition), group_path);
 
-        log_msg(3,
-                "requestDomain = %s ",
-                requestDomain.toString().c_str());
+        DCDataSet dataset(dset_name.c_str());
+        dataset.open(group.getHandle());
+        dataset.read(select, dst);
+        dataset.close();
+    }
 
-        DomDataClass data_class = UndefinedType;
-        Dimensions mpi_size;
+    void DomainCollector::readDomainInto(int32_t id,
+            const char* name,
+            const Domain requestDomain,
+            const Selection dstSelect,
+            Dimensions &sizeRead,
+            void* dst,
+            DomDataClass* dataClass)
+    throw (DCException)
+    {
+        if ((fileStatus != FST_MERGING) && (fileStatus != FST_READING))
+            throw DCException("DomainCollector::readDomainInto: this access is not permitted");
 
-        if (fileStatus == FST_MERGING)
-        {
-            mpi_size.set(mpiTopology);
-        } else
-            mpi_size.set(1, 1, 1);
+        if (dstSelect.stride.getScalarSize() == 0)
+            throw DCException("DomainCollector::readDomainInto: stride must not be zero");
 
-        Dimensions min_dims(0, 0, 0);
-        Dimensions max_dims(mpi_size);
-        max_dims = max_dims - Dimensions(1, 1, 1);
-
-        // try to find the lowest corner (probably the file with the
-        // domain offset == globalOffset) of the full domain
-        // for periodically moving (e.g. moving window) simulations
-        // this happens to be _not_ at mpi_pos(0,0,0)
-        {
-            Dimensions delta(0, 0, 0);
-            Dimensions belowZero(min_dims);
-            Dimensions aboveZero(max_dims);
-            Domain minDom;
-            Domain globalDomain = getGlobalDomain(id, name);
-            do
-            {
-                log_msg(4, "find zero: belowZero = %s, aboveZero = %s",
-                        belowZero.toString().c_str(),
-                        aboveZero.toString().c_str());
+        sizeRead.set(0, 0, 0);
 
-                Domain maxDom;
-                readDomainInfoForRank(belowZero, id, name,
-                        Domain(Dimensions(0, 0, 0), Dimensions(0, 0, 0)), minDom);
-                readDomainInfoForRank(aboveZero, id, name,
-                        Domain(Dimensions(0, 0, 0), Dimensions(0, 0, 0)), maxDom);
+        // zero request sizes will not intersect with anything
+        if (requestDomain.getSize().getScalarSize() == 0)
+            return;
 
-                log_msg(4, "find zero: minDom.getOffset() = %s, maxDom.getOffset() = %s",
-                        minDom.getOffset().toString().c_str(),
-                        maxDom.getOffset().toString().c_str());
+        DomainIndexEntry &entry = getDomainIndex(id, name);
 
-                for (size_t i = 0; i < DSP_DIM_MAX; ++i)
-                {
-                    // zero still between min and max?
-                    if (minDom.getOffset()[i] > maxDom.getOffset()[i])
-                    {
-                        delta[i] = ceil(((double) aboveZero[i] - (double) belowZero[i]) / 2.0);
-                        belowZero[i] += delta[i];
-                    }                        // found zero point for this i
-                    else if (minDom.getOffset()[i] == globalDomain.getOffset()[i])
-                        delta[i] = 0;
-                        // jumped over the zero position during last +-=delta[i]
-                    else
-                    {
-                        belowZero[i] -= delta[i];
-                        aboveZero[i] -= delta[i];
-                    }
-                }
+        if (dataClass != NULL)
+            *dataClass = entry.dataClass;
 
-            } while (delta != Dimensions(0, 0, 0));
+        std::vector<size_t> files;
+        entry.index.query(requestDomain, files);
+        sortByDomainOffset(files, entry.clientDomains);
 
-            // search above or below zero point?
-            //
-            // the file with the largest mpi position, but not necessarily
-            // the one with the largest local domain offset
-            Domain lastDom;
-            readDomainInfoForRank(mpi_size - Dimensions(1, 1, 1), id, name,
-                    Domain(Dimensions(0, 0, 0), Dimensions(0, 0, 0)), lastDom);
-            for (size_t i = 0; i < DSP_DIM_MAX; ++i)
-            {
-                if (request_offset[i] <= lastDom.getBack()[i])
-                {
-                    min_dims[i] = belowZero[i];
-                    max_dims[i] = mpi_size[i] - 1;
-                } else
-                {
-                    min_dims[i] = 0;
-                    belowZero[i] > 1 ? max_dims[i] = belowZero[i] - 1
-                            : max_dims[i] = 0;
-                }
-            }
-        }
+        // planning: size of the result from the domain index only
+        if (entry.dataClass == GridType)
+        {
+            if (!files.empty())
+                sizeRead.set(requestDomain.getSize());
+        } else if (entry.dataClass == PolyType)
+        {
+            uint64_t num_elements = 0;
+            for (std::vector<size_t>::const_iterator iter = files.begin();
+                    iter != files.end(); ++iter)
+                num_elements += entry.dataSizes[*iter].getScalarSize();
+
+            if (num_elements > 0)
+                sizeRead.set(num_elements, 1, 1);
+        } else
+            throw DCException("DomainCollector::readDomainInto: data class not supported");
 
-        Dimensions current_mpi_pos(min_dims);
-        Dimensions point_dim(1, 1, 1);
+        if (dst == NULL || sizeRead.getScalarSize() == 0)
+            return;
 
-        // try to find top-left corner of requested domain
-        // stop if no new file can be tested for the requested domain
-        // (current_mpi_pos does not change anymore)
-        Dimensions last_mpi_pos(current_mpi_pos);
-        bool found_start = false;
-        do
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
         {
-            log_msg(4, "find top-left: min_dims = %s, max_dims = %s",
-                    min_dims.toString().c_str(),
-                    max_dims.toString().c_str());
+            if (dstSelect.offset[i] + (sizeRead[i] - 1) * dstSelect.stride[i] >=
+                    dstSelect.size[i])
+                throw DCException("DomainCollector::readDomainInto: destination buffer is too small");
+        }
 
-            Domain file_domain;
-            last_mpi_pos = current_mpi_pos;
+        uint64_t poly_offset = 0;
+        for (std::vector<size_t>::const_iterator iter = files.begin();
+                iter != files.end(); ++iter)
+        {
+            const Dimensions &mpi_position = entry.mpiPositions[*iter];
+            MultiSelection select(dstSelect.size);
 
-            // set current_mpi_pos to be the 'center' between min_dims and max_dims
-            for (size_t i = 0; i < DSP_DIM_MAX; ++i)
+            if (entry.dataClass == GridType)
             {
-                current_mpi_pos[i] = min_dims[i] +
-                        ceil(((double) max_dims[i] - (double) min_dims[i]) / 2.0);
-            }
+                Dimensions dst_offset, src_size, src_offset;
+                getGridIntersection(entry.clientDomains[*iter], requestDomain,
+                        DSP_DIM_MAX, dst_offset, src_size, src_offset);
 
-            if (readDomainInfoForRank(current_mpi_pos, id, name,
-                    Domain(request_offset, point_dim), file_domain))
+                select.add(src_size, dstSelect.offset + dst_offset * dstSelect.stride,
+                        src_offset, dstSelect.stride);
+            } else
             {
-                found_start = true;
-                break;
-            }
+                const Dimensions &data_size = entry.dataSizes[*iter];
+                if (data_size.getScalarSize() == 0)
+                    continue;
 
-            for (size_t i = 0; i < DSP_DIM_MAX; ++i)
-            {
-                if (request_offset[i] >= file_domain.getOffset()[i])
-                    min_dims[i] = current_mpi_pos[i];
+                Dimensions dst_offset(dstSelect.offset);
+                dst_offset[0] += poly_offset * dstSelect.stride[0];
 
-                if (request_offset[i] < file_domain.getOffset()[i])
-                    max_dims[i] = current_mpi_pos[i] - 1;
+                select.add(Dimensions(data_size.getScalarSize(), 1, 1), dst_offset,
+                        Dimensions(0, 0, 0), dstSelect.stride);
+                poly_offset += data_size.getScalarSize();
             }
-        } while (last_mpi_pos != current_mpi_pos);
 
-        if (!found_start)
+            log_msg(3, "reading from mpi_position %s into %s",
+                    mpi_position.toString().c_str(), select.toString().c_str());
+            readFileBlock(mpi_position, id, name, select, dst);
+        }
+    }
+
+    Dimensions DomainCollector::getTileSize(const Dimensions &size,
+            const Dimensions &chunkSize,
+            size_t typeSize,
+            size_t maxTileBytes)
+    {
+        Dimensions tile_size(size);
+
+        for (int32_t i = DSP_DIM_MAX - 1; i >= 0; --i)
         {
-            log_msg(2, "readDomain: no data found");
-            return data_container;
+            if (tile_size.getScalarSize() * typeSize <= maxTileBytes)
+                break;
+
+            // bytes of one layer of the tile in dimension i
+            const hsize_t layer_bytes = tile_size.getScalarSize() / tile_size[i] * typeSize;
+            hsize_t layers = std::max(maxTileBytes / layer_bytes, (hsize_t) 1);
+
+            if (chunkSize[i] > 0 && layers >= chunkSize[i])
+                layers -= layers % chunkSize[i];
+
+            tile_size[i] = std::min(layers, tile_size[i]);
         }
 
-        // found top-left corner of requested domain
-        // In every file, domain attributes are read and evaluated.
-        // If the file domain and the requested domain intersect,
-        // the file domain is added to the DataContainer.
+        return tile_size;
+    }
+
+    size_t DomainCollector::readDomainTiled(int32_t id,
+            const char* name,
+            const Domain requestDomain,
+            size_t maxTileBytes,
+            DomainTileHandler &handler,
+            DomDataClass* dataClass)
+    throw (DCException)
+    {
+        if ((fileStatus != FST_MERGING) && (fileStatus != FST_READING))
+            throw DCException("DomainCollector::readDomainTiled: this access is not permitted");
+
+        // zero request sizes will not intersect with anything
+        if (requestDomain.getSize().getScalarSize() == 0)
+            return 0;
+
+        DomainIndexEntry &entry = getDomainIndex(id, name);
+
+        if (dataClass != NULL)
+            *dataClass = entry.dataClass;
+
+        if (entry.dataClass != GridType && entry.dataClass != PolyType)
+            throw DCException("DomainCollector::readDomainTiled: data class not supported");
 
-        // set new min_dims to top-left corner
-        for (size_t i = 0; i < DSP_DIM_MAX; ++i)
-            max_dims[i] = (current_mpi_pos[i] + mpi_size[i] - 1) % mpi_size[i];
-        min_dims = current_mpi_pos;
+        std::vector<size_t> files;
+        entry.index.query(requestDomain, files);
+        sortByDomainOffset(files, entry.clientDomains);
 
-        log_msg(3, "readDomain: Looking for matching domain data in range "
-                "min_dims = %s "
-                "max_dims = %s",
-                min_dims.toString().c_str(),
-                max_dims.toString().c_str());
+        // buffers of equally sized tiles are reused
+        AlignedAllocator aligned_allocator;
+        PoolAllocator tile_allocator(allocator ? *allocator : aligned_allocator,
+                maxTileBytes);
 
-        bool found_last_entry = false;
-        // ..._lin indexes can range >= mpi_size since they are helper to
-        // calculate the next index (x,y,z) in the periodic modulo system
-        size_t z, z_lin = min_dims[2];
-        do
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        size_t num_tiles = 0;
+        for (std::vector<size_t>::const_iterator iter = files.begin();
+                iter != files.end(); ++iter)
         {
-            z = z_lin % mpi_size[2];
-            size_t y, y_lin = min_dims[1];
-            do
+            const Dimensions &mpi_position = entry.mpiPositions[*iter];
+            const Domain &client_domain = entry.clientDomains[*iter];
+
+            // block of the file to read, in file coordinates
+            Dimensions block_size(entry.dataSizes[*iter]);
+            Dimensions block_offset(0, 0, 0);
+            if (entry.dataClass == GridType)
             {
-                y = y_lin % mpi_size[1];
-                size_t x, x_lin = min_dims[0];
-                do
-                {
-                    x = x_lin % mpi_size[0];
-                    Dimensions mpi_position(x, y, z);
-
-                    if (!readDomainDataForRank(data_container,
-                            &data_class,
-                            mpi_position,
-                            id,
-                            name,
-                            requestDomain,
-                            lazyLoad))
+                Dimensions dst_offset;
+                getGridIntersection(client_domain, requestDomain, DSP_DIM_MAX,
+                        dst_offset, block_size, block_offset);
+            }
+
+            if (block_size.getScalarSize() == 0)
+                continue;
+
+            DCGroup group;
+            group.open(handles.get(mpi_position), group_path);
+
+            DCDataSet dataset(dset_name.c_str());
+            dataset.open(group.getHandle());
+
+            const size_t type_size = dataset.getDataTypeSize();
+            const DCDataType type = dataset.getDCDataType();
+            if (type_size > maxTileBytes)
+                throw DCException("DomainCollector::readDomainTiled: memory budget is smaller than one element");
+
+            Dimensions chunk_size(0, 0, 0);
+            if (!dataset.getChunkSize(chunk_size))
+                chunk_size.set(0, 0, 0);
+
+            const Dimensions tile_size = getTileSize(block_size, chunk_size,
+                    type_size, maxTileBytes);
+            const Dimensions block_end(block_offset + block_size);
+
+            log_msg(3, "reading mpi_position %s in tiles of %s",
+                    mpi_position.toString().c_str(), tile_size.toString().c_str());
+
+            // tiles start at multiples of the tile size in the file
+            Dimensions tile_end;
+            Dimensions tile_offset;
+            for (tile_offset[2] = block_offset[2]; tile_offset[2] < block_end[2];
+                    tile_offset[2] = tile_end[2])
+                for (tile_offset[1] = block_offset[1]; tile_offset[1] < block_end[1];
+                        tile_offset[1] = tile_end[1])
+                    for (tile_offset[0] = block_offset[0]; tile_offset[0] < block_end[0];
+                            tile_offset[0] = tile_end[0])
                     {
-                        // readDomainDataForRank returns false if no intersection
-                        // has been found.
-                        // Cut max_dims in the currently extending dimension if
-                        // nothing can be found there, anymore.
-                        if (z == min_dims[2])
-                        {
-                            if (y == min_dims[1])
-                            {
-                                max_dims[0] = (x + mpi_size[0] - 1) % mpi_size[0];
-                                x = max_dims[0];
-                            } else
-                            {
-                                max_dims[1] = (y + mpi_size[1] - 1) % mpi_size[1];
-                                y = max_dims[1];
-                            }
-                        } else
+                        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
                         {
-                            found_last_entry = true;
-                            break;
+                            if (tile_size[i] >= block_size[i])
+                                tile_end[i] = block_end[i];
+                            else
+                                tile_end[i] = std::min(block_end[i],
+                                    (tile_offset[i] / tile_size[i] + 1) * tile_size[i]);
                         }
-                    }
-
-                    x_lin++;
-                } while (x != max_dims[0]);
 
-                if (found_last_entry)
-                    break;
+                        const Dimensions tile_elements(tile_end - tile_offset);
+                        Domain tile_domain(client_domain);
+                        if (entry.dataClass == GridType)
+                            tile_domain = Domain(client_domain.getOffset() + tile_offset,
+                                tile_elements);
 
-                y_lin++;
-            } while (y != max_dims[1]);
+                        DomainData tile(tile_domain, tile_elements, type_size, type,
+                                &tile_allocator);
 
-            if (found_last_entry)
-                break;
+                        MultiSelection select(tile_elements);
+                        select.add(tile_elements, Dimensions(0, 0, 0), tile_offset);
+                        dataset.read(select, tile.getData());
 
-            z_lin++;
-        } while (z != max_dims[2]);
+                        handler.processTile(tile);
+                        num_tiles++;
+                    }
 
-        if (dataClass != NULL)
-            *dataClass = data_class;
+            dataset.close();
+        }
 
-        return data_container;
+        return num_tiles;
     }
 
     void DomainCollector::readDomainLazy(DomainData *domainData)
@@ -699,6 +1628,9 @@ namespace splash
 
         if (loadingRef->dataClass == PolyType)
         {
+            // subdomains loaded on demand have no buffer yet
+            domainData->allocateData();
+
             Dimensions elements_read;
             uint32_t src_dims = 0;
             readDataSet(loadingRef->handle,
@@ -722,6 +1654,111 @@ namespace splash
         }
     }
 
+    void DomainCollector::readLazyElements(DomainData *domainData,
+            size_t first, size_t count, void *dst)
+    throw (DCException)
+    {
+        DomainH5Ref *loadingRef = domainData->getLoadingReference();
+        if (loadingRef == NULL || loadingRef->dataClass != PolyType)
+            throw DCException("DomainCollector::readLazyElements: DomainData does not allow loading on demand");
+
+        const Dimensions size(count, 1, 1);
+        Dimensions elements_read;
+        uint32_t src_dims = 0;
+        readDataSet(loadingRef->handle,
+                loadingRef->id,
+                loadingRef->name.c_str(),
+                size,
+                Dimensions(0, 0, 0),
+                size,
+                Dimensions(loadingRef->srcOffset[0] + first, 0, 0),
+                elements_read,
+                src_dims,
+                dst);
+
+        if (!(elements_read == size))
+            throw DCException("DomainCollector::readLazyElements: Sizes are not equal but should be (1).");
+    }
+
+    size_t DomainCollector::getLazyPageElements(size_t typeSize)
+    {
+        return std::max(lazyPageSize / typeSize, (size_t) 1);
+    }
+
+    const uint8_t* DomainCollector::loadLazyPage(DomainData *domainData,
+            size_t page)
+    throw (DCException)
+    {
+        DomainH5Ref *loadingRef = domainData->getLoadingReference();
+        const size_t type_size = domainData->getTypeSize();
+        const size_t num_elements = domainData->getElements().getScalarSize();
+
+        const size_t page_elements = getLazyPageElements(type_size);
+        const size_t first = page * page_elements;
+        const size_t count = std::min(page_elements, num_elements - first);
+
+        // file handles are unique while the files are open
+        std::stringstream key;
+        key << loadingRef->handle << "/" << loadingRef->id << "/" << loadingRef->name;
+        const Dimensions origin(first, 0, 0);
+
+        const std::vector<uint8_t> *cached = lazyPageCache.find(key.str(), origin);
+        if (cached != NULL)
+            return &((*cached)[0]);
+
+        std::vector<uint8_t> buffer(count * type_size);
+        readLazyElements(domainData, first, count, &(buffer[0]));
+
+        lazyPageCache.insert(key.str(), origin, buffer);
+        cached = lazyPageCache.find(key.str(), origin);
+        if (cached != NULL)
+            return &((*cached)[0]);
+
+        // page is larger than the cache
+        lazyPage.swap(buffer);
+        return &(lazyPage[0]);
+    }
+
+    void* DomainCollector::loadElement(DomainData *domainData, size_t index)
+    throw (DCException)
+    {
+        const size_t type_size = domainData->getTypeSize();
+        const size_t page_elements = getLazyPageElements(type_size);
+
+        const uint8_t *page = loadLazyPage(domainData, index / page_elements);
+        return (void*) (page + (index % page_elements) * type_size);
+    }
+
+    void DomainCollector::loadElements(DomainData *domainData,
+            size_t first, size_t count, void *dst)
+    throw (DCException)
+    {
+        const size_t type_size = domainData->getTypeSize();
+        const size_t page_elements = getLazyPageElements(type_size);
+
+        // large ranges are read directly without polluting the cache
+        if (count >= page_elements)
+        {
+            readLazyElements(domainData, first, count, dst);
+            return;
+        }
+
+        uint8_t *dst_ptr = (uint8_t*) dst;
+        while (count > 0)
+        {
+            const size_t page = first / page_elements;
+            const uint8_t *page_data = loadLazyPage(domainData, page);
+
+            const size_t page_offset = first - page * page_elements;
+            const size_t copy_count = std::min(count, page_elements - page_offset);
+            memcpy(dst_ptr, page_data + page_offset * type_size, copy_count * type_size);
+
+            dst_ptr += copy_count * type_size;
+            first += copy_count;
+            count -= copy_count;
+        }
+    }
+
     void DomainCollector::writeDomain(int32_t id,
             const CollectionType& type,
             uint32_t ndims,
@@ -790,6 +1827,14 @@ namespace splash
             Dimensions *mpiPosition)
     throw (DCException)
     {
+        DomainAttribute attribute;
+        if (readPackedDomainAttribute(id, dataName, mpiPosition, attribute))
+        {
+            for (int i = 0; i < DSP_DIM_MAX; ++i)
+                data[i] = attribute.globalDomain.getSize()[i];
+            return;
+        }
+
         try
         {
             readAttributeInfo(id, dataName, DOMCOL_ATTR_GLOBAL_SIZE, mpiPosition).read(data, sizeof(*data) * DSP_DIM_MAX);
@@ -809,6 +1854,14 @@ namespace splash
             Dimensions *mpiPosition)
     throw (DCException)
     {
+        DomainAttribute attribute;
+        if (readPackedDomainAttribute(id, dataName, mpiPosition, attribute))
+        {
+            for (int i = 0; i < DSP_DIM_MAX; ++i)
+                data[i] = attribute.globalDomain.getOffset()[i];
+            return;
+        }
+
         try
         {
             readAttributeInfo(id, dataName, DOMCOL_ATTR_GLOBAL_OFFSET, mpiPosition).read(data, sizeof(*data) * DSP_DIM_MAX);
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "splash/core/DomainIndex.hpp"
+
+namespace splash
+{
+
+    // maximum number of domains in a leaf
+    static const size_t LEAF_SIZE = 4;
+
+    /**
+     * Orders domain positions by the offset of their domains in one dimension.
+     */
+    class LowerInDim
+    {
+    public:
+
+        LowerInDim(const std::vector<Dimensions> &lows_, uint32_t dim_) :
+        lows(lows_),
+        dim(dim_)
+        {
+        }
+
+        bool operator()(size_t a, size_t b) const
+        {
+            return lows[a][dim] < lows[b][dim];
+        }
+
+    private:
+        const std::vector<Dimensions> &lows;
+        uint32_t dim;
+    };
+
+    DomainIndex::DomainIndex()
+    {
+    }
+
+    void DomainIndex::build(const std::vector<Domain> &domains)
+    {
+        clear();
+
+        if (domains.empty())
+            return;
+
+        for (size_t i = 0; i < domains.size(); ++i)
+        {
+            items.push_back(i);
+            lows.push_back(domains[i].getOffset());
+            highs.push_back(domains[i].getBack());
+        }
+
+        buildNode(0, items.size());
+    }
+
+    size_t DomainIndex::buildNode(size_t begin, size_t end)
+    {
+        const size_t index = nodes.size();
+        nodes.push_back(Node());
+
+        Dimensions low(lows[items[begin]]);
+        Dimensions high(highs[items[begin]]);
+        Dimensions min_offset(low);
+        Dimensions max_offset(low);
+
+        for (size_t i = begin + 1; i < end; ++i)
+        {
+            for (uint32_t d = 0; d < DSP_DIM_MAX; ++d)
+            {
+                low[d] = std::min(low[d], lows[items[i]][d]);
+                high[d] = std::max(high[d], highs[items[i]][d]);
+                min_offset[d] = std::min(min_offset[d], lows[items[i]][d]);
+                max_offset[d] = std::max(max_offset[d], lows[items[i]][d]);
+            }
+        }
+
+        size_t left = 0, right = 0;
+        if (end - begin > LEAF_SIZE)
+        {
+            // split at the median offset of the dimension with the largest spread
+            uint32_t dim = 0;
+            for (uint32_t d = 1; d < DSP_DIM_MAX; ++d)
+            {
+                if (max_offset[d] - min_offset[d] > max_offset[dim] - min_offset[dim])
+                    dim = d;
+            }
+
+            const size_t middle = begin + (end - begin) / 2;
+            std::nth_element(items.begin() + begin, items.begin() + middle,
+                    items.begin() + end, LowerInDim(lows, dim));
+
+            left = buildNode(begin, middle);
+            right = buildNode(middle, end);
+        }
+
+        // nodes may have been reallocated by the recursion
+        Node &node = nodes[index];
+        node.low = low;
+        node.high = high;
+        node.begin = begin;
+        node.end = end;
+        node.left = left;
+        node.right = right;
+
+        return index;
+    }
+
+    void DomainIndex::query(const Domain &domain, std::vector<size_t> &result) const
+    {
+        result.clear();
+
+        if (nodes.empty())
+            return;
+
+        const Dimensions low(domain.getOffset());
+        const Dimensions high(domain.getBack());
+
+        std::vector<size_t> stack;
+        stack.push_back(0);
+
+        while (!stack.empty())
+        {
+            const Node &node = nodes[stack.back()];
+            stack.pop_back();
+
+            if (!intersects(node.low, node.high, low, high))
+                continue;
+
+            if (node.left == 0)
+            {
+                for (size_t i = node.begin; i < node.end; ++i)
+                {
+                    if (intersects(lows[items[i]], highs[items[i]], low, high))
+                        result.push_back(items[i]);
+                }
+            } else
+            {
+                stack.push_back(node.right);
+                stack.push_back(node.left);
+            }
+        }
+
+        std::sort(result.begin(), result.end());
+    }
+
+    size_t DomainIndex::getSize() const
+    {
+        return lows.size();
+    }
+
+    void DomainIndex::clear()
+    {
+        nodes.clear();
+        items.clear();
+        lows.clear();
+        highs.clear();
+    }
+
+    bool DomainIndex::intersects(const Dimensions &low1, const Dimensions &high1,
+            const Dimensions &low2, const Dimensions &high2)
+    {
+        for (uint32_t d = 0; d < DSP_DIM_MAX; ++d)
+        {
+            if (low1[d] > high2[d] || high1[d] < low2[d])
+                return false;
+        }
+
+        return true;
+    }
+
+}
@@ -0,0 +1,237 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "splash/core/GridReadPool.hpp"
+#include "splash/core/logging.hpp"
+
+namespace splash
+{
+
+    GridReadPool::GridReadPool(void *dst, const Dimensions dstSize, size_t typeSize) :
+    dst((uint8_t*) dst),
+    dstSize(dstSize),
+    typeSize(typeSize),
+    closed(false)
+    {
+        pthread_mutex_init(&mutex, NULL);
+        pthread_cond_init(&cond, NULL);
+    }
+
+    GridReadPool::~GridReadPool()
+    {
+        stop();
+
+        pthread_cond_destroy(&cond);
+        pthread_mutex_destroy(&mutex);
+    }
+
+    void GridReadPool::start(uint32_t numThreads)
+    throw (DCException)
+    {
+        for (uint32_t i = 0; i < numThreads; ++i)
+        {
+            pthread_t thread;
+            if (pthread_create(&thread, NULL, run, this) != 0)
+            {
+                // remaining workers still process all jobs
+                if (threads.empty())
+                    throw DCException("Exception for GridReadPool::start: "
+                        "failed to create worker thread");
+                break;
+            }
+
+            threads.push_back(thread);
+        }
+
+        log_msg(3, "started %llu grid read workers",
+                (long long unsigned) threads.size());
+    }
+
+    void GridReadPool::add(const Job &job)
+    {
+        pthread_mutex_lock(&mutex);
+        jobs.push_back(job);
+        pthread_cond_signal(&cond);
+        pthread_mutex_unlock(&mutex);
+    }
+
+    void GridReadPool::finish()
+    throw (DCException)
+    {
+        stop();
+
+        if (!error.empty())
+            throw DCException(std::string("Exception for GridReadPool::finish: ") + error);
+    }
+
+    void GridReadPool::stop()
+    {
+        pthread_mutex_lock(&mutex);
+        closed = true;
+        pthread_cond_broadcast(&cond);
+        pthread_mutex_unlock(&mutex);
+
+        for (std::vector<pthread_t>::const_iterator iter = threads.begin();
+                iter != threads.end(); ++iter)
+            pthread_join(*iter, NULL);
+
+        threads.clear();
+    }
+
+    bool GridReadPool::next(Job &job)
+    {
+        pthread_mutex_lock(&mutex);
+        while (jobs.empty() && !closed)
+            pthread_cond_wait(&cond, &mutex);
+
+        const bool found = !jobs.empty();
+        if (found)
+        {
+            job = jobs.front();
+            jobs.pop_front();
+        }
+
+        pthread_mutex_unlock(&mutex);
+        return found;
+    }
+
+    void *GridReadPool::run(void *pool)
+    {
+        GridReadPool *self = (GridReadPool*) pool;
+
+        Job job;
+        std::vector<uint8_t> buffer;
+        while (self->next(job))
+        {
+            try
+            {
+                self->process(job, buffer);
+            } catch (const DCException &e)
+            {
+                pthread_mutex_lock(&(self->mutex));
+                if (self->error.empty())
+                    self->error = e.what();
+                pthread_mutex_unlock(&(self->mutex));
+            }
+        }
+
+        return NULL;
+    }
+
+    void GridReadPool::process(const Job &job, std::vector<uint8_t> &buffer)
+    throw (DCException)
+    {
+        int fd = open(job.filename.c_str(), O_RDONLY);
+        if (fd < 0)
+            throw DCException(std::string("failed to open ") + job.filename);
+
+        try
+        {
+            processExtents(fd, job, buffer);
+        } catch (const DCException&)
+        {
+            close(fd);
+            throw;
+        }
+
+        close(fd);
+    }
+
+    void GridReadPool::processExtents(int fd, const Job &job, std::vector<uint8_t> &buffer)
+    throw (DCException)
+    {
+        const Dimensions &extent = job.extentSize;
+        const size_t row_bytes = extent[0] * typeSize;
+
+        for (size_t e = 0; e < job.addresses.size(); ++e)
+        {
+            // intersection of the extent and the hyperslab in dataset coordinates
+            const Dimensions &origin = job.origins[e];
+            Dimensions start, end;
+            bool empty = false;
+            for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            {
+                start[i] = std::max(origin[i], job.srcOffset[i]);
+                end[i] = std::min(origin[i] + extent[i], job.srcOffset[i] + job.srcSize[i]);
+                empty = empty || (start[i] >= end[i]);
+            }
+
+            if (empty)
+                continue;
+
+            // read all required rows of one plane of the extent at once
+            const size_t num_rows = end[1] - start[1];
+            buffer.resize(num_rows * row_bytes);
+
+            for (size_t z = start[2]; z < end[2]; ++z)
+            {
+                const uint64_t row_index = (z - origin[2]) * extent[1] + start[1] - origin[1];
+                readFully(fd, job.filename, job.addresses[e] + row_index * row_bytes,
+                        &(buffer[0]), buffer.size());
+
+                for (size_t y = start[1]; y < end[1]; ++y)
+                {
+                    const uint64_t dst_index =
+                            ((job.dstOffset[2] + z - job.srcOffset[2]) * dstSize[1] +
+                            job.dstOffset[1] + y - job.srcOffset[1]) * dstSize[0] +
+                            job.dstOffset[0] + start[0] - job.srcOffset[0];
+
+                    memcpy(dst + dst_index * typeSize,
+                            &(buffer[(y - start[1]) * row_bytes + (start[0] - origin[0]) * typeSize]),
+                            (end[0] - start[0]) * typeSize);
+                }
+            }
+        }
+    }
+
+    void GridReadPool::readFully(int fd, const std::string &filename,
+            uint64_t position, uint8_t *buffer, size_t size)
+    throw (DCException)
+    {
+        while (size > 0)
+        {
+            ssize_t result = pread(fd, buffer, size, position);
+            if (result < 0 && errno == EINTR)
+                continue;
+
+            if (result <= 0)
+            {
+                std::stringstream msg;
+                msg << "failed to read " << size << " bytes at " <<
+                        position << " from " << filename;
+                throw DCException(msg.str());
+            }
+
+            buffer += result;
+            position += result;
+            size -= result;
+        }
+    }
+
+}
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "splash/core/IterationIndex.hpp"
+#include "splash/core/logging.hpp"
+
+namespace splash
+{
+
+    // magic string including format version, without terminating zero
+    static const char INDEX_MAGIC[8] = {'S', 'P', 'L', 'I', 'D', 'X', '0', '1'};
+
+    IterationIndex::IterationIndex() :
+    truncate(false)
+    {
+    }
+
+    std::string IterationIndex::getIndexFilename(const std::string baseFilename)
+    {
+        return baseFilename + std::string("_iterations.idx");
+    }
+
+    bool IterationIndex::load(const std::string filename)
+    {
+        FILE *file = fopen(filename.c_str(), "rb");
+        if (!file)
+            return false;
+
+        char magic[sizeof (INDEX_MAGIC)];
+        if (fread(magic, sizeof (magic), 1, file) != 1 ||
+                memcmp(magic, INDEX_MAGIC, sizeof (magic)) != 0)
+        {
+            log_msg(1, "ignoring invalid iteration index %s", filename.c_str());
+            fclose(file);
+            return false;
+        }
+
+        clear();
+
+        // a truncated trailing record (interrupted flush) is ignored
+        Record record;
+        while (fread(&record, sizeof (record), 1, file) == 1)
+        {
+            if (record.op == OP_ADD)
+                ids.insert(record.id);
+            else
+                ids.erase(record.id);
+        }
+
+        fclose(file);
+
+        log_msg(2, "loaded %llu iterations from %s",
+                (long long unsigned) ids.size(), filename.c_str());
+        return true;
+    }
+
+    void IterationIndex::assign(const std::set<int32_t> &ids, bool persist)
+    {
+        clear();
+        this->ids = ids;
+
+        if (persist)
+        {
+            truncate = true;
+            for (std::set<int32_t>::const_iterator iter = ids.begin();
+                    iter != ids.end(); ++iter)
+            {
+                Record record = {*iter, OP_ADD};
+                pending.push_back(record);
+            }
+        }
+    }
+
+    void IterationIndex::add(int32_t id)
+    {
+        if (ids.insert(id).second)
+        {
+            Record record = {id, OP_ADD};
+            pending.push_back(record);
+        }
+    }
+
+    void IterationIndex::flush(const std::string filename)
+    throw (DCException)
+    {
+        if (pending.empty() && !truncate)
+            return;
+
+        // create file with header if it does not exist (yet)
+        FILE *file = NULL;
+        if (!truncate)
+            file = fopen(filename.c_str(), "ab");
+
+        if (file)
+            fseek(file, 0, SEEK_END);
+
+        if (truncate || (file && ftell(file) == 0))
+        {
+            if (file)
+                fclose(file);
+
+            file = fopen(filename.c_str(), "wb");
+            if (file && fwrite(INDEX_MAGIC, sizeof (INDEX_MAGIC), 1, file) != 1)
+            {
+                fclose(file);
+                file = NULL;
+            }
+        }
+
+        if (!file)
+            throw DCException(std::string("Exception for IterationIndex::flush: "
+                "failed to open index file (") + filename + std::string(")"));
+
+        if (!pending.empty() &&
+                fwrite(&(pending[0]), sizeof (Record), pending.size(), file) != pending.size())
+        {
+            fclose(file);
+            throw DCException(std::string("Exception for IterationIndex::flush: "
+                "failed to write index file (") + filename + std::string(")"));
+        }
+
+        fclose(file);
+
+        pending.clear();
+        truncate = false;
+    }
+
+    void IterationIndex::clear()
+    {
+        ids.clear();
+        pending.clear();
+        truncate = false;
+    }
+
+    const std::set<int32_t>& IterationIndex::getIDs() const
+    {
+        return ids;
+    }
+
+    int32_t IterationIndex::getMaxID() const
+    {
+        if (ids.empty())
+            return -1;
+
+        return *(ids.rbegin());
+    }
+
+}
@@ -0,0 +1,289 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "splash/IterationReader.hpp"
+#include "splash/core/logging.hpp"
+#if defined(SPLASH_HAVE_THREADS)
+#include "splash/core/GridReadPool.hpp"
+#endif
+
+namespace splash
+{
+
+    IterationReader::IterationReader(SerialDataCollector &dc,
+            const std::vector<std::string> &names,
+            size_t maxPrefetchBytes)
+    throw (DCException) :
+    dc(dc),
+    names(names),
+    maxPrefetchBytes(maxPrefetchBytes),
+    started(false),
+    position(0),
+    numPrefetched(0)
+    {
+        size_t num_ids = 0;
+        dc.getEntryIDs(NULL, &num_ids);
+
+        ids.resize(num_ids);
+        if (num_ids > 0)
+            dc.getEntryIDs(&(ids[0]), NULL);
+
+        std::sort(ids.begin(), ids.end());
+
+        Slot empty_slot;
+        empty_slot.typeSize = 0;
+        empty_slot.planned = false;
+        empty_slot.pool = NULL;
+
+        current.resize(names.size(), empty_slot);
+        prefetched.resize(names.size(), empty_slot);
+    }
+
+    IterationReader::~IterationReader()
+    {
+        cancel(current);
+        cancel(prefetched);
+    }
+
+    bool IterationReader::next()
+    throw (DCException)
+    {
+        if (!started)
+        {
+            if (ids.empty())
+                return false;
+
+            started = true;
+            position = 0;
+            plan(prefetched, ids[0]);
+        } else
+        {
+            if (position >= ids.size())
+                return false;
+
+            position++;
+            if (position == ids.size())
+            {
+                cancel(prefetched);
+                return false;
+            }
+        }
+
+        // buffers of the previous iteration are reused for the next one
+        current.swap(prefetched);
+        complete(current, ids[position]);
+
+        if (position + 1 < ids.size())
+            plan(prefetched, ids[position + 1]);
+
+        return true;
+    }
+
+    int32_t IterationReader::getID() const
+    throw (DCException)
+    {
+        if (!started || position >= ids.size())
+            throw DCException("IterationReader::getID: no current iteration");
+
+        return ids[position];
+    }
+
+    void* IterationReader::getData(const std::string &name)
+    throw (DCException)
+    {
+        Slot &slot = current[getSlot(name)];
+        if (slot.buffer.empty())
+            return NULL;
+
+        return &(slot.buffer[0]);
+    }
+
+    Dimensions IterationReader::getSize(const std::string &name)
+    throw (DCException)
+    {
+        return current[getSlot(name)].size;
+    }
+
+    size_t IterationReader::getNumIterations() const
+    {
+        return ids.size();
+    }
+
+    size_t IterationReader::getNumPrefetched() const
+    {
+        return numPrefetched;
+    }
+
+    void IterationReader::plan(std::vector<Slot> &slots, int32_t id)
+    {
+#if defined(SPLASH_HAVE_THREADS)
+        std::vector<GridReadPool::Job> jobs(names.size());
+        std::vector<bool> raw(names.size(), false);
+        size_t total_bytes = 0;
+
+        // errors are reported when the iteration is completed
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            Slot &slot = slots[i];
+            GridReadPool::Job &job = jobs[i];
+
+            try
+            {
+                raw[i] = dc.getRawLocation(id, names[i].c_str(), job.filename,
+                        job.addresses, job.origins, job.extentSize,
+                        slot.size, slot.typeSize);
+                slot.planned = true;
+            } catch (const DCException&)
+            {
+                slot.planned = false;
+                continue;
+            }
+
+            slot.buffer.resize(slot.size.getScalarSize() * slot.typeSize);
+            total_bytes += slot.buffer.size();
+        }
+
+        if (total_bytes > maxPrefetchBytes)
+        {
+            log_msg(2, "not prefetching iteration %d (%llu bytes)",
+                    id, (long long unsigned) total_bytes);
+            return;
+        }
+
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            Slot &slot = slots[i];
+            if (!slot.planned || !raw[i] || slot.buffer.empty())
+                continue;
+
+            GridReadPool::Job &job = jobs[i];
+            job.srcSize = slot.size;
+            job.srcOffset.set(0, 0, 0);
+            job.dstOffset.set(0, 0, 0);
+
+            slot.pool = new GridReadPool(&(slot.buffer[0]), slot.size, slot.typeSize);
+            try
+            {
+                slot.pool->start(1);
+            } catch (const DCException&)
+            {
+                delete slot.pool;
+                slot.pool = NULL;
+                continue;
+            }
+
+            slot.pool->add(job);
+        }
+#else
+        // without threads support, all datasets are read in next()
+        (void) id;
+        for (size_t i = 0; i < slots.size(); ++i)
+            slots[i].planned = false;
+#endif
+    }
+
+    void IterationReader::complete(std::vector<Slot> &slots, int32_t id)
+    throw (DCException)
+    {
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            Slot &slot = slots[i];
+
+#if defined(SPLASH_HAVE_THREADS)
+            if (slot.pool)
+            {
+                GridReadPool *pool = slot.pool;
+                slot.pool = NULL;
+
+                try
+                {
+                    pool->finish();
+                    delete pool;
+                    numPrefetched++;
+                    continue;
+                } catch (const DCException &e)
+                {
+                    delete pool;
+                    log_msg(1, "background read of %s failed, reading again (%s)",
+                            names[i].c_str(), e.what());
+                }
+            }
+#endif
+
+            if (!slot.planned)
+            {
+                std::string filename;
+                std::vector<haddr_t> addresses;
+                std::vector<Dimensions> origins;
+                Dimensions extent_size;
+
+                dc.getRawLocation(id, names[i].c_str(), filename,
+                        addresses, origins, extent_size, slot.size, slot.typeSize);
+                slot.buffer.resize(slot.size.getScalarSize() * slot.typeSize);
+            }
+
+            Dimensions size_read;
+            if (!slot.buffer.empty())
+                dc.read(id, names[i].c_str(), size_read, &(slot.buffer[0]));
+        }
+    }
+
+    void IterationReader::cancel(std::vector<Slot> &slots)
+    {
+#if defined(SPLASH_HAVE_THREADS)
+        for (size_t i = 0; i < slots.size(); ++i)
+        {
+            if (slots[i].pool)
+            {
+                try
+                {
+                    slots[i].pool->finish();
+                } catch (const DCException&)
+                {
+                }
+
+                delete slots[i].pool;
+                slots[i].pool = NULL;
+            }
+        }
+#else
+        (void) slots;
+#endif
+    }
+
+    size_t IterationReader::getSlot(const std::string &name) const
+    throw (DCException)
+    {
+        if (!started || position >= ids.size())
+            throw DCException("IterationReader::getData: no current iteration");
+
+        for (size_t i = 0; i < names.size(); ++i)
+            if (names[i] == name)
+                return i;
+
+        throw DCException(std::string("IterationReader::getData: dataset ") +
+                name + std::string(" was not requested"));
+    }
+
+}
@@ -26,6 +26,8 @@
 #include <stdlib.h>
 #include <cstring>
 #include <sstream>
+#include <vector>
+#include <cstdio>
 
 #include "splash/version.hpp"
 #include "splash/ParallelDataCollector.hpp"
@@ -170,6 +172,9 @@ namespace splash
         options.mpiSize = topology.getScalarSize();
         options.mpiTopology.set(topology);
         options.maxID = -1;
+#if defined(SPLASH_INDEPENDENT_IO)
+        options.transferPolicy.mode = TransferPolicy::TRANSFER_INDEPENDENT;
+#endif
 
         setLogMpiRank(options.mpiRank);
 
@@ -210,6 +215,35 @@ namespace splash
         }
     }
 
+    void ParallelDataCollector::setTransferPolicy(const TransferPolicy &policy)
+    {
+        options.transferPolicy = policy;
+    }
+
+    const TransferPolicy& ParallelDataCollector::getTransferPolicy() const
+    {
+        return options.transferPolicy;
+    }
+
+    bool ParallelDataCollector::getTransferReport(int32_t id,
+            const char* name,
+            TransferReport &report) const
+    {
+        if (name == NULL)
+            return false;
+
+        std::stringstream key;
+        key << id << "/" << name;
+
+        std::map<std::string, TransferReport>::const_iterator iter =
+                transferReports.find(key.str());
+        if (iter == transferReports.end())
+            return false;
+
+        report = iter->second;
+        return true;
+    }
+
     void ParallelDataCollector::open(const char* filename, FileCreationAttr &attr)
     throw (DCException)
     {
@@ -222,6 +256,7 @@ namespace splash
             throw DCException(getExceptionString("open", "this access is not permitted"));
 
         this->baseFilename.assign(filename);
+        transferReports.clear();
 
         switch (attr.fileAccType)
         {
@@ -248,6 +283,9 @@ namespace splash
         // close opened hdf5 file handles
         handles.close();
 
+        if (fileStatus != FST_READING)
+            flushIterationIndex(options);
+
         options.maxID = -1;
 
         fileStatus = FST_CLOSED;
@@ -255,11 +293,9 @@ namespace splash
 
     int32_t ParallelDataCollector::getMaxID()
     {
-        std::set<int32_t> ids;
-        listFilesInDir(this->baseFilename, ids);
-
-        if (ids.size() > 0)
-            options.maxID = *(ids.rbegin());
+        // the index is kept up to date while the file set is open
+        if (options.iterationIndex.getIDs().size() > 0)
+            options.maxID = options.iterationIndex.getMaxID();
 
         return options.maxID;
     }
@@ -272,8 +308,7 @@ namespace splash
     void ParallelDataCollector::getEntryIDs(int32_t *ids, size_t *count)
     throw (DCException)
     {
-        std::set<int32_t> file_ids;
-        listFilesInDir(this->baseFilename, file_ids);
+        const std::set<int32_t> &file_ids = options.iterationIndex.getIDs();
 
         if (count != NULL)
             *count = file_ids.size();
@@ -615,6 +650,37 @@ namespace splash
                 localSize, globalOffset, sizeRead, ndims, buf);
     }
 
+    void ParallelDataCollector::read(int32_t id,
+            const char* name,
+            const MultiSelection &select,
+            void* buf) throw (DCException)
+    {
+        if (fileStatus != FST_READING && fileStatus != FST_WRITING)
+            throw DCException(getExceptionString("read", "this access is not permitted"));
+
+        if (name == NULL)
+            throw DCException(getExceptionString("read", "parameter name is NULL"));
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCParallelGroup group;
+        group.open(handles.get(id), group_path);
+
+        DCParallelDataSet dataset(dset_name.c_str());
+        dataset.open(group.getHandle());
+        dataset.setReadCollective(options.transferPolicy.mode !=
+                TransferPolicy::TRANSFER_INDEPENDENT);
+
+        dataset.read(select, buf);
+
+        TransferReport report;
+        dataset.getTransferReport(false, report);
+        dataset.close();
+
+        storeTransferReport(id, name, report);
+    }
+
      CollectionType* ParallelDataCollector::readMeta(int32_t id,
              const char* name,
              const Dimensions dstBuffer,
@@ -662,8 +728,36 @@ namespace splash
         group.openCreate(handles.get(id), group_path);
 
         // write data to the group
+        TransferReport report;
         writeDataSet(group.getHandle(), globalSize, globalOffset, type, ndims,
-                select, dset_name.c_str(), buf);
+                select, dset_name.c_str(), buf, report);
+        storeTransferReport(id, name, report);
+    }
+
+    void ParallelDataCollector::write(int32_t id, const Dimensions globalSize,
+            const CollectionType& type, uint32_t ndims,
+            const MultiSelection &select, const char* name, const void* buf)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("write", "parameter name is NULL"));
+
+        if (fileStatus == FST_CLOSED || fileStatus == FST_READING)
+            throw DCException(getExceptionString("write", "this access is not permitted"));
+
+        if (ndims < 1 || ndims > DSP_DIM_MAX)
+            throw DCException(getExceptionString("write", "maximum dimension is invalid"));
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCParallelGroup group;
+        group.openCreate(handles.get(id), group_path);
+
+        TransferReport report;
+        writeDataSet(group.getHandle(), globalSize, type, ndims,
+                select, dset_name.c_str(), buf, report);
+        storeTransferReport(id, name, report);
     }
 
     void ParallelDataCollector::reserve(int32_t id,
@@ -747,7 +841,46 @@ namespace splash
         } else
             dataset.write(Selection(size), globalOffset, buf);
 
+        TransferReport report;
+        dataset.getTransferReport(true, report);
         dataset.close();
+
+        storeTransferReport(id, name, report);
+    }
+
+    void ParallelDataCollector::append(int32_t id, const CollectionType& type,
+            size_t count, const char* name, const void* buf)
+    throw (DCException)
+    {
+        append(id, type, count, 0, 1, name, buf);
+    }
+
+    void ParallelDataCollector::append(int32_t id, const CollectionType& type,
+            size_t count, size_t offset, size_t stride, const char* name,
+            const void* buf) throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("append", "parameter name is NULL"));
+
+        if (fileStatus == FST_CLOSED || fileStatus == FST_READING)
+            throw DCException(getExceptionString("append", "this access is not permitted"));
+
+        if (stride == 0)
+            throw DCException(getExceptionString("append", "stride must be at least 1"));
+
+        size_t global_count = 0, global_offset = 0;
+        gatherMPIAppends(count, global_count, global_offset);
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCParallelGroup group;
+        group.openCreate(handles.get(id), group_path);
+
+        TransferReport report;
+        appendDataSet(group.getHandle(), type, count, offset, stride,
+                global_count, global_offset, dset_name.c_str(), buf, report);
+        storeTransferReport(id, name, report);
     }
 
     void ParallelDataCollector::remove(int32_t id)
@@ -761,10 +894,9 @@ namespace splash
         std::stringstream group_id_name;
         group_id_name << SDC_GROUP_DATA << "/" << id;
 
+        // the (now empty) iteration file stays on disk,
+        // so the iteration index keeps listing it
         DCParallelGroup::remove(handles.get(id), group_id_name.str());
-
-        // update maxID
-        getMaxID();
     }
 
     void ParallelDataCollector::remove(int32_t id, const char* name)
@@ -850,6 +982,9 @@ namespace splash
         group.close();
 
         writeHeader(handle, index, options->enableCompression, options->mpiTopology);
+
+        options->iterationIndex.add(index);
+        flushIterationIndex(*options);
     }
 
     void ParallelDataCollector::fileOpenCallback(H5Handle /*handle*/, uint32_t index, void *userData)
@@ -858,6 +993,76 @@ namespace splash
         Options *options = (Options*) userData;
 
         options->maxID = std::max(options->maxID, (int32_t) index);
+
+        // repair a stale index, persisted on next flush in write mode
+        options->iterationIndex.add(index);
+    }
+
+    void ParallelDataCollector::loadIterationIndex(bool persist, bool requireDirectory)
+    throw (DCException)
+    {
+        options.iterationIndexFilename = IterationIndex::getIndexFilename(baseFilename);
+
+        std::vector<int32_t> ids;
+        uint64_t header[2] = {0, 0};
+
+        // only one process accesses the file system, the others
+        // receive the iterations
+        if (options.mpiRank == 0)
+        {
+            if (!options.iterationIndex.load(options.iterationIndexFilename))
+            {
+                log_msg(2, "no iteration index, scanning directory");
+
+                std::set<int32_t> scanned_ids;
+                try
+                {
+                    listFilesInDir(baseFilename, scanned_ids);
+                } catch (const DCException&)
+                {
+                    header[0] = 1;
+                }
+
+                options.iterationIndex.assign(scanned_ids, persist);
+            }
+
+            ids.assign(options.iterationIndex.getIDs().begin(),
+                    options.iterationIndex.getIDs().end());
+            header[1] = ids.size();
+        }
+
+        if (MPI_Bcast(header, 2, MPI_UNSIGNED_LONG_LONG, 0, options.mpiComm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("loadIterationIndex",
+                "MPI_Bcast failed", NULL));
+
+        if (header[0] != 0 && requireDirectory)
+            throw DCException(getExceptionString("listFilesInDir",
+                "Failed to open directory", baseFilename.c_str()));
+
+        ids.resize(header[1]);
+        if (header[1] > 0 && MPI_Bcast(&(ids[0]), header[1], MPI_INT, 0,
+                options.mpiComm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("loadIterationIndex",
+                "MPI_Bcast failed", NULL));
+
+        if (options.mpiRank != 0)
+            options.iterationIndex.assign(std::set<int32_t>(ids.begin(), ids.end()), false);
+    }
+
+    void ParallelDataCollector::flushIterationIndex(Options &options)
+    {
+        if (options.mpiRank != 0)
+            return;
+
+        try
+        {
+            options.iterationIndex.flush(options.iterationIndexFilename);
+        } catch (const DCException &e)
+        {
+            // a stale index would hide iterations, fall back to directory scans
+            log_msg(1, "%s", e.what());
+            std::remove(options.iterationIndexFilename.c_str());
+        }
     }
 
     void ParallelDataCollector::writeHeader(hid_t fHandle, uint32_t id,
@@ -913,6 +1118,7 @@ namespace splash
         log_msg(1, "compression = 0");
 
         options.maxID = -1;
+        loadIterationIndex(true, false);
 
         // open file
         handles.open(Dimensions(1, 1, 1), filename, fileAccProperties, H5F_ACC_TRUNC);
@@ -923,6 +1129,7 @@ namespace splash
     {
         this->fileStatus = FST_READING;
 
+        loadIterationIndex(false, true);
         getMaxID();
 
         handles.open(Dimensions(1, 1, 1), filename, fileAccProperties, H5F_ACC_RDONLY);
@@ -933,6 +1140,7 @@ namespace splash
     {
         this->fileStatus = FST_WRITING;
 
+        loadIterationIndex(true, true);
         getMaxID();
 
         // filters are currently not supported by parallel HDF5
@@ -965,10 +1173,17 @@ namespace splash
 
         DCParallelDataSet dataset(dset_name.c_str());
         dataset.open(group.getHandle());
+        dataset.setReadCollective(options.transferPolicy.mode !=
+                TransferPolicy::TRANSFER_INDEPENDENT);
         const Dimensions src_size(dataset.getSize() - srcOffset);
 
         dataset.read(dstBuffer, dstOffset, src_size, srcOffset, sizeRead, srcRank, dst);
+
+        TransferReport report;
+        dataset.getTransferReport(false, report);
         dataset.close();
+
+        storeTransferReport(id, name, report);
     }
 
     void ParallelDataCollector::readDataSet(H5Handle h5File,
@@ -982,6 +1197,23 @@ namespace splash
             uint32_t& srcRank,
             void* dst)
     throw (DCException)
+    {
+        readDataSet(h5File, id, name, dstBuffer, dstOffset, srcSize, srcOffset,
+                Dimensions(1, 1, 1), sizeRead, srcRank, dst);
+    }
+
+    void ParallelDataCollector::readDataSet(H5Handle h5File,
+            int32_t id,
+            const char* name,
+            const Dimensions dstBuffer,
+            const Dimensions dstOffset,
+            const Dimensions srcSize,
+            const Dimensions srcOffset,
+            const Dimensions srcStride,
+            Dimensions &sizeRead,
+            uint32_t& srcRank,
+            void* dst)
+    throw (DCException)
     {
         log_msg(2, "readDataSet");
 
@@ -996,9 +1228,17 @@ namespace splash
 
         DCParallelDataSet dataset(dset_name.c_str());
         dataset.open(group.getHandle());
+        dataset.setReadCollective(options.transferPolicy.mode !=
+                TransferPolicy::TRANSFER_INDEPENDENT);
 
-        dataset.read(dstBuffer, dstOffset, srcSize, srcOffset, sizeRead, srcRank, dst);
+        dataset.read(dstBuffer, dstOffset, srcSize, srcOffset, srcStride,
+                sizeRead, srcRank, dst);
+
+        TransferReport report;
+        dataset.getTransferReport(false, report);
         dataset.close();
+
+        storeTransferReport(id, name, report);
     }
 
     CollectionType* ParallelDataCollector::readDataSetMeta(H5Handle h5File,
@@ -1059,7 +1299,8 @@ namespace splash
             uint32_t ndims,
             const Selection srcSelect,
             const char* name,
-            const void* data) throw (DCException)
+            const void* data,
+            TransferReport &report) throw (DCException)
     {
         log_msg(2, "writeDataSet");
 
@@ -1068,7 +1309,37 @@ namespace splash
         // not extensible
         dataset.create(datatype, group, globalSize, ndims,
                 this->options.enableCompression, false);
+
+        const uint64_t type_size = datatype.getSize();
+        selectWriteTransfer(dataset, srcSelect.count.getScalarSize() * type_size,
+                globalSize.getScalarSize() * type_size, dataset.hasFilters());
+
         dataset.write(srcSelect, globalOffset, data);
+        dataset.getTransferReport(true, report);
+        dataset.close();
+    }
+
+    void ParallelDataCollector::writeDataSet(H5Handle group,
+            const Dimensions globalSize,
+            const CollectionType& datatype,
+            uint32_t ndims,
+            const MultiSelection &select,
+            const char* name,
+            const void* data,
+            TransferReport &report) throw (DCException)
+    {
+        log_msg(2, "writeDataSet (%llu blocks)", (long long unsigned) select.blocks.size());
+
+        DCParallelDataSet dataset(name);
+        dataset.create(datatype, group, globalSize, ndims,
+                this->options.enableCompression, false);
+
+        const uint64_t type_size = datatype.getSize();
+        selectWriteTransfer(dataset, select.getNumElements() * type_size,
+                globalSize.getScalarSize() * type_size, dataset.hasFilters());
+
+        dataset.write(select, data);
+        dataset.getTransferReport(true, report);
         dataset.close();
     }
 
@@ -1126,6 +1397,93 @@ namespace splash
         }
     }
 
+    void ParallelDataCollector::gatherMPIAppends(size_t localCount,
+            size_t &globalCount, size_t &globalOffset)
+    throw (DCException)
+    {
+        uint64_t local_count = localCount;
+        uint64_t global_count = 0;
+        uint64_t global_offset = 0;
+
+        if (MPI_Exscan(&local_count, &global_offset, 1, MPI_UNSIGNED_LONG_LONG,
+                MPI_SUM, options.mpiComm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("gatherMPIAppends",
+                "MPI_Exscan failed", NULL));
+
+        // result of MPI_Exscan is undefined on the first rank
+        if (options.mpiRank == 0)
+            global_offset = 0;
+
+        if (MPI_Allreduce(&local_count, &global_count, 1, MPI_UNSIGNED_LONG_LONG,
+                MPI_SUM, options.mpiComm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("gatherMPIAppends",
+                "MPI_Allreduce failed", NULL));
+
+        globalCount = global_count;
+        globalOffset = global_offset;
+    }
+
+    void ParallelDataCollector::appendDataSet(H5Handle group,
+            const CollectionType& datatype,
+            size_t count,
+            size_t offset,
+            size_t stride,
+            size_t globalCount,
+            size_t globalOffset,
+            const char* name,
+            const void* data,
+            TransferReport &report)
+    throw (DCException)
+    {
+        log_msg(2, "appendDataSet");
+
+        DCParallelDataSet dataset(name);
+
+        // all processes see the same link state, checkExistence is
+        // disabled for parallel datasets
+        bool exists = (H5Lexists(group, name, H5P_LINK_ACCESS_DEFAULT) > 0);
+        if (exists)
+        {
+            dataset.open(group);
+
+            // empty datasets have a null dataspace and cannot be extended
+            if (dataset.getSize().getScalarSize() == 0)
+            {
+                dataset.close();
+                exists = false;
+            }
+        }
+
+        const uint64_t type_size = datatype.getSize();
+        if (exists)
+        {
+            if (globalCount > 0)
+            {
+                selectWriteTransfer(dataset, count * type_size,
+                        globalCount * type_size, dataset.hasFilters());
+                dataset.append(count, offset, stride, globalCount, globalOffset, data);
+            }
+        } else
+        {
+            Dimensions data_size(globalCount, 1, 1);
+            // create dataset extensible
+            dataset.create(datatype, group, data_size, 1,
+                    this->options.enableCompression, true);
+
+            selectWriteTransfer(dataset, count * type_size,
+                    globalCount * type_size, dataset.hasFilters());
+            dataset.write(Selection(Dimensions(offset + count * stride, 1, 1),
+                    Dimensions(count, 1, 1),
+                    Dimensions(offset, 0, 0),
+                    Dimensions(stride, 1, 1)),
+                    Dimensions(globalOffset, 0, 0),
+                    data);
+        }
+
+        dataset.getTransferReport(true, report);
+        dataset.close();
+    }
+
     size_t ParallelDataCollector::getNDims(H5Handle h5File,
             int32_t id, const char* name)
     {
@@ -1173,39 +1531,61 @@ namespace splash
         dataset.close();
     }
 
-    /* UNIMPLEMENTED METHODS FROM DATACOLLECTOR. TODO: Unify interface to remove those */
-    void ParallelDataCollector::readGlobalAttribute(const char*, void*, Dimensions*)
+    void ParallelDataCollector::selectWriteTransfer(DCParallelDataSet &dataset,
+            uint64_t localBytes,
+            uint64_t globalBytes,
+            bool filtered)
     throw (DCException)
     {
-        throw DCException(getExceptionString("readGlobalAttribute",
-                "feature currently not supported by Parallel HDF5"));
+        const TransferPolicy &policy = options.transferPolicy;
+        uint64_t max_local_bytes = localBytes;
+
+        // imbalance is only required for automatic selection
+        if (policy.mode == TransferPolicy::TRANSFER_AUTO && !filtered)
+        {
+            if (MPI_Allreduce(&localBytes, &max_local_bytes, 1, MPI_UNSIGNED_LONG_LONG,
+                    MPI_MAX, options.mpiComm) != MPI_SUCCESS)
+                throw DCException(getExceptionString("selectWriteTransfer",
+                    "MPI_Allreduce failed", NULL));
+        }
+
+        dataset.setWriteCollective(policy.useCollective(globalBytes,
+                max_local_bytes, options.mpiSize, filtered));
     }
 
-    void ParallelDataCollector::writeGlobalAttribute(const CollectionType& /*type*/,
-            const char* /*name*/, const void* /*data*/) throw (DCException)
+    void ParallelDataCollector::storeTransferReport(int32_t id,
+            const char* name,
+            const TransferReport &report)
     {
-        throw DCException(getExceptionString("readGlobalAttribute",
-                "feature currently not supported by Parallel HDF5"));
+        std::stringstream key;
+        key << id << "/" << name;
+        transferReports[key.str()] = report;
+
+        if (report.isCollectiveBroken())
+            log_msg(1, "collective I/O broken for %s: %s",
+                key.str().c_str(), report.toString().c_str());
+        else
+            log_msg(3, "transfer for %s: %s",
+                key.str().c_str(), report.toString().c_str());
     }
 
-    void ParallelDataCollector::writeGlobalAttribute(const CollectionType& /*type*/,
-            const char* /*name*/, uint32_t /*ndims*/, const Dimensions /*dims*/,
-            const void* /*data*/) throw (DCException)
+    /* UNIMPLEMENTED METHODS FROM DATACOLLECTOR. TODO: Unify interface to remove those */
+    void ParallelDataCollector::readGlobalAttribute(const char*, void*, Dimensions*)
+    throw (DCException)
     {
         throw DCException(getExceptionString("readGlobalAttribute",
                 "feature currently not supported by Parallel HDF5"));
     }
 
-    void ParallelDataCollector::append(int32_t /*id*/, const CollectionType& /*type*/,
-            size_t /*count*/, const char* /*name*/, const void* /*data*/)
-    throw (DCException)
+    void ParallelDataCollector::writeGlobalAttribute(const CollectionType& /*type*/,
+            const char* /*name*/, const void* /*data*/) throw (DCException)
     {
         throw DCException(getExceptionString("readGlobalAttribute",
                 "feature currently not supported by Parallel HDF5"));
     }
 
-    void ParallelDataCollector::append(int32_t /*id*/, const CollectionType& /*type*/,
-            size_t /*count*/, size_t /*offset*/, size_t /*stride*/, const char* /*name*/,
+    void ParallelDataCollector::writeGlobalAttribute(const CollectionType& /*type*/,
+            const char* /*name*/, uint32_t /*ndims*/, const Dimensions /*dims*/,
             const void* /*data*/) throw (DCException)
     {
         throw DCException(getExceptionString("readGlobalAttribute",
@@ -20,11 +20,16 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <climits>
+#include <cstring>
+#include <vector>
+
 #include "splash/basetypes/basetypes.hpp"
 
 #include "splash/ParallelDomainCollector.hpp"
 #include "splash/AttributeInfo.hpp"
 #include "splash/core/DCParallelDataSet.hpp"
+#include "splash/core/DCParallelGroup.hpp"
 #include "splash/core/logging.hpp"
 
 namespace splash
@@ -50,6 +55,17 @@ namespace splash
             const Domain localDomain,
             const Domain globalDomain)
     {
+        if (packedDomainAttributes)
+        {
+            ColTypeDomainAttribute domain_t;
+            DomainAttribute::Packed packed;
+            DomainAttribute(localDomain, globalDomain, dataClass).toPacked(packed);
+            writeAttribute(id, domain_t, name, DOMCOL_ATTR_DOMAIN, &packed);
+
+            if (!separateDomainAttributes)
+                return;
+        }
+
         ColTypeInt32 int_t;
         ColTypeDim dim_t;
         writeAttribute(id, int_t, name, DOMCOL_ATTR_CLASS, &dataClass);
@@ -59,9 +75,52 @@ namespace splash
         writeAttribute(id, dim_t, name, DOMCOL_ATTR_GLOBAL_OFFSET, globalDomain.getOffset().getPointer());
     }
 
+    bool ParallelDomainCollector::readPackedDomainAttribute(int32_t id,
+            const char *name,
+            DomainAttribute &attribute)
+    throw (DCException)
+    {
+        DomainAttribute::Packed packed;
+        try
+        {
+            readAttributeInfo(id, name, DOMCOL_ATTR_DOMAIN).read(
+                    ColTypeDomainAttribute(), &packed);
+        } catch (const DCException&)
+        {
+            // written without the packed attribute
+            return false;
+        }
+
+        attribute.fromPacked(packed);
+        return true;
+    }
+
+    void ParallelDomainCollector::readDomainAttribute(int32_t id,
+            const char *name,
+            DomainAttribute &attribute)
+    throw (DCException)
+    {
+        if (readPackedDomainAttribute(id, name, attribute))
+            return;
+
+        readAttributeInfo(id, name, DOMCOL_ATTR_SIZE).read(
+                attribute.localDomain.getSize().getPointer(), attribute.localDomain.getSize().getSize());
+        readAttributeInfo(id, name, DOMCOL_ATTR_OFFSET).read(
+                attribute.localDomain.getOffset().getPointer(), attribute.localDomain.getOffset().getSize());
+        readAttributeInfo(id, name, DOMCOL_ATTR_GLOBAL_SIZE).read(
+                attribute.globalDomain.getSize().getPointer(), attribute.globalDomain.getSize().getSize());
+        readAttributeInfo(id, name, DOMCOL_ATTR_GLOBAL_OFFSET).read(
+                attribute.globalDomain.getOffset().getPointer(), attribute.globalDomain.getOffset().getSize());
+        readAttributeInfo(id, name, DOMCOL_ATTR_CLASS).read(
+                &(attribute.dataClass), sizeof (attribute.dataClass));
+    }
+
     ParallelDomainCollector::ParallelDomainCollector(MPI_Comm comm, MPI_Info info,
             const Dimensions topology, uint32_t maxFileHandles) :
-    ParallelDataCollector(comm, info, topology, maxFileHandles)
+    ParallelDataCollector(comm, info, topology, maxFileHandles),
+    domainTableEnabled(false),
+    packedDomainAttributes(false),
+    separateDomainAttributes(true)
     {
     }
 
@@ -77,6 +136,10 @@ namespace splash
             throw DCException(getExceptionString("getGlobalDomain",
                 "this access is not permitted", NULL));
 
+        DomainAttribute attribute;
+        if (readPackedDomainAttribute(id, name, attribute))
+            return attribute.globalDomain;
+
         Domain domain;
 
         readAttributeInfo(id, name, DOMCOL_ATTR_GLOBAL_SIZE).read(domain.getSize().getPointer(), domain.getSize().getSize());
@@ -93,6 +156,10 @@ namespace splash
             throw DCException(getExceptionString("getLocalDomain",
                 "this access is not permitted", NULL));
 
+        DomainAttribute attribute;
+        if (readPackedDomainAttribute(id, name, attribute))
+            return attribute.localDomain;
+
         Domain domain;
 
         readAttributeInfo(id, name, DOMCOL_ATTR_SIZE).read(domain.getSize().getPointer(), domain.getSize().getSize());
@@ -107,21 +174,21 @@ namespace splash
             int32_t id,
             const char* name,
             const Domain requestDomain,
+            const Dimensions stride,
             bool lazyLoad)
     throw (DCException)
     {
-        Domain local_client_domain = getLocalDomain(id, name);
-        Domain global_client_domain = getGlobalDomain(id, name);
+        DomainAttribute attribute;
+        readDomainAttribute(id, name, attribute);
 
         Domain client_domain(
-                local_client_domain.getOffset() + global_client_domain.getOffset(),
-                local_client_domain.getSize());
+                attribute.localDomain.getOffset() + attribute.globalDomain.getOffset(),
+                attribute.localDomain.getSize());
 
         Dimensions data_elements;
         read(id, name, data_elements, NULL);
 
-        DomDataClass tmp_data_class = UndefinedType;
-        readAttributeInfo(id, name, DOMCOL_ATTR_CLASS).read(&tmp_data_class, sizeof(tmp_data_class));
+        DomDataClass tmp_data_class = attribute.dataClass;
 
         if (tmp_data_class == GridType && data_elements != client_domain.getSize())
             throw DCException(getExceptionString("readDomainDataForRank",
@@ -144,6 +211,14 @@ namespace splash
         if ((requestDomain.getSize().getScalarSize() > 0) && !Domain::testIntersection(requestDomain, client_domain))
             return false;
 
+        // number of elements of the strided data and request
+        Dimensions strided_elements, strided_request;
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+        {
+            strided_elements[i] = (data_elements[i] + stride[i] - 1) / stride[i];
+            strided_request[i] = (requestDomain.getSize()[i] + stride[i] - 1) / stride[i];
+        }
+
         // Poly data has no internal grid structure,
         // so the whole chunk has to be read and is added to the DataContainer.
         if (*dataClass == PolyType)
@@ -181,7 +256,7 @@ namespace splash
                 H5Gclose(group_id);
 
                 DomainData *client_data = new DomainData(client_domain,
-                        data_elements, datatype_size, dc_datatype);
+                        strided_elements, datatype_size, dc_datatype);
 
                 if (lazyLoad)
                 {
@@ -191,6 +266,23 @@ namespace splash
                             Dimensions(0, 0, 0),
                             Dimensions(0, 0, 0),
                             Dimensions(0, 0, 0));
+                } else if (strided_elements != data_elements)
+                {
+                    Dimensions elements_read;
+                    uint32_t src_rank = 0;
+                    readDataSet(handles.get(id), id, name,
+                            strided_elements,
+                            Dimensions(0, 0, 0),
+                            strided_elements,
+                            Dimensions(0, 0, 0),
+                            stride,
+                            elements_read,
+                            src_rank,
+                            client_data->getData());
+
+                    if (!(elements_read == strided_elements))
+                        throw DCException(getExceptionString("readDomainDataForRank",
+                            "Sizes are not equal but should be (1).", NULL));
                 } else
                 {
                     Dimensions elements_read;
@@ -254,7 +346,7 @@ namespace splash
                 H5Gclose(group_id);
 
                 DomainData *target_data = new DomainData(
-                        requestDomain, requestDomain.getSize(),
+                        requestDomain, strided_request,
                         datatype_size, dc_datatype);
 
                 dataContainer->add(target_data);
@@ -298,6 +390,27 @@ namespace splash
                 }
             }
 
+            // select every stride-th element of the request,
+            // starting at the first one within the intersection
+            for (uint32_t i = 0; i < ndims; ++i)
+            {
+                if (stride[i] == 1)
+                    continue;
+
+                const uint64_t start = client_start[i] + src_offset[i] - request_offset[i];
+                const uint64_t skip = (start + stride[i] - 1) / stride[i] * stride[i] - start;
+
+                if (skip >= src_size[i])
+                {
+                    src_size[i] = 0;
+                    continue;
+                }
+
+                src_offset[i] += skip;
+                src_size[i] = (src_size[i] - skip + stride[i] - 1) / stride[i];
+                dst_offset[i] = (start + skip) / stride[i];
+            }
+
             log_msg(3,
                     "client_domain.getSize() = %s\n"
                     "data_elements = %s\n"
@@ -319,10 +432,11 @@ namespace splash
             uint32_t src_rank = 0;
             {
                 readDataSet(handles.get(id), id, name,
-                        dataContainer->getIndex(0)->getSize(),
+                        dataContainer->getIndex(0)->getElements(),
                         dst_offset,
                         src_size,
                         src_offset,
+                        stride,
                         elements_read,
                         src_rank,
                         dataContainer->getIndex(0)->getData());
@@ -369,6 +483,7 @@ namespace splash
                 id,
                 name,
                 requestDomain,
+                Dimensions(1, 1, 1),
                 lazyLoad);
 
         if (dataClass != NULL)
@@ -377,6 +492,380 @@ namespace splash
         return data_container;
     }
 
+    DataContainer *ParallelDomainCollector::readDomain(int32_t id,
+            const char* name,
+            const Domain requestDomain,
+            const Dimensions stride,
+            DomDataClass* dataClass)
+    throw (DCException)
+    {
+        if (fileStatus == FST_CLOSED)
+            throw DCException(getExceptionString("readDomain",
+                "this access is not permitted", NULL));
+
+        if (stride.getScalarSize() == 0)
+            throw DCException(getExceptionString("readDomain",
+                "stride must not be zero", NULL));
+
+        DataContainer * data_container = new DataContainer();
+
+        log_msg(3, "requestDomain = %s stride = %s", requestDomain.toString().c_str(),
+                stride.toString().c_str());
+
+        DomDataClass data_class = UndefinedType;
+
+        readDomainDataForRank(data_container,
+                &data_class,
+                id,
+                name,
+                requestDomain,
+                stride,
+                false);
+
+        if (dataClass != NULL)
+            *dataClass = data_class;
+
+        return data_container;
+    }
+
+    DataContainer *ParallelDomainCollector::readDomainCollective(int32_t id,
+            const char* name,
+            const Domain requestDomain,
+            DomDataClass* dataClass)
+    throw (DCException)
+    {
+        if (fileStatus == FST_CLOSED)
+            throw DCException(getExceptionString("readDomainCollective",
+                "this access is not permitted", NULL));
+
+        // opening the file is collective, so all processes must do it
+        // before rank 0 reads the metadata
+        H5Handle h5File = handles.get(id);
+
+        // status, local offset/size, global offset/size, elements,
+        // ndims, datatype size, datatype, data class
+        const int meta_size = 1 + 5 * DSP_DIM_MAX + 4;
+        uint64_t meta[meta_size];
+        memset(meta, 0, sizeof (meta));
+
+        if (options.mpiRank == 0)
+        {
+            try
+            {
+                DomainAttribute attribute;
+                readDomainAttribute(id, name, attribute);
+                Domain local_domain = attribute.localDomain;
+                Domain global_domain = attribute.globalDomain;
+
+                DomDataClass tmp_data_class = attribute.dataClass;
+
+                std::string group_path, dset_name;
+                DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+                DCParallelGroup group;
+                group.open(h5File, group_path);
+
+                DCParallelDataSet dataset(dset_name.c_str());
+                dataset.open(group.getHandle());
+                // not read(id, name, ...) since that is a collective
+                // transfer which the other processes do not join
+                const Dimensions data_elements(dataset.getSize());
+                meta[1 + 5 * DSP_DIM_MAX] = dataset.getNDims();
+                meta[2 + 5 * DSP_DIM_MAX] = dataset.getDataTypeSize();
+                meta[3 + 5 * DSP_DIM_MAX] = dataset.getDCDataType();
+                dataset.close();
+
+                meta[4 + 5 * DSP_DIM_MAX] = tmp_data_class;
+
+                for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+                {
+                    meta[1 + i] = local_domain.getOffset()[i];
+                    meta[1 + DSP_DIM_MAX + i] = local_domain.getSize()[i];
+                    meta[1 + 2 * DSP_DIM_MAX + i] = global_domain.getOffset()[i];
+                    meta[1 + 3 * DSP_DIM_MAX + i] = global_domain.getSize()[i];
+                    meta[1 + 4 * DSP_DIM_MAX + i] = data_elements[i];
+                }
+
+                meta[0] = 1;
+            } catch (const DCException &e)
+            {
+                log_msg(0, "readDomainCollective: %s", e.what());
+            }
+        }
+
+        if (MPI_Bcast(meta, meta_size, MPI_UNSIGNED_LONG_LONG, 0,
+                options.mpiComm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("readDomainCollective",
+                "MPI_Bcast failed", NULL));
+
+        if (meta[0] == 0)
+            throw DCException(getExceptionString("readDomainCollective",
+                "failed to read domain information on rank 0", name));
+
+        Domain client_domain;
+        Dimensions data_elements;
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+        {
+            client_domain.getOffset()[i] = meta[1 + i] + meta[1 + 2 * DSP_DIM_MAX + i];
+            client_domain.getSize()[i] = meta[1 + DSP_DIM_MAX + i];
+            data_elements[i] = meta[1 + 4 * DSP_DIM_MAX + i];
+        }
+
+        const uint32_t ndims = meta[1 + 5 * DSP_DIM_MAX];
+        const size_t datatype_size = meta[2 + 5 * DSP_DIM_MAX];
+        const DCDataType dc_datatype = (DCDataType) meta[3 + 5 * DSP_DIM_MAX];
+        const DomDataClass data_class = (DomDataClass) meta[4 + 5 * DSP_DIM_MAX];
+
+        if (data_class == GridType && data_elements != client_domain.getSize())
+            throw DCException(getExceptionString("readDomainCollective",
+                "Number of data elements must match domain size for Grid data.", NULL));
+
+        if (data_class != GridType && data_class != PolyType)
+            throw DCException(getExceptionString("readDomainCollective",
+                "Invalid data class", name));
+
+        // global read plan: requests of all processes
+        std::vector<uint64_t> plan(2 * DSP_DIM_MAX * options.mpiSize);
+        uint64_t local_request[2 * DSP_DIM_MAX];
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+        {
+            local_request[i] = requestDomain.getOffset()[i];
+            local_request[DSP_DIM_MAX + i] = requestDomain.getSize()[i];
+        }
+
+        if (MPI_Allgather(local_request, 2 * DSP_DIM_MAX, MPI_UNSIGNED_LONG_LONG,
+                &(plan[0]), 2 * DSP_DIM_MAX, MPI_UNSIGNED_LONG_LONG,
+                options.mpiComm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("readDomainCollective",
+                "MPI_Allgather failed", NULL));
+
+        std::vector<bool> intersects(options.mpiSize, false);
+        uint32_t num_intersecting = 0;
+        for (int r = 0; r < options.mpiSize; ++r)
+        {
+            Domain request(
+                    Dimensions(plan[r * 2 * DSP_DIM_MAX], plan[r * 2 * DSP_DIM_MAX + 1],
+                    plan[r * 2 * DSP_DIM_MAX + 2]),
+                    Dimensions(plan[r * 2 * DSP_DIM_MAX + 3], plan[r * 2 * DSP_DIM_MAX + 4],
+                    plan[r * 2 * DSP_DIM_MAX + 5]));
+
+            if (request.getSize().getScalarSize() > 0 &&
+                    Domain::testIntersection(request, client_domain))
+            {
+                intersects[r] = true;
+                num_intersecting++;
+            }
+
+            log_msg(3, "read plan: rank %d requests %s (%s)", r,
+                    request.toString().c_str(),
+                    intersects[r] ? "intersecting" : "empty");
+        }
+
+        log_msg(2, "readDomainCollective: %u of %d processes read '%s'",
+                num_intersecting, options.mpiSize, name);
+
+        DataContainer *data_container = new DataContainer();
+
+        try
+        {
+            if (data_class == GridType)
+            {
+                readGridCollective(data_container, id, name, requestDomain,
+                        client_domain, ndims, datatype_size, dc_datatype,
+                        intersects[options.mpiRank]);
+            } else
+            {
+                readPolyCollective(data_container, id, name, client_domain,
+                        data_elements, ndims, datatype_size, dc_datatype,
+                        intersects);
+            }
+        } catch (const DCException &e)
+        {
+            delete data_container;
+            throw e;
+        }
+
+        if (dataClass != NULL)
+            *dataClass = data_class;
+
+        return data_container;
+    }
+
+    void ParallelDomainCollector::readGridCollective(
+            DataContainer *dataContainer,
+            int32_t id,
+            const char* name,
+            const Domain requestDomain,
+            const Domain clientDomain,
+            uint32_t ndims,
+            size_t datatypeSize,
+            DCDataType datatype,
+            bool intersects)
+    throw (DCException)
+    {
+        Dimensions dst_offset(0, 0, 0);
+        Dimensions src_size(0, 0, 0);
+        Dimensions src_offset(0, 0, 0);
+        Dimensions dst_buffer(1, 1, 1);
+        DomainData *target_data = NULL;
+
+        if (intersects)
+        {
+            src_size.set(1, 1, 1);
+
+            for (uint32_t i = 0; i < ndims; ++i)
+            {
+                const uint64_t start = std::max(requestDomain.getOffset()[i],
+                        clientDomain.getOffset()[i]);
+                const uint64_t end = std::min(
+                        requestDomain.getOffset()[i] + requestDomain.getSize()[i],
+                        clientDomain.getOffset()[i] + clientDomain.getSize()[i]);
+
+                dst_offset[i] = start - requestDomain.getOffset()[i];
+                src_offset[i] = start - clientDomain.getOffset()[i];
+                src_size[i] = end - start;
+            }
+
+            target_data = new DomainData(requestDomain, requestDomain.getSize(),
+                    datatypeSize, datatype);
+            dataContainer->add(target_data);
+            dst_buffer.set(requestDomain.getSize());
+        }
+
+        log_msg(3,
+                "dst_offset = %s\n"
+                "src_size = %s\n"
+                "src_offset = %s",
+                dst_offset.toString().c_str(),
+                src_size.toString().c_str(),
+                src_offset.toString().c_str());
+
+        // processes without intersection take part with an empty selection
+        Dimensions elements_read(0, 0, 0);
+        uint32_t src_rank = 0;
+        readDataSet(handles.get(id), id, name,
+                dst_buffer,
+                dst_offset,
+                src_size,
+                src_offset,
+                elements_read,
+                src_rank,
+                target_data ? target_data->getData() : NULL);
+
+        if (target_data && elements_read != src_size)
+            throw DCException(getExceptionString("readGridCollective",
+                "Sizes are not equal but should be.", NULL));
+    }
+
+    void ParallelDomainCollector::readPolyCollective(
+            DataContainer *dataContainer,
+            int32_t id,
+            const char* name,
+            const Domain clientDomain,
+            const Dimensions dataElements,
+            uint32_t ndims,
+            size_t datatypeSize,
+            DCDataType datatype,
+            const std::vector<bool> &intersects)
+    throw (DCException)
+    {
+        // split along the slowest varying dimension so that
+        // every part is contiguous in the destination buffer
+        const uint32_t split_dim = (ndims > 0) ? ndims - 1 : 0;
+        const uint64_t num_rows = dataElements[split_dim];
+        const uint64_t row_size = datatypeSize *
+                (dataElements.getScalarSize() / std::max(num_rows, (uint64_t) 1));
+
+        std::vector<int> readers;
+        int my_reader = -1;
+        for (int r = 0; r < options.mpiSize; ++r)
+        {
+            if (intersects[r])
+            {
+                if (r == options.mpiRank)
+                    my_reader = readers.size();
+                readers.push_back(r);
+            }
+        }
+
+        // MPI counts are limited to int, read everything on every
+        // reader if the parts cannot be exchanged in a single call
+        const bool redistribute = (readers.size() > 1) &&
+                (num_rows <= (uint64_t) INT_MAX) && (row_size <= (uint64_t) INT_MAX);
+
+        DomainData *client_data = NULL;
+        Dimensions dst_offset(0, 0, 0);
+        Dimensions src_size(0, 0, 0);
+        Dimensions dst_buffer(1, 1, 1);
+
+        std::vector<int> counts(readers.size(), 0);
+        std::vector<int> displs(readers.size(), 0);
+
+        if (my_reader >= 0 && dataElements.getScalarSize() > 0)
+        {
+            client_data = new DomainData(clientDomain, dataElements,
+                    datatypeSize, datatype);
+            dataContainer->add(client_data);
+
+            dst_buffer.set(dataElements);
+            src_size.set(dataElements);
+
+            if (redistribute)
+            {
+                for (size_t k = 0; k < readers.size(); ++k)
+                {
+                    displs[k] = (num_rows * k) / readers.size();
+                    counts[k] = (num_rows * (k + 1)) / readers.size() - displs[k];
+                }
+
+                dst_offset[split_dim] = displs[my_reader];
+                src_size[split_dim] = counts[my_reader];
+            }
+        }
+
+        Dimensions elements_read(0, 0, 0);
+        uint32_t src_rank = 0;
+        readDataSet(handles.get(id), id, name,
+                dst_buffer,
+                dst_offset,
+                src_size,
+                dst_offset,
+                elements_read,
+                src_rank,
+                client_data ? client_data->getData() : NULL);
+
+        if (client_data && elements_read != src_size)
+            throw DCException(getExceptionString("readPolyCollective",
+                "Sizes are not equal but should be.", NULL));
+
+        if (!redistribute || dataElements.getScalarSize() == 0)
+            return;
+
+        MPI_Comm reader_comm = MPI_COMM_NULL;
+        if (MPI_Comm_split(options.mpiComm, client_data ? 0 : MPI_UNDEFINED,
+                options.mpiRank, &reader_comm) != MPI_SUCCESS)
+            throw DCException(getExceptionString("readPolyCollective",
+                "MPI_Comm_split failed", NULL));
+
+        if (reader_comm == MPI_COMM_NULL)
+            return;
+
+        MPI_Datatype row_type;
+        MPI_Type_contiguous(row_size, MPI_BYTE, &row_type);
+        MPI_Type_commit(&row_type);
+
+        int result = MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL,
+                client_data->getData(), &(counts[0]), &(displs[0]), row_type,
+                reader_comm);
+
+        MPI_Type_free(&row_type);
+        MPI_Comm_free(&reader_comm);
+
+        if (result != MPI_SUCCESS)
+            throw DCException(getExceptionString("readPolyCollective",
+                "MPI_Allgatherv failed", NULL));
+    }
+
     void ParallelDomainCollector::readDomainLazy(DomainData *domainData)
     throw (DCException)
     {
@@ -426,12 +915,99 @@ namespace splash
         }
     }
 
+    void ParallelDomainCollector::setDomainTableEnabled(bool enabled)
+    {
+        domainTableEnabled = enabled;
+    }
+
+    void ParallelDomainCollector::setPackedDomainAttributes(bool enabled, bool writeSeparate)
+    {
+        packedDomainAttributes = enabled;
+        separateDomainAttributes = writeSeparate;
+    }
+
+    void ParallelDomainCollector::appendDomainTableRow(int32_t id,
+            const char* name,
+            const DomainTableEntry &entry,
+            bool replace)
+    throw (DCException)
+    {
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_HEADER "/" DOMCOL_GROUP_TABLE,
+                id, group_path, dset_name);
+
+        DCParallelGroup group;
+        group.openCreate(handles.get(id), group_path);
+
+        if (replace && DCParallelGroup::exists(group.getHandle(), dset_name))
+            DCParallelGroup::remove(group.getHandle(), dset_name);
+
+        uint64_t row[DomainTableEntry::NUM_COLUMNS];
+        entry.toRow(row);
+
+        // rows follow the MPI rank order
+        const size_t row_size = DomainTableEntry::NUM_COLUMNS;
+        ColTypeUInt64 uint64_type;
+        TransferReport report;
+        appendDataSet(group.getHandle(), uint64_type, row_size, 0, 1,
+                row_size * options.mpiSize, row_size * options.mpiRank,
+                dset_name.c_str(), row, report);
+    }
+
+    bool ParallelDomainCollector::readDomainTable(int32_t id,
+            const char* name,
+            std::vector<DomainTableEntry> &entries)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("readDomainTable",
+                "parameter name is NULL", NULL));
+
+        if (fileStatus == FST_CLOSED)
+            throw DCException(getExceptionString("readDomainTable",
+                "this access is not permitted", NULL));
+
+        entries.clear();
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_HEADER "/" DOMCOL_GROUP_TABLE,
+                id, group_path, dset_name);
+
+        H5Handle h5File = handles.get(id);
+        if (!DCParallelGroup::exists(h5File, group_path + std::string("/") + dset_name))
+            return false;
+
+        DCParallelGroup group;
+        group.open(h5File, group_path);
+
+        DCParallelDataSet dataset(dset_name);
+        dataset.open(group.getHandle());
+
+        const Dimensions size = dataset.getSize();
+        if (size.getScalarSize() % DomainTableEntry::NUM_COLUMNS != 0)
+            throw DCException(getExceptionString("readDomainTable",
+                "invalid domain table", name));
+
+        std::vector<uint64_t> rows(size.getScalarSize());
+        Dimensions size_read;
+        uint32_t src_ndims = 0;
+        dataset.read(size, Dimensions(0, 0, 0), size_read, src_ndims,
+                rows.empty() ? NULL : &(rows[0]));
+        dataset.close();
+
+        entries.resize(rows.size() / DomainTableEntry::NUM_COLUMNS);
+        for (size_t i = 0; i < entries.size(); ++i)
+            entries[i].fromRow(&(rows[i * DomainTableEntry::NUM_COLUMNS]));
+
+        return true;
+    }
+
     void ParallelDomainCollector::writeDomain(int32_t id,
             const CollectionType& type,
             uint32_t ndims,
             const Selection select,
             const char* name,
-            const Domain /*localDomain*/,
+            const Domain localDomain,
             const Domain globalDomain,
             DomDataClass dataClass,
             const void* buf)
@@ -440,9 +1016,15 @@ namespace splash
         Dimensions globalSize, globalOffset;
         gatherMPIWrites(ndims, select.count, globalSize, globalOffset);
 
-        writeDomain(id, globalSize, globalOffset,
-                type, ndims, select,
-                name, globalDomain, dataClass, buf);
+        write(id, globalSize, globalOffset, type, ndims, select, name, buf);
+        writeDomainAttributes(id, name, dataClass,
+                Domain(Dimensions(0, 0, 0), globalDomain.getSize()), globalDomain);
+
+        if (domainTableEnabled)
+            appendDomainTableRow(id, name, DomainTableEntry(options.mpiPos,
+                Domain(localDomain.getOffset() + globalDomain.getOffset(),
+                localDomain.getSize()),
+                globalOffset, select.count, dataClass), true);
     }
 
     void ParallelDomainCollector::writeDomain(int32_t id,
@@ -461,6 +1043,13 @@ namespace splash
         Domain localDomain(Dimensions(0, 0, 0), globalDomain.getSize());
 
         writeDomainAttributes(id, name, dataClass, localDomain, globalDomain);
+
+        // without a local domain, the data of this process is assumed
+        // to be placed at its offset in the global domain
+        if (domainTableEnabled)
+            appendDomainTableRow(id, name, DomainTableEntry(options.mpiPos,
+                Domain(globalDomain.getOffset() + globalOffset, select.count),
+                globalOffset, select.count, dataClass), true);
     }
 
     void ParallelDomainCollector::reserveDomain(int32_t id,
@@ -507,19 +1096,56 @@ namespace splash
         appendDomain(id, type, count, 0, 1, name, localDomain, globalDomain, buf);
     }
 
-    void ParallelDomainCollector::appendDomain(int32_t /*id*/,
-            const CollectionType& /*type*/,
-            size_t /*count*/,
-            size_t /*offset*/,
-            size_t /*striding*/,
-            const char* /*name*/,
-            const Domain /*localDomain*/,
-            const Domain /*globalDomain*/,
-            const void* /*buf*/)
+    void ParallelDomainCollector::appendDomain(int32_t id,
+            const CollectionType& type,
+            size_t count,
+            size_t offset,
+            size_t striding,
+            const char* name,
+            const Domain localDomain,
+            const Domain globalDomain,
+            const void* buf)
     throw (DCException)
     {
-        throw DCException("This feature is not supported in ParallelDomainCollector. "
-                "Use ParallelDataCollector::append instead.");
+        // number of elements before this append, the new elements of this
+        // process start at (old size + offset of this process)
+        size_t old_size = 0;
+        if (domainTableEnabled)
+        {
+            std::string group_path, dset_name;
+            DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+            H5Handle h5File = handles.get(id);
+            if (DCParallelGroup::exists(h5File, group_path + std::string("/") + dset_name))
+            {
+                DCParallelGroup group;
+                group.open(h5File, group_path);
+
+                DCParallelDataSet dataset(dset_name);
+                dataset.open(group.getHandle());
+                if (dataset.getSize().getScalarSize() > 0)
+                    old_size = dataset.getSize()[0];
+                dataset.close();
+            }
+        }
+
+        // collective, offsets of the processes follow the MPI rank order
+        append(id, type, count, offset, striding, name, buf);
+
+        writeDomainAttributes(id, name, PolyType,
+                Domain(Dimensions(0, 0, 0), globalDomain.getSize()), globalDomain);
+
+        if (domainTableEnabled)
+        {
+            size_t global_count = 0, global_offset = 0;
+            gatherMPIAppends(count, global_count, global_offset);
+
+            appendDomainTableRow(id, name, DomainTableEntry(options.mpiPos,
+                Domain(localDomain.getOffset() + globalDomain.getOffset(),
+                localDomain.getSize()),
+                Dimensions(old_size + global_offset, 0, 0),
+                Dimensions(count, 1, 1), PolyType), false);
+        }
     }
 
 }
@@ -0,0 +1,92 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <stdint.h>
+#include <cstring>
+
+#include "splash/core/RecordTransposer.hpp"
+
+namespace splash
+{
+
+    /**
+     * Strided copy of elements of a fixed size.
+     * The constant size lets memcpy compile to single moves.
+     */
+    template<size_t T_size>
+    static void copyStrided(const uint8_t *src, size_t srcStride,
+            uint8_t *dst, size_t dstStride, size_t count)
+    {
+        for (size_t i = 0; i < count; ++i)
+            memcpy(dst + i * dstStride, src + i * srcStride, T_size);
+    }
+
+    static void copyStrided(const uint8_t *src, size_t srcStride,
+            uint8_t *dst, size_t dstStride, size_t size, size_t count)
+    {
+        switch (size)
+        {
+            case 1:
+                copyStrided<1>(src, srcStride, dst, dstStride, count);
+                break;
+            case 2:
+                copyStrided<2>(src, srcStride, dst, dstStride, count);
+                break;
+            case 4:
+                copyStrided<4>(src, srcStride, dst, dstStride, count);
+                break;
+            case 8:
+                copyStrided<8>(src, srcStride, dst, dstStride, count);
+                break;
+            case 12:
+                copyStrided<12>(src, srcStride, dst, dstStride, count);
+                break;
+            case 16:
+                copyStrided<16>(src, srcStride, dst, dstStride, count);
+                break;
+            case 24:
+                copyStrided<24>(src, srcStride, dst, dstStride, count);
+                break;
+            case 32:
+                copyStrided<32>(src, srcStride, dst, dstStride, count);
+                break;
+            default:
+                for (size_t i = 0; i < count; ++i)
+                    memcpy(dst + i * dstStride, src + i * srcStride, size);
+        }
+    }
+
+    void RecordTransposer::gather(const void *src, size_t srcStride,
+            size_t memberSize, size_t count, void *dst)
+    {
+        copyStrided((const uint8_t*) src, srcStride, (uint8_t*) dst, memberSize,
+                memberSize, count);
+    }
+
+    void RecordTransposer::scatter(const void *src, size_t memberSize,
+            size_t count, void *dst, size_t dstStride)
+    {
+        copyStrided((const uint8_t*) src, memberSize, (uint8_t*) dst, dstStride,
+                memberSize, count);
+    }
+
+}
@@ -22,6 +22,7 @@
 
 
 
+#include <algorithm>
 #include <cstring>
 #include <time.h>
 #include <stdlib.h>
@@ -33,6 +34,8 @@
 #include "splash/core/DCAttribute.hpp"
 #include "splash/core/DCDataSet.hpp"
 #include "splash/core/DCGroup.hpp"
+#include "splash/core/DCStatistics.hpp"
+#include "splash/core/RecordTransposer.hpp"
 #include "splash/core/SDCHelper.hpp"
 #include "splash/core/logging.hpp"
 #include "splash/core/H5IdWrapper.hpp"
@@ -62,6 +65,73 @@ namespace splash
         log_msg(3, "Raw Data Cache (File) = %llu KiB", (long long unsigned) (rawCacheSize / 1024));
     }
 
+    void SerialDataCollector::copyChunkSlice(const uint8_t *chunk,
+            const Dimensions chunkSize, const Dimensions chunkOffset,
+            uint8_t *slice, const Dimensions sliceSize,
+            const Dimensions sliceOffset, const Dimensions count,
+            size_t typeSize)
+    {
+        const size_t row_bytes = count[0] * typeSize;
+
+        for (size_t z = 0; z < count[2]; ++z)
+            for (size_t y = 0; y < count[1]; ++y)
+            {
+                const size_t src_index = ((chunkOffset[2] + z) * chunkSize[1] +
+                        chunkOffset[1] + y) * chunkSize[0] + chunkOffset[0];
+                const size_t dst_index = ((sliceOffset[2] + z) * sliceSize[1] +
+                        sliceOffset[1] + y) * sliceSize[0] + sliceOffset[0];
+
+                memcpy(slice + dst_index * typeSize, chunk + src_index * typeSize,
+                        row_bytes);
+            }
+    }
+
+    void SerialDataCollector::removeStatistics(const std::string &path,
+            const std::string &name)
+    throw (DCException)
+    {
+        const std::string full_name = path + std::string("/") + name;
+        if (DCGroup::exists(handles.get(0), full_name) &&
+                H5Ldelete(handles.get(0), full_name.c_str(), H5P_LINK_ACCESS_DEFAULT) < 0)
+            throw DCException(getExceptionString("removeStatistics",
+                "failed to remove statistics", full_name.c_str()));
+    }
+
+    void SerialDataCollector::writeStatistics(int32_t id, const CollectionType& type,
+            uint32_t ndims, const Selection select, const char* name, hid_t group,
+            const std::string &dsetName, const void* data)
+    throw (DCException)
+    {
+        std::string stats_path, stats_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_STATISTICS, id, stats_path, stats_name);
+
+        if (statisticsBlockSize > 0 && data &&
+                DCStatistics::getDataType(type.getDataType()) != DCDT_UNKNOWN)
+        {
+            // blocks of multi-dimensional datasets are chunks
+            Dimensions block_size(statisticsBlockSize, 1, 1);
+            bool has_blocks = (select.count.getScalarSize() > 0);
+            if (ndims > 1)
+            {
+                DCDataSet dataset(dsetName.c_str());
+                dataset.open(group);
+                has_blocks = dataset.getChunkSize(block_size);
+                dataset.close();
+            }
+
+            if (has_blocks)
+            {
+                DCGroup stats_group;
+                stats_group.openCreate(handles.get(0), stats_path);
+                DCStatistics::write(stats_group.getHandle(), stats_name, type,
+                        block_size, select, data);
+                return;
+            }
+        }
+
+        removeStatistics(stats_path, stats_name);
+    }
+
     bool SerialDataCollector::fileExists(std::string filename)
     {
         struct stat fileInfo;
@@ -108,7 +178,11 @@ namespace splash
     handles(maxFileHandles, HandleMgr::FNS_FULLNAME),
     fileStatus(FST_CLOSED),
     maxID(-1),
-    mpiTopology(1, 1, 1)
+    mpiTopology(1, 1, 1),
+    sliceCache(64 * 1024 * 1024),
+    attributeCache(1024),
+    attributeReads(0),
+    statisticsBlockSize(0)
     {
 #ifdef COL_TYPE_CPP
         throw DCException("Check your defines !");
@@ -191,6 +265,8 @@ namespace splash
 
         maxID = -1;
         mpiTopology.set(1, 1, 1);
+        sliceCache.clear();
+        attributeCache.clear();
 
         // close opened hdf5 file handles
         handles.close();
@@ -268,6 +344,74 @@ namespace splash
             return -1;
     }
 
+    hid_t SerialDataCollector::openCreateGroup(DCGroup& group, int32_t id,
+            const char* dataName) throw (DCException)
+    {
+        // Note: Factored out from writeAttribute
+
+        /* group_path: absolute path to the last inode
+         * obj_name: last inode, can be a group or a dataset
+         */
+        std::string group_path, obj_name;
+        std::string dataNameInternal = "";
+        if (dataName)
+            dataNameInternal.assign(dataName);
+        DCDataSet::getFullDataPath(dataNameInternal, SDC_GROUP_DATA, id, group_path, obj_name);
+
+        if (dataName)
+        {
+            /* if the specified inode (obj_name) does not exist
+             * (as dataset or group), create all missing groups along group_path
+             * and even create an empty group for obj_name itself
+             *
+             * group_path + "/" + obj_name is the absolute path of dataName
+             */
+            std::string pathAndName(group_path + "/" + obj_name);
+            if(!DCGroup::exists(handles.get(id), pathAndName))
+            {
+                DCGroup obj_group;
+                obj_group.create(handles.get(id), pathAndName);
+            }
+
+            // attach attribute to the dataset or group
+            group.open(handles.get(0), group_path);
+
+            hid_t obj_id = H5Oopen(group.getHandle(), obj_name.c_str(), H5P_DEFAULT);
+            if (obj_id < 0)
+            {
+                throw DCException(getExceptionString("openCreateGroup",
+                        "object not found", obj_name.c_str()));
+            }
+
+            return obj_id;
+        } else
+        {
+            // attach attribute to the iteration group
+            group.openCreate(handles.get(0), group_path);
+            return -1;
+        }
+    }
+
+    std::string SerialDataCollector::getAttributeCacheKey(int32_t id,
+            const char* dataName, Dimensions *mpiPosition) const
+    {
+        std::string group_path, obj_name;
+        std::string dataNameInternal = "";
+        if (dataName)
+            dataNameInternal.assign(dataName);
+        DCDataSet::getFullDataPath(dataNameInternal, SDC_GROUP_DATA, id, group_path, obj_name);
+
+        // files are distinguished by their MPI position when merging
+        std::stringstream key;
+        if ((fileStatus == FST_MERGING) && (mpiPosition != NULL))
+            key << (*mpiPosition)[0] << "_" << (*mpiPosition)[1] << "_" << (*mpiPosition)[2];
+        key << ":" << group_path;
+        if (dataName)
+            key << "/" << obj_name;
+
+        return key.str();
+    }
+
     AttributeInfo SerialDataCollector::readGlobalAttributeInfo(
             int32_t /*id*/,
             const char* name,
@@ -428,53 +572,137 @@ namespace splash
         if (ndims < 1u || ndims > DSP_DIM_MAX)
             throw DCException(getExceptionString("writeAttribute", "maximum dimension `ndims` is invalid"));
 
-        /* group_path: absolute path to the last inode
-         * obj_name: last inode, can be a group or a dataset
-         */
-        std::string group_path, obj_name;
-        std::string dataNameInternal = "";
-        if (dataName)
-            dataNameInternal.assign(dataName);
-        DCDataSet::getFullDataPath(dataNameInternal, SDC_GROUP_DATA, id, group_path, obj_name);
+        DCGroup group;
+        H5ObjectId objId(openCreateGroup(group, id, dataName));
+
+        if (objId)
+            DCAttribute::writeAttribute(attrName, type.getDataType(), objId, ndims, dims, data);
+        else
+            DCAttribute::writeAttribute(attrName, type.getDataType(), group.getHandle(), ndims, dims, data);
+    }
+
+    void SerialDataCollector::readAttributes(int32_t id,
+            const char *dataName,
+            const AttributeEntry *entries,
+            size_t count,
+            Dimensions *mpiPosition)
+    throw (DCException)
+    {
+        // mpiPosition is allowed to be NULL here
+        if (entries == NULL && count > 0)
+            throw DCException(getExceptionString("readAttributes", "a parameter was null"));
+
+        std::vector<DCAttribute::BulkEntry> bulk_entries(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (entries[i].name == NULL || entries[i].type == NULL || entries[i].data == NULL)
+                throw DCException(getExceptionString("readAttributes", "a parameter was null"));
+
+            if (strlen(entries[i].name) == 0)
+                throw DCException(getExceptionString("readAttributes", "empty attribute name"));
+
+            bulk_entries[i].name = entries[i].name;
+            bulk_entries[i].type = entries[i].type->getDataType();
+            bulk_entries[i].data = entries[i].data;
+        }
+
+        if (count > 0)
+            readAttributesInternal(id, dataName, &(bulk_entries[0]), count, mpiPosition, true);
+    }
+
+    bool SerialDataCollector::readAttributesInternal(int32_t id,
+            const char *dataName,
+            const DCAttribute::BulkEntry *entries,
+            size_t count,
+            Dimensions *mpiPosition,
+            bool required)
+    throw (DCException)
+    {
+        // attributes cannot change while reading
+        const bool cached = (fileStatus == FST_READING || fileStatus == FST_MERGING) &&
+                attributeCache.getMaxObjects() > 0;
+        std::string key;
+        if (cached)
+        {
+            key = getAttributeCacheKey(id, dataName, mpiPosition);
+            if (attributeCache.read(key, entries, count))
+                return true;
+
+            if (!required && attributeCache.isMissing(key, entries, count))
+                return false;
+        }
 
         DCGroup group;
-        if (dataName)
+        H5ObjectId objId(openGroup(group, id, dataName, mpiPosition));
+        const hid_t parent = objId ? (hid_t) objId : group.getHandle();
+
+        if (cached)
         {
-            /* if the specified inode (obj_name) does not exist
-             * (as dataset or group), create all missing groups along group_path
-             * and even create an empty group for obj_name itself
-             *
-             * group_path + "/" + obj_name is the absolute path of dataName
-             */
-            std::string pathAndName(group_path + "/" + obj_name);
-            if(!DCGroup::exists(handles.get(id), pathAndName))
-                group.create(handles.get(id), pathAndName);
+            attributeReads += attributeCache.load(key, parent, entries, count);
+            if (attributeCache.read(key, entries, count))
+                return true;
 
-            // attach attribute to the dataset or group
-            group.open(handles.get(0), group_path);
+            if (!required && attributeCache.isMissing(key, entries, count))
+                return false;
+        }
 
-            hid_t obj_id = H5Oopen(group.getHandle(), obj_name.c_str(), H5P_DEFAULT);
-            if (obj_id < 0)
-            {
-                throw DCException(getExceptionString("writeAttribute",
-                        "object not found", obj_name.c_str()));
-            }
+        // variable-length or missing attributes
+        const size_t num_read = DCAttribute::readAttributes(parent, entries, count, required);
+        attributeReads += num_read;
 
-            try
-            {
-                DCAttribute::writeAttribute(attrName, type.getDataType(), obj_id, ndims, dims, data);
-            } catch (const DCException&)
-            {
-                H5Oclose(obj_id);
-                throw;
-            }
-            H5Oclose(obj_id);
-        } else
+        return num_read == count;
+    }
+
+    uint64_t SerialDataCollector::getNumAttributeReads() const
+    {
+        return attributeReads;
+    }
+
+    void SerialDataCollector::writeAttributes(int32_t id,
+            const char *dataName,
+            const AttributeEntry *entries,
+            size_t count)
+    throw (DCException)
+    {
+        if (entries == NULL && count > 0)
+            throw DCException(getExceptionString("writeAttributes", "a parameter was null"));
+
+        // dataName may be NULL, attributes are attached to iteration group in that case
+        if (dataName && strlen(dataName) == 0)
+            throw DCException(getExceptionString("writeAttributes", "empty dataset name"));
+
+        if (fileStatus == FST_CLOSED || fileStatus == FST_READING || fileStatus == FST_MERGING)
+            throw DCException(getExceptionString("writeAttributes", "this access is not permitted"));
+
+        std::vector<DCAttribute::BulkEntry> bulk_entries(count);
+        for (size_t i = 0; i < count; ++i)
         {
-            // attach attribute to the iteration group
-            group.openCreate(handles.get(0), group_path);
-            DCAttribute::writeAttribute(attrName, type.getDataType(), group.getHandle(), ndims, dims, data);
+            if (entries[i].name == NULL || entries[i].type == NULL || entries[i].data == NULL)
+                throw DCException(getExceptionString("writeAttributes", "a parameter was null"));
+
+            if (strlen(entries[i].name) == 0)
+                throw DCException(getExceptionString("writeAttributes", "empty attribute name"));
+
+            bulk_entries[i].name = entries[i].name;
+            bulk_entries[i].type = entries[i].type->getDataType();
+            bulk_entries[i].data = entries[i].data;
         }
+
+        if (count == 0)
+            return;
+
+        DCGroup group;
+        H5ObjectId objId(openCreateGroup(group, id, dataName));
+
+        if (objId)
+            DCAttribute::writeAttributes(objId, &(bulk_entries[0]), count);
+        else
+            DCAttribute::writeAttributes(group.getHandle(), &(bulk_entries[0]), count);
+    }
+
+    void SerialDataCollector::setAttributeCacheSize(size_t maxObjects)
+    {
+        attributeCache.setMaxObjects(maxObjects);
     }
 
     void SerialDataCollector::read(int32_t id,
@@ -502,6 +730,457 @@ namespace splash
                 Dimensions(0, 0, 0), sizeRead, ndims, data);
     }
 
+    void SerialDataCollector::readSlice(int32_t id,
+            const char* name,
+            uint32_t axis,
+            uint64_t position,
+            Dimensions &sizeRead,
+            void* data)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("readSlice", "parameter name is NULL"));
+
+        if (fileStatus != FST_READING && fileStatus != FST_WRITING)
+            throw DCException(getExceptionString("readSlice", "this access is not permitted"));
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCGroup group;
+        group.open(handles.get(0), group_path);
+
+        DCDataSet dataset(dset_name.c_str());
+        dataset.open(group.getHandle());
+
+        const Dimensions size = dataset.getSize();
+        if (axis >= dataset.getNDims() || position >= size[axis])
+        {
+            dataset.close();
+            throw DCException(getExceptionString("readSlice",
+                    "slice is outside of dataset", name));
+        }
+
+        Dimensions slice_size(size);
+        slice_size[axis] = 1;
+        Dimensions slice_offset(0, 0, 0);
+        slice_offset[axis] = position;
+
+        sizeRead.set(slice_size);
+
+        Dimensions chunk_size(1, 1, 1);
+        uint32_t src_ndims = 0;
+        if (!data || slice_size.getScalarSize() == 0 ||
+                sliceCache.getMaxBytes() == 0 || !dataset.getChunkSize(chunk_size))
+        {
+            dataset.read(slice_size, Dimensions(0, 0, 0), slice_size, slice_offset,
+                    sizeRead, src_ndims, data);
+            dataset.close();
+            return;
+        }
+
+        // plan: all chunks crossing the slice
+        Dimensions first_chunk(0, 0, 0);
+        Dimensions num_chunks(1, 1, 1);
+        for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+        {
+            first_chunk[i] = slice_offset[i] / chunk_size[i];
+            num_chunks[i] = (slice_offset[i] + slice_size[i] - 1) / chunk_size[i] -
+                    first_chunk[i] + 1;
+        }
+
+        const size_t type_size = dataset.getDataTypeSize();
+        const std::string key = group_path + std::string("/") + dset_name;
+        size_t hits = 0;
+
+        for (size_t z = 0; z < num_chunks[2]; ++z)
+            for (size_t y = 0; y < num_chunks[1]; ++y)
+                for (size_t x = 0; x < num_chunks[0]; ++x)
+                {
+                    const Dimensions index(first_chunk[0] + x,
+                            first_chunk[1] + y, first_chunk[2] + z);
+                    Dimensions origin(0, 0, 0);
+                    Dimensions extent(1, 1, 1);
+                    for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+                    {
+                        origin[i] = index[i] * chunk_size[i];
+                        extent[i] = std::min(chunk_size[i], size[i] - origin[i]);
+                    }
+
+                    // position of the slice in the chunk and the chunk in the slice
+                    Dimensions chunk_offset(0, 0, 0);
+                    chunk_offset[axis] = position - origin[axis];
+                    Dimensions dst_offset(origin);
+                    dst_offset[axis] = 0;
+                    Dimensions count(extent);
+                    count[axis] = 1;
+
+                    const std::vector<uint8_t> *cached = sliceCache.find(key, origin);
+                    if (cached)
+                    {
+                        copyChunkSlice(&((*cached)[0]), extent, chunk_offset,
+                                (uint8_t*) data, slice_size, dst_offset, count, type_size);
+                        hits++;
+                        continue;
+                    }
+
+                    // read and decode the complete chunk once
+                    std::vector<uint8_t> buffer(extent.getScalarSize() * type_size);
+                    Dimensions chunk_read;
+                    dataset.read(extent, Dimensions(0, 0, 0), extent, origin,
+                            chunk_read, src_ndims, &(buffer[0]));
+
+                    copyChunkSlice(&(buffer[0]), extent, chunk_offset,
+                            (uint8_t*) data, slice_size, dst_offset, count, type_size);
+                    sliceCache.insert(key, origin, buffer);
+                }
+
+        dataset.close();
+
+        log_msg(3, "readSlice: %llu of %llu chunks cached",
+                (long long unsigned) hits,
+                (long long unsigned) num_chunks.getScalarSize());
+    }
+
+    void SerialDataCollector::setSliceCacheSize(size_t maxBytes)
+    {
+        sliceCache.setMaxBytes(maxBytes);
+    }
+
+    void SerialDataCollector::setStatisticsBlockSize(size_t blockElements)
+    {
+        statisticsBlockSize = blockElements;
+    }
+
+    uint64_t SerialDataCollector::readRange(int32_t id,
+            const char* name,
+            double minValue,
+            double maxValue,
+            std::vector<uint64_t> &indices)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("readRange", "parameter name is NULL"));
+
+        if (fileStatus != FST_READING && fileStatus != FST_WRITING)
+            throw DCException(getExceptionString("readRange", "this access is not permitted"));
+
+        indices.clear();
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCGroup group;
+        group.open(handles.get(0), group_path);
+
+        DCDataSet dataset(dset_name.c_str());
+        dataset.open(group.getHandle());
+
+        const Dimensions size = dataset.getSize();
+        const DCDataType type = dataset.getDCDataType();
+        const size_t type_size = dataset.getDataTypeSize();
+
+        if (type == DCDT_UNKNOWN ||
+                (type_size != sizeof (int32_t) && type_size != sizeof (int64_t)))
+        {
+            dataset.close();
+            throw DCException(getExceptionString("readRange",
+                    "datatype is not supported", name));
+        }
+
+        if (size.getScalarSize() == 0)
+        {
+            dataset.close();
+            return 0;
+        }
+
+        // blocks which may contain matching values,
+        // the complete dataset without statistics
+        Dimensions block_size(size);
+        std::vector<bool> candidates(1, true);
+
+        std::string stats_path, stats_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_STATISTICS, id, stats_path, stats_name);
+        if (DCGroup::exists(handles.get(0), stats_path))
+        {
+            DCGroup stats_group;
+            stats_group.open(handles.get(0), stats_path);
+            if (!DCStatistics::getCandidates(stats_group.getHandle(), stats_name,
+                    size, minValue, maxValue, block_size, candidates))
+            {
+                block_size = size;
+                candidates.assign(1, true);
+            }
+        }
+
+        const Dimensions num_blocks = DCStatistics::getNumBlocks(size, block_size);
+        std::vector<uint8_t> buffer;
+        uint64_t elements_read = 0;
+
+        for (size_t z = 0; z < num_blocks[2]; ++z)
+            for (size_t y = 0; y < num_blocks[1]; ++y)
+            {
+                const size_t row = (z * num_blocks[1] + y) * num_blocks[0];
+                size_t x = 0;
+                while (x < num_blocks[0])
+                {
+                    if (!candidates[row + x])
+                    {
+                        x++;
+                        continue;
+                    }
+
+                    // read consecutive candidate blocks at once
+                    size_t x_end = x + 1;
+                    while (x_end < num_blocks[0] && candidates[row + x_end])
+                        x_end++;
+
+                    const Dimensions origin(x * block_size[0], y * block_size[1],
+                            z * block_size[2]);
+                    const Dimensions extent(
+                            std::min(x_end * block_size[0], size[0]) - origin[0],
+                            std::min(block_size[1], size[1] - origin[1]),
+                            std::min(block_size[2], size[2] - origin[2]));
+
+                    buffer.resize(extent.getScalarSize() * type_size);
+                    Dimensions size_read;
+                    uint32_t src_ndims = 0;
+                    dataset.read(extent, Dimensions(0, 0, 0), extent, origin,
+                            size_read, src_ndims, &(buffer[0]));
+
+                    DCStatistics::filter(type, &(buffer[0]), extent, origin, size,
+                            minValue, maxValue, indices);
+                    elements_read += extent.getScalarSize();
+
+                    x = x_end;
+                }
+            }
+
+        dataset.close();
+
+        // blocks of multi-dimensional datasets are not in index order
+        std::sort(indices.begin(), indices.end());
+
+        log_msg(2, "readRange: %llu of %llu elements read, %llu matching",
+                (long long unsigned) elements_read,
+                (long long unsigned) size.getScalarSize(),
+                (long long unsigned) indices.size());
+
+        return elements_read;
+    }
+
+    bool SerialDataCollector::getRawLocation(int32_t id,
+            const char* name,
+            std::string &filename,
+            std::vector<haddr_t> &addresses,
+            std::vector<Dimensions> &origins,
+            Dimensions &extentSize,
+            Dimensions &size,
+            size_t &typeSize)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("getRawLocation", "parameter name is NULL"));
+
+        // data of files opened for writing may not be on disk yet
+        if (fileStatus != FST_READING)
+            throw DCException(getExceptionString("getRawLocation", "this access is not permitted"));
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCGroup group;
+        group.open(handles.get(0), group_path);
+
+        DCDataSet dataset(dset_name.c_str());
+        dataset.open(group.getHandle());
+
+        size = dataset.getSize();
+        typeSize = dataset.getDataTypeSize();
+        const bool raw = dataset.getRawExtents(addresses, origins, extentSize);
+        dataset.close();
+
+        ssize_t name_length = H5Fget_name(handles.get(0), NULL, 0);
+        if (name_length < 0)
+            throw DCException(getExceptionString("getRawLocation",
+                "failed to get filename", name));
+
+        std::vector<char> file_name(name_length + 1);
+        H5Fget_name(handles.get(0), &(file_name[0]), file_name.size());
+        filename.assign(&(file_name[0]));
+
+        return raw;
+    }
+
+    /**
+     * Datatype of a record member, the HDF5 datatype is owned by the record.
+     */
+    class ColTypeRecordMember : public CollectionType
+    {
+    public:
+
+        ColTypeRecordMember(const ColTypeRecord::Member &member) :
+        CollectionType(member.type),
+        size(member.size)
+        {
+        }
+
+        size_t getSize() const
+        {
+            return size;
+        }
+
+        std::string toString() const
+        {
+            return "RecordMember";
+        }
+
+    private:
+        size_t size;
+    };
+
+    // maximum size of the staging buffer for transposing one record member
+    static const size_t SOA_STAGE_BYTES = 4 * 1024 * 1024;
+
+    /**
+     * Returns the number of planes along the slowest dimension
+     * which are transposed at once.
+     */
+    static size_t getSoABlockPlanes(const Dimensions count, uint32_t ndims,
+            size_t memberSize)
+    {
+        size_t plane_bytes = memberSize;
+        for (uint32_t i = 0; i < ndims - 1; ++i)
+            plane_bytes *= count[i];
+
+        size_t planes = std::max((size_t) 1, SOA_STAGE_BYTES / plane_bytes);
+        return std::min(planes, (size_t) count[ndims - 1]);
+    }
+
+    void SerialDataCollector::writeRecordsSoA(int32_t id,
+            const ColTypeRecord& type,
+            uint32_t ndims,
+            const Selection select,
+            const char* name,
+            const void* buf)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("writeRecordsSoA", "parameter name is NULL"));
+
+        if (fileStatus == FST_CLOSED || fileStatus == FST_READING || fileStatus == FST_MERGING)
+            throw DCException(getExceptionString("writeRecordsSoA", "this access is not permitted"));
+
+        if (ndims < 1 || ndims > DSP_DIM_MAX)
+            throw DCException(getExceptionString("writeRecordsSoA", "maximum dimension is invalid"));
+
+        if (type.getNumMembers() == 0)
+            throw DCException(getExceptionString("writeRecordsSoA", "record has no members",
+                type.toString().c_str()));
+
+        if (id > this->maxID)
+            this->maxID = id;
+
+        for (size_t m = 0; m < type.getNumMembers(); ++m)
+        {
+            const ColTypeRecord::Member &member = type.getMember(m);
+            std::string member_name = std::string(name) + std::string("/") + member.name;
+
+            std::string group_path, dset_name;
+            DCDataSet::getFullDataPath(member_name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+            DCGroup group;
+            group.openCreate(handles.get(0), group_path);
+
+            writeMemberDataSet(group.getHandle(), ColTypeRecordMember(member),
+                    type.getSize(), member.offset, ndims, select, dset_name.c_str(), buf);
+
+            std::string stats_path, stats_name;
+            DCDataSet::getFullDataPath(member_name, SDC_GROUP_STATISTICS, id,
+                    stats_path, stats_name);
+            removeStatistics(stats_path, stats_name);
+        }
+    }
+
+    void SerialDataCollector::readRecordsSoA(int32_t id,
+            const ColTypeRecord& type,
+            const char* name,
+            Dimensions &sizeRead,
+            void* buf)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("readRecordsSoA", "parameter name is NULL"));
+
+        if (fileStatus != FST_READING && fileStatus != FST_WRITING)
+            throw DCException(getExceptionString("readRecordsSoA", "this access is not permitted"));
+
+        if (type.getNumMembers() == 0)
+            throw DCException(getExceptionString("readRecordsSoA", "record has no members",
+                type.toString().c_str()));
+
+        uint8_t *records = (uint8_t*) buf;
+        const size_t record_size = type.getSize();
+        std::vector<uint8_t> stage;
+
+        for (size_t m = 0; m < type.getNumMembers(); ++m)
+        {
+            const ColTypeRecord::Member &member = type.getMember(m);
+            std::string member_name = std::string(name) + std::string("/") + member.name;
+
+            std::string group_path, dset_name;
+            DCDataSet::getFullDataPath(member_name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+            DCGroup group;
+            group.open(handles.get(0), group_path);
+
+            DCDataSet dataset(dset_name.c_str());
+            dataset.open(group.getHandle());
+
+            if (dataset.getDataTypeSize() != member.size)
+                throw DCException(getExceptionString("readRecordsSoA",
+                    "datatype size does not match record member", member_name.c_str()));
+
+            const Dimensions size(dataset.getSize());
+            const uint32_t ndims = dataset.getNDims();
+
+            if (m == 0)
+                sizeRead.set(size);
+            else if (size != sizeRead)
+                throw DCException(getExceptionString("readRecordsSoA",
+                    "record members differ in size", member_name.c_str()));
+
+            if (records && ndims > 0 && size.getScalarSize() > 0)
+            {
+                const uint32_t d = ndims - 1;
+                const size_t planes = getSoABlockPlanes(size, ndims, member.size);
+                const size_t plane_elements = size.getScalarSize() / size[d];
+                stage.resize(planes * plane_elements * member.size);
+
+                // blocks of planes along the slowest dimension are contiguous records
+                for (size_t z0 = 0; z0 < size[d]; z0 += planes)
+                {
+                    Dimensions block_size(size);
+                    block_size[d] = std::min(planes, (size_t) (size[d] - z0));
+                    Dimensions block_offset(0, 0, 0);
+                    block_offset[d] = z0;
+
+                    Dimensions block_read;
+                    uint32_t block_ndims = 0;
+                    dataset.read(block_size, Dimensions(0, 0, 0), block_size, block_offset,
+                            block_read, block_ndims, &(stage[0]));
+
+                    RecordTransposer::scatter(&(stage[0]), member.size,
+                            block_size.getScalarSize(),
+                            records + z0 * plane_elements * record_size + member.offset,
+                            record_size);
+                }
+            }
+
+            dataset.close();
+        }
+    }
+
     CollectionType* SerialDataCollector::readMeta(int32_t id,
             const char* name,
             const Dimensions dstBuffer,
@@ -547,6 +1226,38 @@ namespace splash
         {
             throw;
         }
+
+        writeStatistics(id, type, ndims, select, name, group.getHandle(), dset_name, data);
+    }
+
+    void SerialDataCollector::write(int32_t id, const MemberView& type, uint32_t ndims,
+            const Selection select, const char* name, const void* data)
+    throw (DCException)
+    {
+        if (name == NULL)
+            throw DCException(getExceptionString("write", "parameter name is NULL"));
+
+        if (fileStatus == FST_CLOSED || fileStatus == FST_READING || fileStatus == FST_MERGING)
+            throw DCException(getExceptionString("write", "this access is not permitted"));
+
+        if (ndims < 1 || ndims > DSP_DIM_MAX)
+            throw DCException(getExceptionString("write", "maximum dimension is invalid"));
+
+        if (id > this->maxID)
+            this->maxID = id;
+
+        std::string group_path, dset_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_DATA, id, group_path, dset_name);
+
+        DCGroup group;
+        group.openCreate(handles.get(0), group_path);
+
+        writeMemberDataSet(group.getHandle(), type, type.getRecordSize(),
+                type.getMemberOffset(), ndims, select, dset_name.c_str(), data);
+
+        // statistics address the buffer in units of the member
+        writeStatistics(id, type, ndims, type.getMemberSelection(select), name,
+                group.getHandle(), dset_name, data);
     }
 
     void SerialDataCollector::append(int32_t id, const CollectionType& type,
@@ -575,6 +1286,19 @@ namespace splash
         DCGroup group;
         group.openCreate(handles.get(0), group_path);
 
+        const bool statistics = (statisticsBlockSize > 0) &&
+                (DCStatistics::getDataType(type.getDataType()) != DCDT_UNKNOWN);
+        uint64_t old_size = 0;
+        if (statistics)
+        {
+            DCDataSet dataset(dset_name.c_str());
+            if (dataset.open(group.getHandle()))
+            {
+                old_size = dataset.getSize()[0];
+                dataset.close();
+            }
+        }
+
         // write data to the group
         try
         {
@@ -584,6 +1308,22 @@ namespace splash
         {
             throw;
         }
+
+        std::string stats_path, stats_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_STATISTICS, id, stats_path, stats_name);
+
+        if (statistics)
+        {
+            DCGroup stats_group;
+            stats_group.openCreate(handles.get(0), stats_path);
+            if (DCStatistics::append(stats_group.getHandle(), stats_name, type,
+                    statisticsBlockSize, old_size, count, offset, stride, data))
+                return;
+
+            log_msg(1, "removing outdated statistics for %s", name);
+        }
+
+        removeStatistics(stats_path, stats_name);
     }
 
     void SerialDataCollector::remove(int32_t id)
@@ -598,6 +1338,12 @@ namespace splash
         group_id_name << SDC_GROUP_DATA << "/" << id;
 
         DCGroup::remove(handles.get(0), group_id_name.str());
+        sliceCache.clear();
+
+        std::stringstream stats_id_name;
+        stats_id_name << SDC_GROUP_STATISTICS << "/" << id;
+        if (DCGroup::exists(handles.get(0), stats_id_name.str()))
+            DCGroup::remove(handles.get(0), stats_id_name.str());
 
         // update maxID to new highest group
         maxID = 0;
@@ -637,6 +1383,12 @@ namespace splash
             throw DCException(getExceptionString("remove",
                     "failed to remove dataset", dset_name.c_str()));
         }
+
+        sliceCache.clear();
+
+        std::string stats_path, stats_name;
+        DCDataSet::getFullDataPath(name, SDC_GROUP_STATISTICS, id, stats_path, stats_name);
+        removeStatistics(stats_path, stats_name);
     }
 
     void SerialDataCollector::createReference(int32_t srcID,
@@ -668,6 +1420,7 @@ namespace splash
 
         // if destination group does not exist, it is created
         dst_group.openCreate(handles.get(0), dst_group_path);
+        sliceCache.clear();
 
         // open source dataset
         try
@@ -721,6 +1474,7 @@ namespace splash
 
         // if destination group does not exist, it is created
         dst_group.openCreate(handles.get(0), dst_group_path);
+        sliceCache.clear();
 
         // open source dataset
         try
@@ -919,6 +1673,8 @@ namespace splash
     {
         log_msg(2, "writeDataSet");
 
+        sliceCache.clear();
+
         DCDataSet dataset(name);
         // always create dataset but write data only if all dimensions > 0 and data available
         // not extensible
@@ -929,12 +1685,71 @@ namespace splash
         dataset.close();
     }
 
+    void SerialDataCollector::writeMemberDataSet(hid_t group,
+            const CollectionType& memberType,
+            size_t recordSize,
+            size_t memberOffset,
+            uint32_t ndims,
+            const Selection select,
+            const char* name,
+            const void* data) throw (DCException)
+    {
+        log_msg(2, "writeMemberDataSet");
+
+        sliceCache.clear();
+
+        DCDataSet dataset(name);
+        dataset.create(memberType, group, select.count, ndims,
+                this->enableCompression, false);
+
+        if (data && (select.count.getScalarSize() > 0))
+        {
+            const uint8_t *records = (const uint8_t*) data;
+            const size_t member_size = memberType.getSize();
+            const uint32_t d = ndims - 1;
+            const size_t planes = getSoABlockPlanes(select.count, ndims, member_size);
+            std::vector<uint8_t> stage(planes *
+                    (select.count.getScalarSize() / select.count[d]) * member_size);
+
+            for (size_t z0 = 0; z0 < select.count[d]; z0 += planes)
+            {
+                Dimensions block_count(select.count);
+                block_count[d] = std::min(planes, (size_t) (select.count[d] - z0));
+                Dimensions block_offset(0, 0, 0);
+                block_offset[d] = z0;
+
+                // gather rows of the block
+                uint8_t *dst = &(stage[0]);
+                for (size_t z = 0; z < block_count[2]; ++z)
+                    for (size_t y = 0; y < block_count[1]; ++y)
+                    {
+                        Dimensions pos(block_offset + Dimensions(0, y, z));
+                        Dimensions index(select.offset + pos * select.stride);
+                        size_t src_index = (index[2] * select.size[1] + index[1]) *
+                                select.size[0] + index[0];
+
+                        RecordTransposer::gather(
+                                records + src_index * recordSize + memberOffset,
+                                select.stride[0] * recordSize, member_size,
+                                block_count[0], dst);
+                        dst += block_count[0] * member_size;
+                    }
+
+                dataset.write(Selection(block_count), block_offset, &(stage[0]));
+            }
+        }
+
+        dataset.close();
+    }
+
     void SerialDataCollector::appendDataSet(hid_t group, const CollectionType& datatype,
             size_t count, size_t offset, size_t stride, const char* name, const void* data)
     throw (DCException)
     {
         log_msg(2, "appendDataSet");
 
+        sliceCache.clear();
+
         DCDataSet dataset(name);
 
         if (!dataset.open(group))
@@ -944,8 +1759,8 @@ namespace splash
             dataset.create(datatype, group, data_size, 1, this->enableCompression, true);
 
             if (count > 0)
-                dataset.write(Selection(data_size,
-                    Dimensions(offset + count * stride, 1, 1),
+                dataset.write(Selection(Dimensions(offset + count * stride, 1, 1),
+                    data_size,
                     Dimensions(offset, 0, 0),
                     Dimensions(stride, 1, 1)),
                     Dimensions(0, 0, 0),
@@ -1025,6 +1840,23 @@ namespace splash
             uint32_t& srcDims,
             void* dst)
     throw (DCException)
+    {
+        readDataSet(h5File, id, name, dstBuffer, dstOffset, srcSize, srcOffset,
+                Dimensions(1, 1, 1), sizeRead, srcDims, dst);
+    }
+
+    void SerialDataCollector::readDataSet(H5Handle h5File,
+            int32_t id,
+            const char* name,
+            const Dimensions dstBuffer,
+            const Dimensions dstOffset,
+            const Dimensions srcSize,
+            const Dimensions srcOffset,
+            const Dimensions srcStride,
+            Dimensions &sizeRead,
+            uint32_t& srcDims,
+            void* dst)
+    throw (DCException)
     {
         log_msg(2, "readDataSet");
 
@@ -1036,7 +1868,8 @@ namespace splash
 
         DCDataSet dataset(dset_name.c_str());
         dataset.open(group.getHandle());
-        dataset.read(dstBuffer, dstOffset, srcSize, srcOffset, sizeRead, srcDims, dst);
+        dataset.read(dstBuffer, dstOffset, srcSize, srcOffset, srcStride,
+                sizeRead, srcDims, dst);
         dataset.close();
     }
 
@@ -20,116 +20,257 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef GENERATE_COLLECTION_TYPE_H
-#define GENERATE_COLLECTION_TYPE_H
-
+#include <map>
+#include <string>
+#include <vector>
 
 #include "splash/basetypes/generateCollectionType.hpp"
 #include "splash/basetypes/basetypes.hpp"
-#include <typeinfo>
-#include <cassert>
 
 namespace splash
 {
 
 /**
- * Checks if a datatype_id (from an outer scope) can be used to generate a
- * specific CollectionType instance.
- *
- * If the call to the genType member function of a specific collection type
- * is successful, it will return the pointer to an instance of this type.
- *
- * @param _name the suffix of the ColType. i.e. to check for ColTypeBool,
- * _name should be set to Bool.
+ * Creates a CollectionType which does not depend on the HDF5 datatype
+ * it was recognized from.
  */
-#define TRY_COLTYPE(_name)                                                     \
-{                                                                              \
-    CollectionType* t = ColType##_name::genType(datatype_id);                  \
-    assert(t == NULL || typeid(*t) == typeid(ColType##_name));                 \
-    if(t != NULL) return t;                                                    \
-}                                                                              \
-
+template<typename T_ColType>
+static CollectionType* createColType(hid_t)
+{
+    return new T_ColType;
+}
 
 /**
- * Creates a new instance of a CollectionType based on the given datatype_id
+ * Probe for a built-in CollectionType.
  *
- * @param datatype_id the H5 datatype_id that should be converted into a
- *                    CollectionType
- *
- * @return A pointer to a heap-allocated CollectionType.
- *         The allocated object must be freed by the caller at the end of its
- *         lifetime.
- *         If no matching CollectionType was found, returns a ColTypeUnknown
- *         instance.
+ * genType checks if a datatype_id can be used to generate a
+ * specific CollectionType instance, create generates an instance
+ * for a datatype already recognized by genType.
  */
-CollectionType* generateCollectionType(hid_t datatype_id)
+typedef struct
 {
+    GenTypeFunction genType;
+    GenTypeFunction create;
+} ColTypeProbe;
+
+/**
+ * Adds the probe for a built-in CollectionType.
+ *
+ * @param _name the suffix of the ColType. i.e. to check for ColTypeBool,
+ * _name should be set to Bool.
+ */
+#define COLTYPE_PROBE(_name)                                                   \
+    {&ColType##_name::genType, &createColType<ColType##_name>},                \
+
+// probes are tried in this order
+static const ColTypeProbe COLTYPE_PROBES[] = {
     // basetypes atomic
-    TRY_COLTYPE(Int8)
-    TRY_COLTYPE(Int16)
-    TRY_COLTYPE(Int32)
-    TRY_COLTYPE(Int64)
+    COLTYPE_PROBE(Int8)
+    COLTYPE_PROBE(Int16)
+    COLTYPE_PROBE(Int32)
+    COLTYPE_PROBE(Int64)
 
-    TRY_COLTYPE(UInt8)
-    TRY_COLTYPE(UInt16)
-    TRY_COLTYPE(UInt32)
-    TRY_COLTYPE(UInt64)
+    COLTYPE_PROBE(UInt8)
+    COLTYPE_PROBE(UInt16)
+    COLTYPE_PROBE(UInt32)
+    COLTYPE_PROBE(UInt64)
 
-    TRY_COLTYPE(Float)
-    TRY_COLTYPE(Double)
-    TRY_COLTYPE(Char)
-    TRY_COLTYPE(Int)
+    COLTYPE_PROBE(Float)
+    COLTYPE_PROBE(Double)
+    COLTYPE_PROBE(Char)
+    COLTYPE_PROBE(Int)
 
 
     // ColType Bool -> must be before the other enum types!
-    TRY_COLTYPE(Bool)
+    COLTYPE_PROBE(Bool)
 
 
-    // ColType String
-    TRY_COLTYPE(String)
+    // ColType String, depends on the datatype (length, padding)
+    {&ColTypeString::genType, &ColTypeString::genType},
 
 
     // ColTypeArray()
-    TRY_COLTYPE(Float2Array)
-    TRY_COLTYPE(Float3Array)
-    TRY_COLTYPE(Float4Array)
+    COLTYPE_PROBE(Float2Array)
+    COLTYPE_PROBE(Float3Array)
+    COLTYPE_PROBE(Float4Array)
 
-    TRY_COLTYPE(Double2Array)
-    TRY_COLTYPE(Double3Array)
-    TRY_COLTYPE(Double4Array)
+    COLTYPE_PROBE(Double2Array)
+    COLTYPE_PROBE(Double3Array)
+    COLTYPE_PROBE(Double4Array)
 
-    TRY_COLTYPE(Int4Array)
-    TRY_COLTYPE(Int3Array)
-    TRY_COLTYPE(Int2Array)
+    COLTYPE_PROBE(Int4Array)
+    COLTYPE_PROBE(Int3Array)
+    COLTYPE_PROBE(Int2Array)
 
 
     // ColTypeDimArray
-    TRY_COLTYPE(DimArray)
+    COLTYPE_PROBE(DimArray)
 
 
     // ColType Dim
-    TRY_COLTYPE(Dim)
+    COLTYPE_PROBE(Dim)
 
 
     // Coltype Compound
-    TRY_COLTYPE(Float2)
-    TRY_COLTYPE(Float3)
-    TRY_COLTYPE(Float4)
+    COLTYPE_PROBE(Float2)
+    COLTYPE_PROBE(Float3)
+    COLTYPE_PROBE(Float4)
+
+    COLTYPE_PROBE(Double2)
+    COLTYPE_PROBE(Double3)
+    COLTYPE_PROBE(Double4)
 
-    TRY_COLTYPE(Double2)
-    TRY_COLTYPE(Double3)
-    TRY_COLTYPE(Double4)
+    COLTYPE_PROBE(Int2)
+    COLTYPE_PROBE(Int3)
+    COLTYPE_PROBE(Int4)
+};
 
-    TRY_COLTYPE(Int2)
-    TRY_COLTYPE(Int3)
-    TRY_COLTYPE(Int4)
+#undef COLTYPE_PROBE
 
-    return new ColTypeUnknown;
+/**
+ * Registered user types and the probe which recognized a datatype,
+ * indexed by the serialized datatype (H5Tencode).
+ * A NULL create function stands for ColTypeUnknown.
+ */
+struct ColTypeRegistry
+{
+    ColTypeRegistry() :
+    maxEntries(4096)
+    {
+    }
+
+    std::vector<GenTypeFunction> userTypes;
+    std::map<std::string, GenTypeFunction> cache;
+    size_t maxEntries;
+};
+
+static ColTypeRegistry& getRegistry()
+{
+    static ColTypeRegistry registry;
+    return registry;
 }
 
-#undef TRY_COLTYPE
+/**
+ * Serializes a datatype including all members.
+ *
+ * @param datatype_id the H5 datatype_id
+ * @param fingerprint returns the serialized datatype
+ * @return false if the datatype cannot be serialized
+ */
+static bool getFingerprint(hid_t datatype_id, std::string &fingerprint)
+{
+    size_t size = 0;
+    herr_t status = -1;
 
-} /* namespace splash */
+    H5E_BEGIN_TRY
+    {
+        status = H5Tencode(datatype_id, NULL, &size);
+    }
+    H5E_END_TRY;
+
+    if (status < 0 || size == 0)
+        return false;
 
+    std::vector<char> buffer(size);
+    H5E_BEGIN_TRY
+    {
+        status = H5Tencode(datatype_id, &(buffer[0]), &size);
+    }
+    H5E_END_TRY;
 
-#endif /* GENERATE_COLLECTION_TYPE_H */
+    if (status < 0)
+        return false;
+
+    fingerprint.assign(&(buffer[0]), buffer.size());
+    return true;
+}
+
+void registerCollectionType(GenTypeFunction genType)
+{
+    ColTypeRegistry &registry = getRegistry();
+    for (size_t i = 0; i < registry.userTypes.size(); ++i)
+    {
+        if (registry.userTypes[i] == genType)
+            return;
+    }
+
+    registry.userTypes.push_back(genType);
+
+    // user types take precedence over cached results
+    registry.cache.clear();
+}
+
+void setCollectionTypeCacheSize(size_t maxEntries)
+{
+    ColTypeRegistry &registry = getRegistry();
+    registry.maxEntries = maxEntries;
+    registry.cache.clear();
+}
+
+/**
+ * Creates a new instance of a CollectionType based on the given datatype_id
+ *
+ * @param datatype_id the H5 datatype_id that should be converted into a
+ *                    CollectionType
+ *
+ * @return A pointer to a heap-allocated CollectionType.
+ *         The allocated object must be freed by the caller at the end of its
+ *         lifetime.
+ *         If no matching CollectionType was found, returns a ColTypeUnknown
+ *         instance.
+ */
+CollectionType* generateCollectionType(hid_t datatype_id)
+{
+    ColTypeRegistry &registry = getRegistry();
+
+    std::string fingerprint;
+    const bool cacheable = (registry.maxEntries > 0) &&
+            getFingerprint(datatype_id, fingerprint);
+
+    if (cacheable)
+    {
+        std::map<std::string, GenTypeFunction>::const_iterator iter =
+                registry.cache.find(fingerprint);
+        if (iter != registry.cache.end())
+        {
+            if (iter->second == NULL)
+                return new ColTypeUnknown;
+
+            CollectionType *t = iter->second(datatype_id);
+            if (t != NULL)
+                return t;
+        }
+
+        if (registry.cache.size() >= registry.maxEntries)
+            registry.cache.clear();
+    }
+
+    GenTypeFunction create = NULL;
+    CollectionType *t = NULL;
+
+    for (size_t i = 0; i < registry.userTypes.size() && t == NULL; ++i)
+    {
+        t = registry.userTypes[i](datatype_id);
+        create = registry.userTypes[i];
+    }
+
+    const size_t num_probes = sizeof (COLTYPE_PROBES) / sizeof (COLTYPE_PROBES[0]);
+    for (size_t i = 0; i < num_probes && t == NULL; ++i)
+    {
+        t = COLTYPE_PROBES[i].genType(datatype_id);
+        create = COLTYPE_PROBES[i].create;
+    }
+
+    if (t == NULL)
+    {
+        t = new ColTypeUnknown;
+        create = NULL;
+    }
+
+    if (cacheable)
+        registry.cache[fingerprint] = create;
+
+    return t;
+}
+
+} /* namespace splash */
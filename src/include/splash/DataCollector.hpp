@@ -51,7 +51,9 @@
 #include "splash/CollectionType.hpp"
 #include "splash/Dimensions.hpp"
 #include "splash/Selection.hpp"
+#include "splash/MemberView.hpp"
 #include "splash/AttributeInfo.hpp"
+#include "splash/basetypes/ColTypeTraits.hpp"
 #include "splash/core/DCDataSet.hpp"
 #include "splash/core/splashMacros.hpp"
 
@@ -208,6 +210,49 @@ namespace splash
                 const char* name,
                 const void* buf) = 0;
 
+        /**
+         * Writes data of a C++ type to HDF5 file,
+         * the CollectionType is taken from ColTypeTraits<T>.
+         * The number of dimensions is derived from \p select.size.
+         *
+         * @param id ID for iteration.
+         * @param select Selection in src buffer
+         * @param name Name for the dataset.
+         * @param buf Buffer for writing.
+         */
+        template<typename T>
+        void write(int32_t id,
+                const Selection select,
+                const char* name,
+                const T* buf)
+        {
+            write(id, getColType<T>(), select.size.getDims(), select, name,
+                    (const void*) buf);
+        }
+
+        /**
+         * Writes one member of the elements of an interleaved buffer
+         * to HDF5 file without copying it, see MemberView.
+         * By default, HDF5 gathers the member with a strided selection.
+         *
+         * @param id ID for iteration.
+         * @param type Member view of the elements of \p buf.
+         * @param ndims Number of dimensions (1-3).
+         * @param select Selection of elements in src buffer
+         * @param name Name for the dataset.
+         * @param buf Buffer of elements for writing.
+         */
+        virtual void write(int32_t id,
+                const MemberView& type,
+                uint32_t ndims,
+                const Selection select,
+                const char* name,
+                const void* buf)
+        {
+            write(id, (const CollectionType&) type, ndims,
+                    type.getMemberSelection(select), name, buf);
+        }
+
         /**
          * Appends 1-dimensional data in a HDF5 file.
          *
@@ -470,6 +515,25 @@ namespace splash
                 Dimensions &sizeRead,
                 void* buf) = 0;
 
+        /**
+         * Reads data from HDF5 file into a buffer of a C++ type.
+         * Data is read in the datatype of the dataset,
+         * which must match ColTypeTraits<T>.
+         *
+         * @param id ID for iteration.
+         * @param name Name for the dataset.
+         * @param sizeRead Returns the size of the data in the file.
+         * @param buf Buffer to read from file.
+         */
+        template<typename T>
+        void read(int32_t id,
+                const char* name,
+                Dimensions &sizeRead,
+                T* buf)
+        {
+            read(id, name, sizeRead, (void*) buf);
+        }
+
         /**
          * Reads meta data from HDF5 file.
          *
@@ -0,0 +1,127 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DISTRIBUTEDDOMAINCOLLECTOR_HPP
+#define DISTRIBUTEDDOMAINCOLLECTOR_HPP
+
+#include <mpi.h>
+#include <string>
+#include <vector>
+
+#include "splash/DomainCollector.hpp"
+
+namespace splash
+{
+
+    /**
+     * DistributedDomainCollector extends DomainCollector with collective
+     * reads of merged files (FAT_READ_MERGED) by the processes of an
+     * MPI communicator, e.g. for parallel post-processing.
+     *
+     * Every process opens the same file set. The files intersecting the
+     * requests of all processes are distributed among the processes, each
+     * file is opened and read by a single process and the data is sent to
+     * the requesting processes with MPI. The resulting DataContainer is the
+     * same as for DomainCollector::readDomain.
+     *
+     * This class does not require parallel HDF5.
+     */
+    class DistributedDomainCollector : public DomainCollector
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param comm The communicator.
+         * All processes in this communicator must participate in collective reads.
+         * @param maxFileHandles Maximum number of concurrently opened file handles (0=unlimited).
+         */
+        DistributedDomainCollector(MPI_Comm comm, uint32_t maxFileHandles);
+
+        /**
+         * Destructor
+         */
+        virtual ~DistributedDomainCollector();
+
+        /**
+         * Collectively reads the data of a domain from merged files
+         * when every process requests its own (possibly different) domain.
+         *
+         * The domain attributes of all files are read once in parallel
+         * (or from the domain table) and shared by all processes.
+         * Each process receives the same data as from readDomain
+         * for its request. A process which does not need any data passes
+         * an empty request and receives an empty DataContainer but must
+         * still call this function.
+         * Lazy loading is not supported.
+         *
+         * @param id ID of the iteration to read from
+         * @param name name of the dataset
+         * @param requestDomain domain requested by this process
+         * @param dataClass returns the data class of the dataset, may be NULL
+         * @return a new DataContainer, must be deleted by the caller
+         */
+        DataContainer *readDomainCollective(int32_t id,
+                const char* name,
+                const Domain requestDomain,
+                DomDataClass* dataClass) throw (DCException);
+
+    protected:
+        /**
+         * Collectively builds the index for a dataset. Each process reads
+         * the domain attributes of a part of the files.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @return index entry for this dataset
+         */
+        DomainIndexEntry &getDomainIndexCollective(int32_t id,
+                const char* name) throw (DCException);
+
+    private:
+        /**
+         * Internal function for formatting exception messages.
+         *
+         * @param func name of the throwing function
+         * @param msg exception message
+         * @param info optional info text to be appended, e.g. the group name
+         * @return formatted exception message string
+         */
+        static std::string getExceptionString(std::string func, std::string msg,
+                const char *info);
+
+        /**
+         * Throws on all processes if a local operation failed on any process.
+         *
+         * @param func name of the calling function
+         * @param failed true if the operation failed on this process
+         */
+        void checkStatus(std::string func, bool failed) throw (DCException);
+
+        MPI_Comm comm;
+        int mpiRank;
+        int mpiSize;
+    };
+
+}
+
+#endif /* DISTRIBUTEDDOMAINCOLLECTOR_HPP */
@@ -23,11 +23,22 @@
 #ifndef DOMAINCOLLECTOR_HPP
 #define DOMAINCOLLECTOR_HPP
 
+#include <map>
+#include <string>
+#include <vector>
+
 #include "splash/domains/IDomainCollector.hpp"
+#include "splash/domains/DomainAttribute.hpp"
+#include "splash/domains/DomainTable.hpp"
+#include "splash/domains/DomainPageLoader.hpp"
+#include "splash/domains/DomainTileHandler.hpp"
 #include "splash/SerialDataCollector.hpp"
 #include "splash/Dimensions.hpp"
 #include "splash/Selection.hpp"
 #include "splash/DCException.hpp"
+#include "splash/core/ChunkCache.hpp"
+#include "splash/core/DCDataSet.hpp"
+#include "splash/core/DomainIndex.hpp"
 
 namespace splash
 {
@@ -48,7 +59,8 @@ namespace splash
      *
      * \image html domains_serial.jpg
      */
-    class DomainCollector : public IDomainCollector, public SerialDataCollector
+    class DomainCollector : public IDomainCollector, public SerialDataCollector,
+    protected DomainPageLoader
     {
     public:
         /**
@@ -74,8 +86,170 @@ namespace splash
                 DomDataClass* dataClass,
                 bool lazyLoad = false) throw (DCException);
 
+        DataContainer *readDomain(int32_t id,
+                const char* name,
+                Domain domain,
+                Dimensions stride,
+                DomDataClass* dataClass) throw (DCException);
+
         void readDomainLazy(DomainData *domainData) throw (DCException);
 
+        /**
+         * Reads domain-annotated data directly into a buffer of the caller
+         * instead of a new DataContainer.
+         *
+         * Grid data of all intersecting files is written to its position
+         * within the request, elements of the request without data are not
+         * changed. Poly data of all intersecting files is concatenated
+         * in the order of readDomain.
+         * The element at the request offset (Grid) or the first element
+         * (Poly) is written to dstSelect.offset, neighbouring elements are
+         * dstSelect.stride elements apart. dstSelect.count is ignored.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param requestDomain requested domain
+         * @param dstSelect layout of the destination buffer,
+         * which must have the datatype of the dataset
+         * @param sizeRead returns the number of elements in every dimension,
+         * the size of the request (Grid) or the total number of elements (Poly)
+         * @param dst destination buffer, if NULL only sizeRead is returned
+         * to plan the buffer size
+         * @param dataClass returns the data class of the dataset, may be NULL
+         */
+        void readDomainInto(int32_t id,
+                const char* name,
+                const Domain requestDomain,
+                const Selection dstSelect,
+                Dimensions &sizeRead,
+                void* dst,
+                DomDataClass* dataClass = NULL) throw (DCException);
+
+        /**
+         * Reads domain-annotated data in tiles which fit into a memory
+         * budget and passes every tile to a handler as soon as it has been
+         * read, so that requests larger than the available memory can be
+         * reduced or converted out of core.
+         *
+         * Grid tiles never cross file boundaries. A tile is reduced along
+         * the slowest varying dimension first and, for chunked datasets,
+         * starts at a multiple of the chunk size where possible.
+         * Poly data of all intersecting files is split into consecutive
+         * ranges of elements in the order of readDomain.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param requestDomain requested domain
+         * @param maxTileBytes maximum size of one tile in bytes,
+         * must be at least the size of one element
+         * @param handler receives every tile
+         * @param dataClass returns the data class of the dataset, may be NULL
+         * @return number of tiles passed to the handler
+         */
+        size_t readDomainTiled(int32_t id,
+                const char* name,
+                const Domain requestDomain,
+                size_t maxTileBytes,
+                DomainTileHandler &handler,
+                DomDataClass* dataClass = NULL) throw (DCException);
+
+        /**
+         * Reads the Poly data of a species inside a domain, selecting
+         * particles by their positions.
+         *
+         * A particle is selected if its position is in
+         * [offset, offset + size) of \p requestDomain for all dimensions
+         * given by \p positionNames. The selection is computed once per file
+         * and applied to all datasets in \p names, so the DataContainers
+         * contain the same particles in the same order.
+         * Only blocks of the position datasets which may contain selected
+         * particles according to their min/max statistics are read
+         * (see setStatisticsBlockSize), and only the selected parts of
+         * the datasets in \p names.
+         * Particles of files whose domain is completely inside the request
+         * are assumed to be inside and are read without selection.
+         *
+         * @param id ID of the iteration
+         * @param requestDomain requested domain, positions use its coordinates
+         * @param positionNames names of the (Poly) position datasets,
+         * one for each dimension (x, y, z)
+         * @param names names of the (Poly) datasets to read,
+         * may contain position datasets
+         * @param containers returns a new DataContainer for every dataset in
+         * \p names, must be deleted by the caller
+         */
+        void readPolyDomain(int32_t id,
+                const Domain requestDomain,
+                const std::vector<std::string> &positionNames,
+                const std::vector<std::string> &names,
+                std::vector<DataContainer*> &containers) throw (DCException);
+
+        void close();
+
+        /**
+         * Sets the number of threads for reading Grid data
+         * from several files (FAT_READ_MERGED).
+         *
+         * With more than one thread, the raw data of unfiltered datasets
+         * is copied by a pool of worker threads while HDF5 is only called
+         * by the calling thread, e.g. for opening the next file.
+         * Only unfiltered, fully allocated datasets in files without user
+         * block opened with the default (sec2) driver are copied this way.
+         * Other datasets (e.g. compressed, or chunked with HDF5 < 1.10.5)
+         * are still read with HDF5.
+         * Without threads support (see Splash_HAVE_THREADS), the files are
+         * always read one after another.
+         *
+         * @param numThreads number of reading threads, 1 (default) reads
+         * one file after another
+         */
+        void setReadThreads(uint32_t numThreads);
+
+        /**
+         * Sets the page cache for Poly data read with lazyLoad.
+         *
+         * Lazily loaded subdomains allocate no memory, their elements
+         * are read in pages on demand when accessed with
+         * DomainData::getElement, DomainData::readElements or
+         * DataContainer::getElement. The most recently used pages of all
+         * subdomains are kept in a cache which is cleared on close.
+         * readDomainLazy still loads a subdomain completely.
+         *
+         * @param pageSize size of a page in bytes, rounded down to whole elements
+         * @param maxBytes maximum size of all cached pages (default 64 MiB),
+         * 0 disables loading on demand and lazy subdomains are allocated
+         * completely by readDomain
+         */
+        void setLazyPageCache(size_t pageSize, size_t maxBytes);
+
+        /**
+         * Sets the allocator for the buffers of all subdomains
+         * returned by following reads, e.g. an AlignedAllocator for SIMD
+         * loops or a PoolAllocator to reuse the buffers of the previous
+         * iteration. The allocator is not owned by the DomainCollector
+         * and must outlive all returned DataContainers.
+         *
+         * @param allocator allocator or NULL (default) for new[]
+         */
+        void setAllocator(DomainAllocator *allocator);
+
+        /**
+         * Sets the format of the domain information written with
+         * domain data in the following.
+         *
+         * If enabled, the domain information is written as a single
+         * compound attribute DOMCOL_ATTR_DOMAIN, so readers open one
+         * attribute instead of five. Readers prefer this attribute and
+         * fall back to the separate attributes (DOMCOL_ATTR_OFFSET,
+         * DOMCOL_ATTR_SIZE, DOMCOL_ATTR_GLOBAL_OFFSET,
+         * DOMCOL_ATTR_GLOBAL_SIZE and DOMCOL_ATTR_CLASS) for older files.
+         *
+         * @param enabled true to write the packed attribute (default false)
+         * @param writeSeparate true to write the separate attributes as well,
+         * for readers of older versions of libSplash (ignored if not enabled)
+         */
+        void setPackedDomainAttributes(bool enabled, bool writeSeparate = true);
+
         void writeDomain(int32_t id,
                 const CollectionType& type,
                 uint32_t ndims,
@@ -104,6 +278,37 @@ namespace splash
                 const Domain globalDomain,
                 const void *buf) throw (DCException);
 
+        /**
+         * Writes the global domain table for a dataset to the header
+         * group of the currently written file.
+         *
+         * Since the processes of a DomainCollector do not communicate,
+         * the caller gathers the entries of all processes (e.g. with MPI)
+         * and writes the table from the process at MPI position (0, 0, 0).
+         * When reading merged files, readDomain then plans all file accesses
+         * from this table instead of opening every file.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param entries one entry for every file (MPI position)
+         */
+        void writeDomainTable(int32_t id,
+                const char* name,
+                const std::vector<DomainTableEntry> &entries) throw (DCException);
+
+        /**
+         * Reads the global domain table for a dataset
+         * from the file at MPI position (0, 0, 0).
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param entries returns the entries of the table
+         * @return false if the dataset has no domain table
+         */
+        bool readDomainTable(int32_t id,
+                const char* name,
+                std::vector<DomainTableEntry> &entries) throw (DCException);
+
     protected:
         void writeDomainAttributes(
                 int32_t id,
@@ -112,21 +317,179 @@ namespace splash
                 const Domain localDomain,
                 const Domain globalDomain) throw (DCException);
 
-        bool readDomainInfoForRank(
+        /**
+         * Location of the raw data of a file's dataset for threaded reads.
+         * ndims is 0 until the location has been determined, addresses
+         * is empty if the dataset must be read with HDF5.
+         */
+        typedef struct
+        {
+            uint32_t ndims;
+            std::string filename;
+            std::vector<haddr_t> addresses;
+            std::vector<Dimensions> origins;
+            Dimensions extentSize;
+        } RawLocation;
+
+        /**
+         * Domain information of all files for one dataset.
+         */
+        typedef struct
+        {
+            DomainIndex index;
+            DomDataClass dataClass;
+            std::vector<Dimensions> mpiPositions;
+            std::vector<Domain> clientDomains;
+            std::vector<Dimensions> dataSizes;
+            std::vector<RawLocation> rawLocations;
+        } DomainIndexEntry;
+
+        /**
+         * Reads the domain table or the domain attributes of all files
+         * for a dataset once and returns the resulting spatial index.
+         * Indices are kept until the collector is closed.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @return index entry for this dataset
+         */
+        DomainIndexEntry &getDomainIndex(int32_t id,
+                const char* name) throw (DCException);
+
+        /**
+         * Returns the cached index entry for a dataset.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @return index entry or NULL if the index has not been built yet
+         */
+        DomainIndexEntry *findDomainIndex(int32_t id,
+                const char* name);
+
+        /**
+         * Reads the domain table for a dataset if the merged files
+         * have one which matches the MPI topology.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param table returns one entry for every file
+         * @return false if the files must be opened for their domains
+         */
+        bool readMergedDomainTable(int32_t id,
+                const char* name,
+                std::vector<DomainTableEntry> &table) throw (DCException);
+
+        /**
+         * Reads the domain attributes of one file as a table entry.
+         *
+         * @param mpiPosition MPI position of the file
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param entry returns the domain, data size and class of the file
+         */
+        void readFileDomain(Dimensions mpiPosition,
+                int32_t id,
+                const char* name,
+                DomainTableEntry &entry) throw (DCException);
+
+        /**
+         * Builds and caches the index for a dataset from the entries
+         * of all files.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param table one entry for every file
+         * @return index entry for this dataset
+         */
+        DomainIndexEntry &addDomainIndex(int32_t id,
+                const char* name,
+                const std::vector<DomainTableEntry> &table) throw (DCException);
+
+        void readDomainAttributes(
                 Dimensions mpiPosition,
                 int32_t id,
                 const char* name,
-                const Domain requestDomain,
-                Domain &fileDomain) throw (DCException);
+                Domain &clientDomain,
+                Dimensions &dataSize,
+                DomDataClass &dataClass) throw (DCException);
 
-        bool readDomainDataForRank(
+        DataContainer *readDomainInternal(int32_t id,
+                const char* name,
+                const Domain &requestDomain,
+                const Dimensions &stride,
+                DomDataClass* dataClass,
+                bool lazyLoad) throw (DCException);
+
+        void addGridTarget(
                 DataContainer *dataContainer,
-                DomDataClass *dataClass,
                 Dimensions mpiPosition,
                 int32_t id,
                 const char* name,
-                const Domain requestDomain,
-                bool lazyLoad) throw (DCException);
+                const Domain &requestDomain,
+                const Dimensions &stride) throw (DCException);
+
+        /**
+         * Returns the number of elements of a strided selection.
+         *
+         * @param size size of the selected domain
+         * @param stride distance of selected elements
+         * @return ceil(size / stride) in each dimension
+         */
+        static Dimensions getStridedSize(const Dimensions &size,
+                const Dimensions &stride);
+
+        /**
+         * Sorts files by the offsets of their domains, the last dimension
+         * varying slowest, which is the order of subdomains in a
+         * DataContainer returned by readDomain.
+         *
+         * @param files indices of files to be sorted
+         * @param clientDomains domains of all files
+         */
+        static void sortByDomainOffset(std::vector<size_t> &files,
+                const std::vector<Domain> &clientDomains);
+
+        /**
+         * Computes the part of a file's domain which intersects
+         * the requested domain.
+         *
+         * @param clientDomain domain of the file
+         * @param requestDomain requested domain
+         * @param ndims number of dimensions
+         * @param dstOffset returns the offset in the destination buffer
+         * @param srcSize returns the size of the intersection
+         * @param srcOffset returns the offset in the file's dataset
+         */
+        static void getGridIntersection(
+                const Domain &clientDomain,
+                const Domain &requestDomain,
+                uint32_t ndims,
+                Dimensions &dstOffset,
+                Dimensions &srcSize,
+                Dimensions &srcOffset);
+
+        /**
+         * Computes the elements of a file's domain which are selected
+         * by a strided request, i.e. at request offset + n * stride.
+         *
+         * @param clientDomain domain of the file
+         * @param requestDomain requested domain
+         * @param stride distance of requested elements
+         * @param ndims number of dimensions
+         * @param dstOffset returns the offset in the (strided) destination buffer
+         * @param srcSize returns the number of selected elements
+         * @param srcOffset returns the offset of the first selected element
+         * in the file's dataset
+         * @return false if no element of the file is selected
+         */
+        static bool getGridIntersection(
+                const Domain &clientDomain,
+                const Domain &requestDomain,
+                const Dimensions &stride,
+                uint32_t ndims,
+                Dimensions &dstOffset,
+                Dimensions &srcSize,
+                Dimensions &srcOffset);
 
         void readGridInternal(
                 DataContainer *dataContainer,
@@ -134,6 +497,15 @@ namespace splash
                 int32_t id,
                 const char* name,
                 const Domain &clientDomain,
+                const Domain &requestDomain,
+                const Dimensions &stride) throw (DCException);
+
+        void readGridThreaded(
+                DataContainer *dataContainer,
+                DomainIndexEntry &entry,
+                const std::vector<size_t> &files,
+                int32_t id,
+                const char* name,
                 const Domain &requestDomain) throw (DCException);
 
         void readPolyInternal(
@@ -143,8 +515,121 @@ namespace splash
                 const char* name,
                 const Dimensions &dataSize,
                 const Domain &clientDomain,
+                const Dimensions &stride,
                 bool lazyLoad) throw (DCException);
 
+        /**
+         * Reads one block of a file into a buffer.
+         *
+         * @param mpiPosition MPI position of the file
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param select block in the buffer and its offset in the dataset
+         * @param dst destination buffer
+         */
+        void readFileBlock(Dimensions mpiPosition,
+                int32_t id,
+                const char* name,
+                const MultiSelection &select,
+                void* dst) throw (DCException);
+
+        /**
+         * Returns the largest tile of a block which fits into a memory
+         * budget, see readDomainTiled.
+         *
+         * @param size size of the block
+         * @param chunkSize chunk size of the dataset, 0 if not chunked
+         * @param typeSize size of one element in bytes
+         * @param maxTileBytes memory budget in bytes
+         * @return size of the tile
+         */
+        static Dimensions getTileSize(const Dimensions &size,
+                const Dimensions &chunkSize,
+                size_t typeSize,
+                size_t maxTileBytes);
+
+        /**
+         * Ranges [first, second) of element indices of a 1D dataset.
+         */
+        typedef std::vector<std::pair<uint64_t, uint64_t> > ElementRuns;
+
+        /**
+         * Selects the particles of a file by their positions.
+         *
+         * @param mpiPosition MPI position of the file
+         * @param id ID of the iteration
+         * @param positionNames names of the position datasets
+         * @param requestDomain requested domain
+         * @param numElements number of particles in the file
+         * @param indices returns the indices of selected particles in ascending order
+         */
+        void selectPolyElements(
+                Dimensions mpiPosition,
+                int32_t id,
+                const std::vector<std::string> &positionNames,
+                const Domain &requestDomain,
+                uint64_t numElements,
+                std::vector<uint64_t> &indices) throw (DCException);
+
+        /**
+         * Reads selected particles of a file into a new subdomain.
+         *
+         * @param dataContainer container to add the subdomain to
+         * @param mpiPosition MPI position of the file
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param clientDomain domain of the file
+         * @param numElements number of particles in the file
+         * @param indices indices of selected particles in ascending order
+         */
+        void readPolyElements(
+                DataContainer *dataContainer,
+                Dimensions mpiPosition,
+                int32_t id,
+                const char* name,
+                const Domain &clientDomain,
+                uint64_t numElements,
+                const std::vector<uint64_t> &indices) throw (DCException);
+
+        /**
+         * Reads ranges of a 1D dataset into one contiguous buffer.
+         *
+         * @param dataset open dataset
+         * @param runs ranges of elements in ascending order
+         * @param buffer returns the elements of all ranges
+         */
+        static void readElementRuns(DCDataSet &dataset,
+                const ElementRuns &runs,
+                std::vector<uint8_t> &buffer) throw (DCException);
+
+        /**
+         * Combines sorted indices to ranges, ranges with less than
+         * maxGap unselected elements between them are merged.
+         *
+         * @param indices indices in ascending order
+         * @param maxGap maximum number of unselected elements within a range
+         * @param runs returns the ranges
+         */
+        static void getElementRuns(const std::vector<uint64_t> &indices,
+                uint64_t maxGap, ElementRuns &runs);
+
+        static void intersectElementRuns(const ElementRuns &runs1,
+                const ElementRuns &runs2, ElementRuns &result);
+
+        /**
+         * Reads the packed domain attribute DOMCOL_ATTR_DOMAIN of a dataset.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param mpiPosition MPI position of the file when merging, may be NULL
+         * @param attribute returns the domain information
+         * @return false if the dataset has no packed domain attribute
+         */
+        bool readPackedDomainAttribute(int32_t id,
+                const char *name,
+                Dimensions *mpiPosition,
+                DomainAttribute &attribute) throw (DCException);
+
         void readGlobalSizeFallback(int32_t id,
                 const char *dataName,
                 hsize_t* data,
@@ -154,6 +639,41 @@ namespace splash
                 const char *dataName,
                 hsize_t* data,
                 Dimensions *mpiPosition) throw (DCException);
+
+        void* loadElement(DomainData *domainData, size_t index) throw (DCException);
+
+        void loadElements(DomainData *domainData, size_t first, size_t count,
+                void *dst) throw (DCException);
+
+        size_t getLazyPageElements(size_t typeSize);
+
+        /**
+         * Returns a page of a lazy subdomain from the page cache,
+         * reading it on a miss.
+         *
+         * @param domainData lazy subdomain
+         * @param page index of the page
+         * @return page data, valid until the next page is loaded
+         */
+        const uint8_t* loadLazyPage(DomainData *domainData, size_t page)
+        throw (DCException);
+
+        void readLazyElements(DomainData *domainData, size_t first, size_t count,
+                void *dst) throw (DCException);
+
+        // allocator for subdomain buffers, not owned
+        DomainAllocator *allocator;
+
+    private:
+        std::map<std::pair<int32_t, std::string>, DomainIndexEntry> domainIndices;
+        uint32_t readThreads;
+        size_t lazyPageSize;
+        ChunkCache lazyPageCache;
+        // page which does not fit into the cache
+        std::vector<uint8_t> lazyPage;
+        // write DOMCOL_ATTR_DOMAIN and/or the separate attributes
+        bool packedDomainAttributes;
+        bool separateDomainAttributes;
     };
 
 }
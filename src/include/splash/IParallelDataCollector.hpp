@@ -168,12 +168,36 @@ namespace splash
                 const char *name,
                 const void *buf) = 0;
 
+        /**
+         * Collectively appends 1-dimensional data.
+         *
+         * Each process passes its local number of elements only,
+         * offsets are computed from the MPI rank order.
+         * The target dataset is created if necessary.
+         *
+         * @param id ID for iteration.
+         * @param type Type information for data.
+         * @param count Number of local elements to append.
+         * @param name Name for the dataset to create/append.
+         * @param buf Buffer to append.
+         */
         virtual void append(int32_t id,
                 const CollectionType& type,
                 size_t count,
                 const char *name,
                 const void *buf) = 0;
 
+        /**
+         * Collectively appends 1-dimensional data using striding.
+         *
+         * @param id ID for iteration.
+         * @param type Type information for data.
+         * @param count Number of local elements to append.
+         * @param offset Offset in elements to start reading from in \p buf.
+         * @param stride Striding to be used for reading from \p buf, 1 means 'no striding'.
+         * @param name Name for the dataset to create/append.
+         * @param buf Buffer to append.
+         */
         virtual void append(int32_t id,
                 const CollectionType& type,
                 size_t count,
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ITERATIONREADER_HPP
+#define ITERATIONREADER_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "splash/DCException.hpp"
+#include "splash/Dimensions.hpp"
+#include "splash/SerialDataCollector.hpp"
+
+namespace splash
+{
+
+    class GridReadPool;
+
+    /**
+     * Reads the same datasets of all iterations of a file in ascending
+     * order of their IDs.
+     *
+     * While the caller processes an iteration, the requested datasets of
+     * the next iteration are read in a background thread.
+     * Background reads use the raw file offsets determined by HDF5
+     * (see SerialDataCollector::getRawLocation) and never call HDF5,
+     * so they do not require a thread-safe HDF5 library.
+     * Datasets which must be read with HDF5 (e.g. compressed datasets)
+     * are read synchronously in next(), as are all datasets if the
+     * library was built without threads support.
+     *
+     * The collector must be opened with FAT_READ and must not be closed
+     * while the reader exists.
+     *
+     * Example:
+     * \code
+     * IterationReader reader(dc, names);
+     * while (reader.next())
+     *     process(reader.getID(), (float*) reader.getData("field"));
+     * \endcode
+     */
+    class IterationReader
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param dc collector opened for reading
+         * @param names names of the datasets to read in every iteration
+         * @param maxPrefetchBytes maximum size of all datasets of one
+         * iteration for reading it in the background, larger iterations
+         * are read synchronously
+         */
+        IterationReader(SerialDataCollector &dc,
+                const std::vector<std::string> &names,
+                size_t maxPrefetchBytes = 256 * 1024 * 1024) throw (DCException);
+
+        /**
+         * Destructor, waits for running background reads.
+         */
+        virtual ~IterationReader();
+
+        /**
+         * Advances to the next iteration and starts reading the
+         * iteration after it.
+         *
+         * @return false if there are no more iterations
+         */
+        bool next() throw (DCException);
+
+        /**
+         * @return ID of the current iteration
+         */
+        int32_t getID() const throw (DCException);
+
+        /**
+         * Returns the data of a dataset in the current iteration.
+         * The buffer is valid until the next call of next().
+         *
+         * @param name name of the dataset
+         * @return pointer to the data, NULL for empty datasets
+         */
+        void* getData(const std::string &name) throw (DCException);
+
+        /**
+         * Returns the size of a dataset in the current iteration.
+         *
+         * @param name name of the dataset
+         * @return size in elements
+         */
+        Dimensions getSize(const std::string &name) throw (DCException);
+
+        /**
+         * @return number of iterations in the file
+         */
+        size_t getNumIterations() const;
+
+        /**
+         * @return number of datasets which have been read in the background
+         */
+        size_t getNumPrefetched() const;
+
+    private:
+
+        typedef struct
+        {
+            std::vector<uint8_t> buffer;
+            Dimensions size;
+            size_t typeSize;
+            bool planned;
+            GridReadPool *pool;
+        } Slot;
+
+        void plan(std::vector<Slot> &slots, int32_t id);
+
+        void complete(std::vector<Slot> &slots, int32_t id) throw (DCException);
+
+        static void cancel(std::vector<Slot> &slots);
+
+        size_t getSlot(const std::string &name) const throw (DCException);
+
+        SerialDataCollector &dc;
+        std::vector<std::string> names;
+        std::vector<int32_t> ids;
+        size_t maxPrefetchBytes;
+
+        bool started;
+        // index of the current iteration
+        size_t position;
+        std::vector<Slot> current;
+        std::vector<Slot> prefetched;
+        size_t numPrefetched;
+    };
+
+}
+
+#endif /* ITERATIONREADER_HPP */
@@ -0,0 +1,170 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEMBERVIEW_HPP
+#define MEMBERVIEW_HPP
+
+#include <stddef.h>
+#include <string>
+
+#include "splash/CollectionType.hpp"
+#include "splash/DCException.hpp"
+#include "splash/Selection.hpp"
+#include "splash/basetypes/ColTypeRecord.hpp"
+
+namespace splash
+{
+
+    /**
+     * Datatype of one member (component) of the elements of an
+     * interleaved buffer, e.g. the y-component of a float3 field:
+     * \code
+     * MemberView y(ColTypeFloat(), sizeof (float3), offsetof(float3, y));
+     * dc.write(id, y, 3, Selection(size), "field_y", field);
+     * \endcode
+     *
+     * Writing with a MemberView creates a dataset of the member type and
+     * lets HDF5 gather the member directly from \p buf, selections count
+     * whole elements (records) of the buffer.
+     * Offset and size of the record must be multiples of the member size.
+     */
+    class MemberView : public CollectionType
+    {
+    public:
+
+        /**
+         * Constructor
+         *
+         * @param memberType datatype of the member
+         * @param recordSize size of the elements of the buffer in bytes
+         * @param memberOffset offset of the member in the elements in bytes
+         */
+        MemberView(const CollectionType& memberType, size_t recordSize,
+                size_t memberOffset) throw (DCException) :
+        CollectionType(H5Tcopy(memberType.getDataType())),
+        recordSize(recordSize),
+        memberOffset(memberOffset),
+        memberSize(memberType.getSize())
+        {
+            checkAlignment();
+        }
+
+        /**
+         * Constructor
+         *
+         * @param record record type of the elements of the buffer
+         * @param memberName name of the member in \p record
+         */
+        MemberView(const ColTypeRecord& record, const std::string memberName)
+        throw (DCException) :
+        recordSize(record.getSize()),
+        memberOffset(0),
+        memberSize(0)
+        {
+            for (size_t i = 0; i < record.getNumMembers(); ++i)
+            {
+                const ColTypeRecord::Member &member = record.getMember(i);
+                if (member.name == memberName)
+                {
+                    this->type = H5Tcopy(member.type);
+                    memberOffset = member.offset;
+                    memberSize = member.size;
+                    break;
+                }
+            }
+
+            if (memberSize == 0)
+                throw DCException(std::string("Exception for MemberView: "
+                    "no such record member (") + memberName + std::string(")"));
+
+            checkAlignment();
+        }
+
+        ~MemberView()
+        {
+            H5Tclose(this->type);
+        }
+
+        size_t getSize() const
+        {
+            return memberSize;
+        }
+
+        std::string toString() const
+        {
+            return "MemberView";
+        }
+
+        size_t getRecordSize() const
+        {
+            return recordSize;
+        }
+
+        size_t getMemberOffset() const
+        {
+            return memberOffset;
+        }
+
+        /**
+         * Converts a selection of elements of the buffer to a
+         * selection of members in units of the member size.
+         *
+         * @param select selection of elements (records)
+         * @return selection of members
+         */
+        Selection getMemberSelection(const Selection select) const
+        {
+            const size_t members = recordSize / memberSize;
+
+            Selection member_select(select);
+            member_select.size[0] *= members;
+            member_select.offset[0] = member_select.offset[0] * members +
+                    memberOffset / memberSize;
+            member_select.stride[0] *= members;
+
+            return member_select;
+        }
+
+    private:
+        // owns its HDF5 datatype and cannot be copied
+        MemberView(const MemberView&);
+        MemberView& operator=(const MemberView&);
+
+        void checkAlignment() throw (DCException)
+        {
+            if (memberSize == 0 || memberOffset + memberSize > recordSize ||
+                    recordSize % memberSize != 0 || memberOffset % memberSize != 0)
+            {
+                H5Tclose(this->type);
+                throw DCException("Exception for MemberView: "
+                        "member must be aligned to its size within the record");
+            }
+        }
+
+        size_t recordSize;
+        size_t memberOffset;
+        size_t memberSize;
+    };
+
+}
+
+#endif /* MEMBERVIEW_HPP */
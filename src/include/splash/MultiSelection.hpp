@@ -0,0 +1,162 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MULTISELECTION_HPP
+#define MULTISELECTION_HPP
+
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "Dimensions.hpp"
+
+namespace splash
+{
+
+    /**
+     * Set of disjoint blocks which are transferred between one buffer and
+     * one dataset in a single (collective) operation.
+     *
+     * Each block is a hyperslab in the buffer (like a Selection) together
+     * with its offset in the dataset. Blocks must not overlap in the dataset.
+     */
+    class MultiSelection
+    {
+    public:
+
+        /**
+         * A single block of a MultiSelection.
+         */
+        class Block
+        {
+        public:
+
+            Block(Dimensions count_, Dimensions bufferOffset_,
+                    Dimensions datasetOffset_, Dimensions bufferStride_) :
+            count(count_),
+            bufferOffset(bufferOffset_),
+            datasetOffset(datasetOffset_),
+            bufferStride(bufferStride_)
+            {
+
+            }
+
+            std::string toString(void) const
+            {
+                std::stringstream stream;
+                stream <<
+                        "{count=" << count.toString() <<
+                        ", bufferOffset=" << bufferOffset.toString() <<
+                        ", datasetOffset=" << datasetOffset.toString() <<
+                        ", bufferStride=" << bufferStride.toString() << "}";
+                return stream.str();
+            }
+
+            /** number of elements in every dimension */
+            Dimensions count;
+            /** offset of the block within the buffer */
+            Dimensions bufferOffset;
+            /** offset of the block within the dataset */
+            Dimensions datasetOffset;
+            /** stride of the block within the buffer */
+            Dimensions bufferStride;
+        };
+
+        /**
+         * Constructor
+         *
+         * @param size_ size of the buffer
+         */
+        explicit MultiSelection(Dimensions size_) :
+        size(size_)
+        {
+
+        }
+
+        /**
+         * Adds a block.
+         *
+         * @param count size of the block
+         * @param bufferOffset offset of the block within the buffer
+         * @param datasetOffset offset of the block within the dataset
+         */
+        void add(Dimensions count, Dimensions bufferOffset, Dimensions datasetOffset)
+        {
+            blocks.push_back(Block(count, bufferOffset, datasetOffset,
+                    Dimensions(1, 1, 1)));
+        }
+
+        /**
+         * Adds a block with a stride in the buffer.
+         *
+         * @param count size of the block
+         * @param bufferOffset offset of the block within the buffer
+         * @param datasetOffset offset of the block within the dataset
+         * @param bufferStride stride of the block within the buffer
+         */
+        void add(Dimensions count, Dimensions bufferOffset, Dimensions datasetOffset,
+                Dimensions bufferStride)
+        {
+            blocks.push_back(Block(count, bufferOffset, datasetOffset, bufferStride));
+        }
+
+        /**
+         * Returns the total number of elements of all blocks.
+         *
+         * @return number of elements
+         */
+        size_t getNumElements() const
+        {
+            size_t elements = 0;
+            for (std::vector<Block>::const_iterator iter = blocks.begin();
+                    iter != blocks.end(); ++iter)
+                elements += iter->count.getScalarSize();
+
+            return elements;
+        }
+
+        /**
+         * Create a string representation of this selection
+         *
+         * @return string representation
+         */
+        std::string toString(void) const
+        {
+            std::stringstream stream;
+            stream << "{size=" << size.toString() << ", blocks=[";
+            for (size_t i = 0; i < blocks.size(); ++i)
+            {
+                if (i > 0)
+                    stream << ", ";
+                stream << blocks[i].toString();
+            }
+            stream << "]}";
+            return stream.str();
+        }
+
+        Dimensions size;
+        std::vector<Block> blocks;
+    };
+
+}
+
+#endif /* MULTISELECTION_HPP */
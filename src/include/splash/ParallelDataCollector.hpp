@@ -28,19 +28,24 @@
 #include <string>
 #include <iostream>
 #include <set>
+#include <map>
 #include <hdf5.h>
 
 #include "splash/IParallelDataCollector.hpp"
 
 #include "splash/DCException.hpp"
+#include "splash/MultiSelection.hpp"
 #include "splash/sdc_defines.hpp"
 #include "splash/pdc_defines.hpp"
+#include "splash/TransferPolicy.hpp"
 #include "splash/core/HandleMgr.hpp"
+#include "splash/core/IterationIndex.hpp"
 
 namespace splash
 {
 
     class DCGroup;
+    class DCParallelDataSet;
 
     /**
      * Realizes an IParallelDataCollector which creates a single HDF5 file per iteration
@@ -88,6 +93,11 @@ namespace splash
             bool enableCompression;
             // id for maximum accessed iteration
             int32_t maxID;
+            // collective/independent transfer selection
+            TransferPolicy transferPolicy;
+            // iterations of the file set and the file persisting them
+            IterationIndex iterationIndex;
+            std::string iterationIndexFilename;
         } Options;
 
         /**
@@ -112,6 +122,9 @@ namespace splash
         // filename passed to PDC
         std::string baseFilename;
 
+        // last transfer per dataset, key is 'id/name'
+        std::map<std::string, TransferReport> transferReports;
+
         static void writeHeader(hid_t fHandle, uint32_t id,
                 bool enableCompression, Dimensions mpiTopology) throw (DCException);
 
@@ -121,6 +134,22 @@ namespace splash
         static void fileOpenCallback(H5Handle handle, uint32_t index,
                 void *userData) throw (DCException);
 
+        /**
+         * Loads the iteration index on rank 0 and broadcasts it.
+         * If no valid index exists, rank 0 scans the directory instead.
+         * Must be called by all processes.
+         *
+         * @param persist Write a scanned index to disk on next flush.
+         * @param requireDirectory Throw if the directory cannot be scanned.
+         */
+        void loadIterationIndex(bool persist, bool requireDirectory) throw (DCException);
+
+        /**
+         * Appends pending changes of the iteration index to disk (rank 0 only).
+         * On failure, the index file is removed to force directory scans.
+         */
+        static void flushIterationIndex(Options &options);
+
         void openCreate(const char *filename,
                 FileCreationAttr &attr) throw (DCException);
 
@@ -151,6 +180,21 @@ namespace splash
                 uint32_t& srcRank,
                 void* dst) throw (DCException);
 
+        /**
+         * Internal reading method for every srcStride-th element.
+         */
+        void readDataSet(H5Handle h5File,
+                int32_t id,
+                const char* name,
+                const Dimensions dstBuffer,
+                const Dimensions dstOffset,
+                const Dimensions srcSize,
+                const Dimensions srcOffset,
+                const Dimensions srcStride,
+                Dimensions &sizeRead,
+                uint32_t& srcRank,
+                void* dst) throw (DCException);
+
         void writeDataSet(
                 H5Handle group,
                 const Dimensions globalSize,
@@ -159,11 +203,44 @@ namespace splash
                 uint32_t rank,
                 const Selection srcSelect,
                 const char* name,
-                const void* data) throw (DCException);
+                const void* data,
+                TransferReport &report) throw (DCException);
+
+        void writeDataSet(
+                H5Handle group,
+                const Dimensions globalSize,
+                const CollectionType& datatype,
+                uint32_t rank,
+                const MultiSelection &select,
+                const char* name,
+                const void* data,
+                TransferReport &report) throw (DCException);
 
         void gatherMPIWrites(int rank, const Dimensions localSize,
                 Dimensions &globalSize, Dimensions &globalOffset) throw (DCException);
 
+        /**
+         * Computes the total number of elements appended by all processes
+         * and the offset of the calling process within them (rank order).
+         *
+         * @param localCount Number of elements appended by this process.
+         * @param globalCount Returns the sum of all localCount.
+         * @param globalOffset Returns the sum of localCount of all lower ranks.
+         */
+        void gatherMPIAppends(size_t localCount,
+                size_t &globalCount, size_t &globalOffset) throw (DCException);
+
+        void appendDataSet(H5Handle group,
+                const CollectionType& datatype,
+                size_t count,
+                size_t offset,
+                size_t stride,
+                size_t globalCount,
+                size_t globalOffset,
+                const char* name,
+                const void* data,
+                TransferReport &report) throw (DCException);
+
         /**
          * Returns the number of dimensions for a dataset.
          * @param h5File File handle.
@@ -181,7 +258,34 @@ namespace splash
                 const CollectionType& type,
                 const char* name) throw (DCException);
 
+        /**
+         * Selects the write transfer mode of a dataset
+         * according to the current TransferPolicy.
+         * Must be called by all processes.
+         *
+         * @param dataset Dataset to configure.
+         * @param localBytes Number of bytes written by this process.
+         * @param globalBytes Number of bytes written by all processes.
+         * @param filtered True if the dataset uses filters.
+         */
+        void selectWriteTransfer(DCParallelDataSet &dataset,
+                uint64_t localBytes,
+                uint64_t globalBytes,
+                bool filtered) throw (DCException);
+
+        /**
+         * Stores and logs the transfer report of the last
+         * write or read of a dataset.
+         */
+        void storeTransferReport(int32_t id,
+                const char* name,
+                const TransferReport &report);
+
     public:
+        // typed write<T> and read<T>
+        using DataCollector::write;
+        using DataCollector::read;
+
         /**
          * Constructor
          *
@@ -228,6 +332,28 @@ namespace splash
                 const char* name,
                 const void* buf);
 
+        /**
+         * Collectively writes several blocks of a buffer to one dataset
+         * in a single transfer, e.g. all AMR patches of a process.
+         * Each process may pass a different number of blocks, including none.
+         *
+         * @param id ID for iteration.
+         * @param globalSize Size of the dataset, identical on all processes.
+         * @param type Type information for data.
+         * @param rank Number of dimensions (1-3) of the data.
+         * @param select Blocks in \p buf and their offsets in the dataset.
+         * Blocks of all processes must not overlap in the dataset.
+         * @param name Name for the dataset.
+         * @param buf Buffer for writing.
+         */
+        void write(int32_t id,
+                const Dimensions globalSize,
+                const CollectionType& type,
+                uint32_t rank,
+                const MultiSelection &select,
+                const char* name,
+                const void* buf) throw (DCException);
+
         void reserve(int32_t id,
                 const Dimensions globalSize,
                 uint32_t rank,
@@ -249,6 +375,48 @@ namespace splash
                 const char *name,
                 const void *buf);
 
+        /**
+         * Collectively appends 1-dimensional data.
+         *
+         * Each process passes only its local number of elements.
+         * The target dataset is created if necessary, otherwise it is
+         * extended by the sum of all counts. Processes write in rank order
+         * using a single collective transfer.
+         * All processes must call this function.
+         *
+         * @param id ID for iteration.
+         * @param type Type information for data.
+         * @param count Number of local elements to append, may be 0.
+         * @param name Name for the dataset to create/append.
+         * @param buf Buffer to append.
+         */
+        void append(int32_t id,
+                const CollectionType& type,
+                size_t count,
+                const char *name,
+                const void *buf) throw (DCException);
+
+        /**
+         * Collectively appends 1-dimensional data using striding.
+         *
+         * See \ref append(int32_t, const CollectionType&, size_t, const char*, const void*).
+         *
+         * @param id ID for iteration.
+         * @param type Type information for data.
+         * @param count Number of local elements to append, may be 0.
+         * @param offset Offset in elements to start reading from in \p buf.
+         * @param stride Striding to be used for reading from \p buf, 1 means 'no striding'.
+         * @param name Name for the dataset to create/append.
+         * @param buf Buffer to append.
+         */
+        void append(int32_t id,
+                const CollectionType& type,
+                size_t count,
+                size_t offset,
+                size_t stride,
+                const char *name,
+                const void *buf) throw (DCException);
+
         void remove(int32_t id) throw (DCException);
 
         void remove(int32_t id,
@@ -366,8 +534,52 @@ namespace splash
                 Dimensions &sizeRead,
                 void* buf) throw (DCException);
 
+        /**
+         * Collectively reads several blocks of one dataset into a buffer
+         * in a single transfer.
+         * Each process may pass a different number of blocks, including none.
+         *
+         * @param id ID for iteration.
+         * @param name Name for the dataset.
+         * @param select Blocks in \p buf and their offsets in the dataset.
+         * @param buf Buffer to read to, must hold \p select.size elements.
+         */
+        void read(int32_t id,
+                const char* name,
+                const MultiSelection &select,
+                void* buf) throw (DCException);
+
         void finalize(void);
 
+        /**
+         * Sets the policy for choosing collective or independent
+         * transfers. The policy must be identical on all processes.
+         *
+         * @param policy New transfer policy.
+         */
+        void setTransferPolicy(const TransferPolicy &policy);
+
+        /**
+         * Returns the current transfer policy.
+         *
+         * @return Transfer policy.
+         */
+        const TransferPolicy& getTransferPolicy() const;
+
+        /**
+         * Returns the transfer mode which was requested and actually
+         * used by HDF5 for the last write or read of a dataset
+         * since the file was opened.
+         *
+         * @param id ID for iteration.
+         * @param name Name of the dataset.
+         * @param report Returns the transfer report.
+         * @return True if a report for this dataset exists.
+         */
+        bool getTransferReport(int32_t id,
+                const char* name,
+                TransferReport &report) const;
+
     private:
 
         /* Invalid methods from DataCollector. Do NOT call! */
@@ -387,20 +599,6 @@ namespace splash
                 const Dimensions /*dims*/,
                 const void* /*data*/) throw (DCException);
 
-        void append(int32_t /*id*/,
-                const CollectionType& /*type*/,
-                size_t /*count*/,
-                const char* /*name*/,
-                const void* /*data*/) throw (DCException);
-
-        void append(int32_t /*id*/,
-                const CollectionType& /*type*/,
-                size_t /*count*/,
-                size_t /*offset*/,
-                size_t /*stride*/,
-                const char* /*name*/,
-                const void* /*data*/) throw (DCException);
-
         void createReference(int32_t /*srcID*/,
                 const char* /*srcName*/,
                 int32_t /*dstID*/,
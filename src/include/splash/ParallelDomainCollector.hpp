@@ -23,7 +23,11 @@
 #ifndef PARALLELDOMAINCOLLECTOR_HPP
 #define PARALLELDOMAINCOLLECTOR_HPP
 
+#include <vector>
+
 #include "splash/domains/IParallelDomainCollector.hpp"
+#include "splash/domains/DomainAttribute.hpp"
+#include "splash/domains/DomainTable.hpp"
 #include "splash/ParallelDataCollector.hpp"
 
 namespace splash
@@ -53,6 +57,35 @@ namespace splash
                 const Domain localDomain,
                 const Domain globalDomain);
 
+        /**
+         * Reads the packed domain attribute DOMCOL_ATTR_DOMAIN of a dataset.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param attribute returns the domain information
+         * @return false if the dataset has no packed domain attribute
+         */
+        bool readPackedDomainAttribute(int32_t id,
+                const char *name,
+                DomainAttribute &attribute) throw (DCException);
+
+        /**
+         * Reads the domain information of a dataset, preferring the packed
+         * attribute DOMCOL_ATTR_DOMAIN over the separate attributes.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param attribute returns the domain information
+         */
+        void readDomainAttribute(int32_t id,
+                const char *name,
+                DomainAttribute &attribute) throw (DCException);
+
+        bool domainTableEnabled;
+        // write DOMCOL_ATTR_DOMAIN and/or the separate attributes
+        bool packedDomainAttributes;
+        bool separateDomainAttributes;
+
     public:
         /**
          * Constructor
@@ -97,8 +130,81 @@ namespace splash
                 DomDataClass* dataClass,
                 bool lazyLoad = false) throw (DCException);
 
+        DataContainer *readDomain(int32_t id,
+                const char* name,
+                const Domain requestDomain,
+                const Dimensions stride,
+                DomDataClass* dataClass) throw (DCException);
+
         void readDomainLazy(DomainData *domainData) throw (DCException);
 
+        /**
+         * Collectively reads the data of a domain when every process
+         * requests its own (possibly different) subdomain,
+         * e.g. for restarting with a different domain decomposition
+         * or number of processes.
+         *
+         * Metadata is read once and broadcasted, the requests of all
+         * processes are combined into a global read plan and each
+         * process takes part in one collective transfer.
+         * For Grid data, each process receives the intersection of its
+         * request with the domain of the dataset.
+         * For Poly data, the dataset is read in disjoint parts by all
+         * processes which request an intersecting domain and
+         * redistributed among them, so each of these processes receives
+         * all Poly data.
+         * A process with an empty or non-intersecting request receives an
+         * empty DataContainer but must still call this function.
+         *
+         * @param id ID of the iteration to read from
+         * @param name name of the dataset
+         * @param requestDomain domain requested by this process
+         * @param dataClass returns the data class of the dataset, may be NULL
+         * @return a new DataContainer, must be deleted by the caller
+         */
+        DataContainer *readDomainCollective(int32_t id,
+                const char* name,
+                const Domain requestDomain,
+                DomDataClass* dataClass) throw (DCException);
+
+        /**
+         * Enables or disables collecting the global domain table
+         * in writeDomain and appendDomain (disabled by default).
+         *
+         * If enabled, every process adds a row with its MPI position,
+         * absolute domain, data offset and number of elements to a table
+         * dataset in the header group of the file.
+         * writeDomain replaces the table, appendDomain extends it.
+         * Local domains passed to writeDomain and appendDomain must then
+         * be set correctly for every process.
+         *
+         * @param enabled true to write domain tables
+         */
+        void setDomainTableEnabled(bool enabled);
+
+        /**
+         * Sets the format of the domain information written with
+         * domain data in the following, see
+         * DomainCollector::setPackedDomainAttributes.
+         *
+         * @param enabled true to write the packed attribute (default false)
+         * @param writeSeparate true to write the separate attributes as well
+         */
+        void setPackedDomainAttributes(bool enabled, bool writeSeparate = true);
+
+        /**
+         * Reads the global domain table for a dataset.
+         * All processes must call this function.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param entries returns the entries of the table
+         * @return false if the dataset has no domain table
+         */
+        bool readDomainTable(int32_t id,
+                const char* name,
+                std::vector<DomainTableEntry> &entries) throw (DCException);
+
         void writeDomain(int32_t id,
                 const CollectionType& type,
                 uint32_t ndims,
@@ -138,16 +244,15 @@ namespace splash
                 const Domain domain,
                 DomDataClass dataClass) throw (DCException);
 
-    protected:
-
-        bool readDomainDataForRank(
-                DataContainer *dataContainer,
-                DomDataClass *dataClass,
-                int32_t id,
-                const char* name,
-                const Domain requestDomain,
-                bool lazyLoad) throw (DCException);
-
+        /**
+         * Collectively appends Poly data with annotated domain information.
+         *
+         * Each process passes only its local number of elements, the
+         * offsets of all processes follow the MPI rank order.
+         * \p localDomain is ignored since all processes share one file,
+         * the local domain attribute is set to the size of \p globalDomain.
+         * All processes must call this function.
+         */
         void appendDomain(int32_t id,
                 const CollectionType& type,
                 size_t count,
@@ -166,6 +271,52 @@ namespace splash
                 const Domain globalDomain,
                 const void *buf) throw (DCException);
 
+    protected:
+
+        /**
+         * Collectively adds the row of this process to the domain table
+         * of a dataset.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param entry table entry of this process
+         * @param replace if true, an existing table is replaced
+         */
+        void appendDomainTableRow(int32_t id,
+                const char* name,
+                const DomainTableEntry &entry,
+                bool replace) throw (DCException);
+
+        bool readDomainDataForRank(
+                DataContainer *dataContainer,
+                DomDataClass *dataClass,
+                int32_t id,
+                const char* name,
+                const Domain requestDomain,
+                const Dimensions stride,
+                bool lazyLoad) throw (DCException);
+
+        void readGridCollective(
+                DataContainer *dataContainer,
+                int32_t id,
+                const char* name,
+                const Domain requestDomain,
+                const Domain clientDomain,
+                uint32_t ndims,
+                size_t datatypeSize,
+                DCDataType datatype,
+                bool intersects) throw (DCException);
+
+        void readPolyCollective(
+                DataContainer *dataContainer,
+                int32_t id,
+                const char* name,
+                const Domain clientDomain,
+                const Dimensions dataElements,
+                uint32_t ndims,
+                size_t datatypeSize,
+                DCDataType datatype,
+                const std::vector<bool> &intersects) throw (DCException);
     };
 
 }
@@ -26,9 +26,13 @@
 #include <hdf5.h>
 #include <sstream>
 #include <iostream>
+#include <vector>
 
 #include "splash/DataCollector.hpp"
 #include "splash/DCException.hpp"
+#include "splash/basetypes/ColTypeRecord.hpp"
+#include "splash/core/AttributeCache.hpp"
+#include "splash/core/ChunkCache.hpp"
 #include "splash/core/HandleMgr.hpp"
 #include "splash/sdc_defines.hpp"
 
@@ -84,6 +88,19 @@ namespace splash
          */
         std::string getExceptionString(std::string func, std::string msg, const char *info = NULL);
 
+        static void copyChunkSlice(const uint8_t *chunk,
+                const Dimensions chunkSize, const Dimensions chunkOffset,
+                uint8_t *slice, const Dimensions sliceSize,
+                const Dimensions sliceOffset, const Dimensions count,
+                size_t typeSize);
+
+        void removeStatistics(const std::string &path, const std::string &name)
+        throw (DCException);
+
+        void writeStatistics(int32_t id, const CollectionType& type, uint32_t ndims,
+                const Selection select, const char* name, hid_t group,
+                const std::string &dsetName, const void* data) throw (DCException);
+
         static herr_t visitObjCallback(hid_t o_id, const char *name,
                 const H5O_info_t *object_info, void *op_data);
 
@@ -91,6 +108,15 @@ namespace splash
         /** @return H5 object id if name!=NULL, else -1 */
         hid_t openGroup(DCGroup& group, int32_t id, const char* name,
                 Dimensions *mpiPosition = NULL) throw (DCException);
+        /**
+         * Opens the object for writing attributes, missing groups are created.
+         *
+         * @return H5 object id if name!=NULL, else -1 (use the iteration group)
+         */
+        hid_t openCreateGroup(DCGroup& group, int32_t id, const char* name) throw (DCException);
+        /** @return key of an object in the attribute cache */
+        std::string getAttributeCacheKey(int32_t id, const char* name,
+                Dimensions *mpiPosition) const;
 
     protected:
 
@@ -120,6 +146,18 @@ namespace splash
         // enable data compression
         bool enableCompression;
 
+        // decoded chunks for readSlice
+        ChunkCache sliceCache;
+
+        // attributes of objects in files opened for reading
+        AttributeCache attributeCache;
+
+        // number of attributes read from files by readAttributesInternal
+        uint64_t attributeReads;
+
+        // elements per block of min/max statistics, 0 = disabled
+        size_t statisticsBlockSize;
+
         void openCreate(const char *filename,
                 FileCreationAttr &attr) throw (DCException);
 
@@ -185,6 +223,21 @@ namespace splash
                 uint32_t& srcDims,
                 void* dst) throw (DCException);
 
+        /**
+         * Internal reading method for every srcStride-th element.
+         */
+        void readDataSet(H5Handle h5File,
+                int32_t id,
+                const char* name,
+                const Dimensions dstBuffer,
+                const Dimensions dstOffset,
+                const Dimensions srcSize,
+                const Dimensions srcOffset,
+                const Dimensions srcStride,
+                Dimensions& sizeRead,
+                uint32_t& srcDims,
+                void* dst) throw (DCException);
+
         /**
          * Internal meta data reading method.
          */
@@ -213,6 +266,21 @@ namespace splash
                 const char* name,
                 const void* data) throw (DCException);
 
+        /**
+         * Writes one member of the records in \p data to a single DataSet.
+         * The member is gathered in blocks of planes along the slowest
+         * dimension to limit the size of the staging buffer.
+         */
+        void writeMemberDataSet(
+                hid_t group,
+                const CollectionType& memberType,
+                size_t recordSize,
+                size_t memberOffset,
+                uint32_t ndims,
+                const Selection select,
+                const char* name,
+                const void* data) throw (DCException);
+
         /**
          * Basic method for appending data to a 1-dimensional DataSet.
          *
@@ -231,8 +299,30 @@ namespace splash
                 const char *dsetName,
                 Dimensions *mpiPosition = NULL) throw (DCException);
 
+        /**
+         * Reads several attributes of one dataset or group,
+         * see readAttributes.
+         *
+         * @param id ID of the iteration
+         * @param dataName name of the dataset or group, NULL for the iteration group
+         * @param entries attributes to read
+         * @param count number of entries, at least 1
+         * @param mpiPosition MPI position of the file when merging, may be NULL
+         * @param required if true, missing attributes raise an exception
+         * @return false if an attribute does not exist
+         */
+        bool readAttributesInternal(int32_t id,
+                const char *dataName,
+                const DCAttribute::BulkEntry *entries,
+                size_t count,
+                Dimensions *mpiPosition,
+                bool required) throw (DCException);
+
         void closeDatasetHandle(hid_t handle) throw (DCException);
     public:
+        // typed write<T> and read<T>
+        using DataCollector::write;
+        using DataCollector::read;
 
         /**
          * Constructor
@@ -265,6 +355,20 @@ namespace splash
                 const char* name,
                 const void* data) throw (DCException);
 
+        /**
+         * Writes one member of the elements of an interleaved buffer,
+         * see MemberView.
+         * The member is gathered into a small staging buffer block by block
+         * since HDF5 transfers strided memory selections to chunked datasets
+         * element by element.
+         */
+        void write(int32_t id,
+                const MemberView& type,
+                uint32_t ndims,
+                const Selection select,
+                const char* name,
+                const void* data) throw (DCException);
+
         void append(int32_t id,
                 const CollectionType& type,
                 size_t count,
@@ -344,6 +448,80 @@ namespace splash
                 const Dimensions dims,
                 const void *data) throw (DCException);
 
+        /**
+         * Attribute of a bulk read or write,
+         * see readAttributes and writeAttributes.
+         */
+        typedef struct _AttributeEntry
+        {
+            /**
+             * Name of the attribute.
+             */
+            const char *name;
+            /**
+             * Type of the value in memory, values are converted when reading.
+             */
+            const CollectionType *type;
+            /**
+             * Buffer to read into or to write from.
+             */
+            void *data;
+        } AttributeEntry;
+
+        /**
+         * Reads several attributes of one dataset or group in a single call.
+         *
+         * The object is opened once and its attributes are iterated once.
+         * In files opened for reading, the requested attributes of an object
+         * are cached, so later reads of the same attributes are served from
+         * memory, see setAttributeCacheSize. Attributes which are not cached
+         * yet are read from the file.
+         *
+         * @param id ID of the iteration
+         * @param dataName name of the dataset or group, NULL for the iteration group
+         * @param entries attributes to read
+         * @param count number of entries
+         * @param mpiPosition MPI position of the file when merging, may be NULL
+         */
+        void readAttributes(int32_t id,
+                const char *dataName,
+                const AttributeEntry *entries,
+                size_t count,
+                Dimensions *mpiPosition = NULL) throw (DCException);
+
+        /**
+         * Writes several scalar attributes of one dataset or group
+         * in a single call, opening the object once.
+         * Missing groups are created as for writeAttribute.
+         *
+         * @param id ID of the iteration
+         * @param dataName name of the dataset or group, NULL for the iteration group
+         * @param entries attributes to write
+         * @param count number of entries
+         */
+        void writeAttributes(int32_t id,
+                const char *dataName,
+                const AttributeEntry *entries,
+                size_t count) throw (DCException);
+
+        /**
+         * Sets the maximum number of objects whose attributes are cached
+         * by readAttributes in files opened for reading (default 1024).
+         * A size of 0 disables the cache.
+         *
+         * @param maxObjects maximum number of objects
+         */
+        void setAttributeCacheSize(size_t maxObjects);
+
+        /**
+         * Returns the number of attributes read from files by readAttributes
+         * and by reading domain information since construction.
+         * Attributes read from the cache are not counted.
+         *
+         * @return number of attribute reads
+         */
+        uint64_t getNumAttributeReads() const;
+
         void read(int32_t id,
                 const char* name,
                 Dimensions &sizeRead,
@@ -361,6 +539,142 @@ namespace splash
                 const Dimensions dstBuffer,
                 const Dimensions dstOffset,
                 Dimensions &sizeRead) throw (DCException);
+
+        /**
+         * Reads an axis-aligned slice of a dataset,
+         * e.g. the xy-plane at z = \p position of a 3D dataset.
+         *
+         * The slice is read chunk by chunk. Every chunk crossing the
+         * slice is decoded once and kept in a cache of decoded chunks,
+         * so reading neighbouring or repeated slices (e.g. stepping
+         * along the sliced axis) does not read and decompress the
+         * chunks again. Datasets which are not chunked are read with
+         * a single hyperslab selection.
+         * The cache is cleared when the file is closed or modified.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param axis axis normal to the slice, less than the dimensions of the dataset
+         * @param position position of the slice along \p axis
+         * @param sizeRead returns the size of the slice, which is 1 in \p axis
+         * @param data buffer of the size of the slice, may be NULL to query sizeRead
+         */
+        void readSlice(int32_t id,
+                const char* name,
+                uint32_t axis,
+                uint64_t position,
+                Dimensions &sizeRead,
+                void* data) throw (DCException);
+
+        /**
+         * Sets the maximum size of the cache of decoded chunks for readSlice
+         * (default 64 MiB). A size of 0 disables the cache.
+         *
+         * @param maxBytes maximum size in bytes
+         */
+        void setSliceCacheSize(size_t maxBytes);
+
+        /**
+         * Enables min/max statistics for datasets written or appended
+         * in the following (disabled by default).
+         *
+         * The minimum and maximum value of every block of a dataset is
+         * stored in a companion dataset, which lets readRange skip blocks
+         * without matching values. Blocks of 1-dimensional datasets
+         * (e.g. Poly data) have \p blockElements elements, blocks of
+         * multi-dimensional datasets (e.g. Grid data) are the chunks
+         * of the dataset.
+         * Statistics are supported for 32 and 64 bit integer and
+         * floating point data.
+         *
+         * @param blockElements number of elements per block, 0 disables statistics
+         */
+        void setStatisticsBlockSize(size_t blockElements);
+
+        /**
+         * Finds all elements of a dataset with values in [minValue, maxValue].
+         *
+         * Only blocks which may contain matching values according to the
+         * min/max statistics of the dataset are read. Without (up-to-date)
+         * statistics, the complete dataset is read.
+         * Values are compared as double.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param minValue lower bound
+         * @param maxValue upper bound
+         * @param indices returns the indices of all matching elements
+         * in ascending order, elements are counted with x fastest
+         * @return number of elements which have been read
+         */
+        uint64_t readRange(int32_t id,
+                const char* name,
+                double minValue,
+                double maxValue,
+                std::vector<uint64_t> &indices) throw (DCException);
+
+        /**
+         * Returns the location of the raw data of a dataset in the file,
+         * which allows reading it without HDF5, e.g. in another thread.
+         * Only permitted for files opened with FAT_READ.
+         *
+         * @param id ID of the iteration
+         * @param name name of the dataset
+         * @param filename returns the name of the file
+         * @param addresses returns the file offsets of all extents in bytes
+         * @param origins returns the offsets of all extents in the dataset
+         * @param extentSize returns the (allocated) size of every extent
+         * @param size returns the size of the dataset
+         * @param typeSize returns the size of one element in bytes
+         * @return false if the dataset must be read with HDF5,
+         * see DCDataSet::getRawExtents
+         */
+        bool getRawLocation(int32_t id,
+                const char* name,
+                std::string &filename,
+                std::vector<haddr_t> &addresses,
+                std::vector<Dimensions> &origins,
+                Dimensions &extentSize,
+                Dimensions &size,
+                size_t &typeSize) throw (DCException);
+
+        /**
+         * Writes records (array of structs) as one dataset per member
+         * (struct of arrays), named \p name/<member name>.
+         *
+         * Members are transposed in blocks of limited size while writing,
+         * so \p buf does not have to be copied or rearranged by the caller.
+         *
+         * @param id ID for iteration.
+         * @param type Record type of the elements of \p buf.
+         * @param ndims Number of dimensions (1-3).
+         * @param select Selection of records in src buffer
+         * @param name Name of the group for the member datasets.
+         * @param buf Buffer of records for writing.
+         */
+        void writeRecordsSoA(int32_t id,
+                const ColTypeRecord& type,
+                uint32_t ndims,
+                const Selection select,
+                const char* name,
+                const void* buf) throw (DCException);
+
+        /**
+         * Reads records written with writeRecordsSoA into a buffer of
+         * records (array of structs).
+         * All members of \p type must exist and be of equal size.
+         *
+         * @param id ID for iteration.
+         * @param type Record type of the elements of \p buf.
+         * @param name Name of the group of the member datasets.
+         * @param sizeRead Returns the number of records in the file.
+         * @param buf Buffer of records to read to, can be NULL.
+         */
+        void readRecordsSoA(int32_t id,
+                const ColTypeRecord& type,
+                const char* name,
+                Dimensions &sizeRead,
+                void* buf) throw (DCException);
     };
 
 } // namespace DataCollector
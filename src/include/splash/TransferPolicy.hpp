@@ -0,0 +1,221 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSFERPOLICY_HPP
+#define TRANSFERPOLICY_HPP
+
+#include <stdint.h>
+#include <string>
+#include <sstream>
+#include <hdf5.h>
+
+namespace splash
+{
+
+    /**
+     * Policy for choosing between collective and independent
+     * MPI-I/O raw data transfers of parallel datasets.
+     *
+     * In automatic mode, a write is performed independently if the
+     * total amount of data is small or if a few processes write much more
+     * than the average process. Chunked datasets with filters
+     * (compression) always use collective transfers since parallel HDF5
+     * requires this.
+     */
+    class TransferPolicy
+    {
+    public:
+
+        enum Mode
+        {
+            TRANSFER_AUTO, TRANSFER_COLLECTIVE, TRANSFER_INDEPENDENT
+        };
+
+        /**
+         * Constructor
+         */
+        TransferPolicy() :
+        mode(TRANSFER_AUTO),
+        minCollectiveBytes(64 * 1024),
+        maxImbalance(8.0)
+        {
+
+        }
+
+        /**
+         * Decides if a transfer should be collective.
+         * All processes must pass identical values.
+         *
+         * @param globalBytes total number of bytes transferred by all processes
+         * @param maxLocalBytes maximum number of bytes transferred by one process
+         * @param numProcs number of participating processes
+         * @param filtered true if the dataset uses filters, e.g. compression
+         * @return true for collective transfers, false for independent transfers
+         */
+        bool useCollective(uint64_t globalBytes, uint64_t maxLocalBytes,
+                uint32_t numProcs, bool filtered) const
+        {
+            if (filtered)
+                return true;
+
+            switch (mode)
+            {
+                case TRANSFER_COLLECTIVE:
+                    return true;
+                case TRANSFER_INDEPENDENT:
+                    return false;
+                default:
+                    break;
+            }
+
+            if (globalBytes < minCollectiveBytes || numProcs < 2)
+                return false;
+
+            // ratio of largest to average contribution
+            double mean = (double) globalBytes / (double) numProcs;
+            if ((double) maxLocalBytes > maxImbalance * mean)
+                return false;
+
+            return true;
+        }
+
+        /**
+         * Transfer mode selection, default is TRANSFER_AUTO.
+         */
+        Mode mode;
+
+        /**
+         * Total transfer size in bytes below which independent
+         * transfers are used in TRANSFER_AUTO mode.
+         */
+        uint64_t minCollectiveBytes;
+
+        /**
+         * Maximum ratio of the largest to the average per-process
+         * transfer size for collective transfers in TRANSFER_AUTO mode.
+         */
+        double maxImbalance;
+    };
+
+    /**
+     * Transfer mode which was requested and actually used by HDF5
+     * for the last raw data transfer of a parallel dataset.
+     */
+    class TransferReport
+    {
+    public:
+
+        /**
+         * Constructor
+         */
+        TransferReport() :
+        collectiveRequested(false),
+        actualMode(H5D_MPIO_NO_COLLECTIVE),
+        localNoCollectiveCause(0),
+        globalNoCollectiveCause(0)
+        {
+
+        }
+
+        /**
+         * Returns true if collective I/O was requested but HDF5 fell back
+         * to independent I/O on at least one process.
+         *
+         * @return true if collective I/O was broken
+         */
+        bool isCollectiveBroken() const
+        {
+            return collectiveRequested && (globalNoCollectiveCause != 0);
+        }
+
+        std::string toString() const
+        {
+            std::stringstream stream;
+            stream << "requested=" <<
+                    (collectiveRequested ? "collective" : "independent") <<
+                    " actual=";
+
+            switch (actualMode)
+            {
+                case H5D_MPIO_NO_COLLECTIVE:
+                    stream << "no_collective";
+                    break;
+                case H5D_MPIO_CHUNK_INDEPENDENT:
+                    stream << "chunk_independent";
+                    break;
+                case H5D_MPIO_CHUNK_COLLECTIVE:
+                    stream << "chunk_collective";
+                    break;
+                case H5D_MPIO_CHUNK_MIXED:
+                    stream << "chunk_mixed";
+                    break;
+                case H5D_MPIO_CONTIGUOUS_COLLECTIVE:
+                    stream << "contiguous_collective";
+                    break;
+                default:
+                    stream << "unknown";
+            }
+
+            stream << " cause=" << causeToString(globalNoCollectiveCause);
+            return stream.str();
+        }
+
+        /**
+         * Formats a H5D_mpio_no_collective_cause_t bit field.
+         *
+         * @param cause bit field
+         * @return human readable causes
+         */
+        static std::string causeToString(uint32_t cause)
+        {
+            if (cause == H5D_MPIO_COLLECTIVE)
+                return "none";
+
+            std::stringstream stream;
+            if (cause & H5D_MPIO_SET_INDEPENDENT)
+                stream << "set_independent ";
+            if (cause & H5D_MPIO_DATATYPE_CONVERSION)
+                stream << "datatype_conversion ";
+            if (cause & H5D_MPIO_DATA_TRANSFORMS)
+                stream << "data_transforms ";
+            if (cause & H5D_MPIO_NOT_SIMPLE_OR_SCALAR_DATASPACES)
+                stream << "not_simple_or_scalar_dataspaces ";
+            if (cause & H5D_MPIO_NOT_CONTIGUOUS_OR_CHUNKED_DATASET)
+                stream << "not_contiguous_or_chunked_dataset ";
+
+            stream << "(0x" << std::hex << cause << ")";
+            return stream.str();
+        }
+
+        /** true if a collective transfer was requested */
+        bool collectiveRequested;
+        /** I/O mode actually performed by HDF5 */
+        H5D_mpio_actual_io_mode_t actualMode;
+        /** reasons for breaking collective I/O on this process */
+        uint32_t localNoCollectiveCause;
+        /** reasons for breaking collective I/O on any process */
+        uint32_t globalNoCollectiveCause;
+    };
+
+}
+
+#endif /* TRANSFERPOLICY_HPP */
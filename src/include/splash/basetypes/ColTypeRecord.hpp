@@ -0,0 +1,163 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLTYPERECORD_HPP
+#define COLTYPERECORD_HPP
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#include "splash/CollectionType.hpp"
+#include "splash/DCException.hpp"
+
+namespace splash
+{
+
+    /**
+     * Compound datatype for records (structs) which is built at runtime
+     * from the offsets of its members, e.g. for a particle frame
+     * \code
+     * struct Particle { float pos[3]; float mom[3]; float weight; int64_t id; };
+     *
+     * ColTypeRecord particle("Particle", sizeof (Particle));
+     * SPLASH_RECORD_MEMBER(particle, Particle, pos, ColTypeFloat3Array());
+     * SPLASH_RECORD_MEMBER(particle, Particle, mom, ColTypeFloat3Array());
+     * SPLASH_RECORD_MEMBER(particle, Particle, weight, ColTypeFloat());
+     * SPLASH_RECORD_MEMBER(particle, Particle, id, ColTypeInt64());
+     * \endcode
+     *
+     * Records can be written as one dataset (array of structs) with
+     * DataCollector::write or as one dataset per member (struct of arrays)
+     * with SerialDataCollector::writeRecordsSoA.
+     * Written as one dataset, records keep the layout of the struct,
+     * including any padding between members, which should therefore
+     * be initialized. Datasets written per member contain no padding.
+     */
+    class ColTypeRecord : public CollectionType
+    {
+    public:
+
+        /**
+         * Member of a record.
+         * The datatype is owned by the record.
+         */
+        typedef struct
+        {
+            std::string name;
+            size_t offset;
+            size_t size;
+            hid_t type;
+        } Member;
+
+        /**
+         * Constructor
+         *
+         * @param name name of the record type, returned by toString
+         * @param recordSize size of one record in bytes, e.g. sizeof(struct)
+         */
+        ColTypeRecord(const std::string name, size_t recordSize) :
+        name(name),
+        recordSize(recordSize)
+        {
+            this->type = H5Tcreate(H5T_COMPOUND, recordSize);
+        }
+
+        ~ColTypeRecord()
+        {
+            for (size_t i = 0; i < members.size(); ++i)
+                H5Tclose(members[i].type);
+
+            H5Tclose(this->type);
+        }
+
+        /**
+         * Adds a member to the record.
+         *
+         * @param memberName unique name of the member
+         * @param offset offset of the member in bytes, e.g. offsetof(struct, member)
+         * @param memberType datatype of the member
+         * @return this record
+         */
+        ColTypeRecord& addMember(const std::string memberName, size_t offset,
+                const CollectionType& memberType) throw (DCException)
+        {
+            size_t size = H5Tget_size(memberType.getDataType());
+            if (size == 0 || offset + size > recordSize)
+                throw DCException(std::string("Exception for ColTypeRecord::addMember: "
+                    "member exceeds record size (") + memberName + std::string(")"));
+
+            if (H5Tinsert(this->type, memberName.c_str(), offset,
+                    memberType.getDataType()) < 0)
+                throw DCException(std::string("Exception for ColTypeRecord::addMember: "
+                    "failed to insert member (") + memberName + std::string(")"));
+
+            Member member;
+            member.name = memberName;
+            member.offset = offset;
+            member.size = size;
+            member.type = H5Tcopy(memberType.getDataType());
+            members.push_back(member);
+
+            return *this;
+        }
+
+        size_t getNumMembers() const
+        {
+            return members.size();
+        }
+
+        const Member& getMember(size_t index) const
+        {
+            return members.at(index);
+        }
+
+        size_t getSize() const
+        {
+            return recordSize;
+        }
+
+        std::string toString() const
+        {
+            return name;
+        }
+
+    private:
+        // records own HDF5 datatypes and cannot be copied
+        ColTypeRecord(const ColTypeRecord&);
+        ColTypeRecord& operator=(const ColTypeRecord&);
+
+        std::string name;
+        size_t recordSize;
+        std::vector<Member> members;
+    };
+
+}
+
+/**
+ * Adds a member of a struct to a ColTypeRecord,
+ * using the name and offset of the member.
+ */
+#define SPLASH_RECORD_MEMBER(_record, _struct, _member, _coltype)              \
+    (_record).addMember(#_member, offsetof(_struct, _member), _coltype)
+
+#endif /* COLTYPERECORD_HPP */
@@ -0,0 +1,93 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLTYPETRAITS_HPP
+#define COLTYPETRAITS_HPP
+
+#include <stdint.h>
+
+#include "splash/CollectionType.hpp"
+#include "splash/basetypes/basetypes_atomic.hpp"
+#include "splash/basetypes/basetypes_compound.hpp"
+#include "splash/basetypes/ColTypeBool.hpp"
+
+namespace splash
+{
+
+    /**
+     * Maps a C++ type to its CollectionType at compile time,
+     * see DataCollector::write<T> and getColType<T>.
+     *
+     * Only specializations are defined, using an unmapped type is a
+     * compile error. User types are mapped with SPLASH_COLTYPE_TRAITS
+     * at global scope, e.g. for a struct of three floats:
+     * \code
+     * SPLASH_COLTYPE_TRAITS(float3, splash::ColTypeFloat3)
+     * \endcode
+     */
+    template<typename T>
+    struct ColTypeTraits;
+
+    /**
+     * Returns the CollectionType of a C++ type.
+     *
+     * The object is created on first use and never destroyed, so its
+     * HDF5 datatype is created once per program instead of once per call
+     * and stays valid until the HDF5 library is closed.
+     * Not thread-safe before the first call.
+     *
+     * @return CollectionType for T
+     */
+    template<typename T>
+    const CollectionType& getColType()
+    {
+        static const CollectionType *colType = new typename ColTypeTraits<T>::Type();
+        return *colType;
+    }
+
+}
+
+#define SPLASH_COLTYPE_TRAITS(_real_type, _col_type)                           \
+    namespace splash                                                           \
+    {                                                                          \
+        template<>                                                             \
+        struct ColTypeTraits<_real_type>                                       \
+        { typedef _col_type Type; };                                           \
+    }
+
+// int, long etc. are mapped by their fixed-size typedefs
+SPLASH_COLTYPE_TRAITS(float, splash::ColTypeFloat)
+SPLASH_COLTYPE_TRAITS(double, splash::ColTypeDouble)
+SPLASH_COLTYPE_TRAITS(char, splash::ColTypeChar)
+SPLASH_COLTYPE_TRAITS(bool, splash::ColTypeBool)
+
+SPLASH_COLTYPE_TRAITS(int8_t, splash::ColTypeInt8)
+SPLASH_COLTYPE_TRAITS(int16_t, splash::ColTypeInt16)
+SPLASH_COLTYPE_TRAITS(int32_t, splash::ColTypeInt32)
+SPLASH_COLTYPE_TRAITS(int64_t, splash::ColTypeInt64)
+
+SPLASH_COLTYPE_TRAITS(uint8_t, splash::ColTypeUInt8)
+SPLASH_COLTYPE_TRAITS(uint16_t, splash::ColTypeUInt16)
+SPLASH_COLTYPE_TRAITS(uint32_t, splash::ColTypeUInt32)
+SPLASH_COLTYPE_TRAITS(uint64_t, splash::ColTypeUInt64)
+
+#endif /* COLTYPETRAITS_HPP */
@@ -30,7 +30,10 @@
 #include "splash/basetypes/ColTypeBool.hpp"
 #include "splash/basetypes/ColTypeDim.hpp"
 #include "splash/basetypes/ColTypeDimArray.hpp"
+#include "splash/basetypes/ColTypeRecord.hpp"
 #include "splash/basetypes/ColTypeString.hpp"
+#include "splash/basetypes/ColTypeTraits.hpp"
+#include "splash/basetypes/generateCollectionType.hpp"
 
 #include "splash/basetypes/ColTypeUnknown.hpp"
 
@@ -23,11 +23,20 @@
 #ifndef GENERATE_COLLECTION_TYPE_H
 #define GENERATE_COLLECTION_TYPE_H
 
+#include <stddef.h>
+#include <hdf5.h>
+
 namespace splash
 {
 
 class CollectionType;
 
+/**
+ * Function which returns a new CollectionType if it recognizes
+ * the given datatype_id and NULL otherwise, see e.g. ColTypeFloat::genType.
+ */
+typedef CollectionType* (*GenTypeFunction)(hid_t datatype_id);
+
 /**
  * Creates a new instance of a CollectionType based on the given datatype_id
  *
@@ -42,6 +51,25 @@ class CollectionType;
  */
 CollectionType* generateCollectionType(hid_t datatype_id);
 
+/**
+ * Registers a user-defined CollectionType for recognition by
+ * generateCollectionType, e.g. when listing entries or reading attributes.
+ * Registered types are tried in order of registration
+ * before the built-in types, registering a function again has no effect.
+ *
+ * @param genType function recognizing the user-defined type
+ */
+void registerCollectionType(GenTypeFunction genType);
+
+/**
+ * Sets the maximum number of distinct datatypes for which
+ * generateCollectionType remembers the recognized CollectionType
+ * (default 4096), 0 disables the cache.
+ *
+ * @param maxEntries maximum number of cached datatypes
+ */
+void setCollectionTypeCacheSize(size_t maxEntries);
+
 } /* namespace splash */
 
 
@@ -0,0 +1,161 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ATTRIBUTECACHE_HPP
+#define ATTRIBUTECACHE_HPP
+
+#include <stdint.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <hdf5.h>
+
+#include "splash/DCException.hpp"
+#include "splash/core/DCAttribute.hpp"
+
+namespace splash
+{
+
+    /**
+     * \cond HIDDEN_SYMBOLS
+     */
+
+    /**
+     * Cache of the attributes of objects in files opened for reading.
+     *
+     * Requested attributes of an object are read in a single pass over
+     * its attributes and kept in their file datatype, so later reads of
+     * these attributes neither open the object nor the attributes.
+     * Attributes of variable-length datatypes are not cached.
+     * The number of cached objects is bounded, a maximum of 0 disables
+     * caching.
+     */
+    class AttributeCache
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param maxObjects maximum number of cached objects
+         */
+        AttributeCache(size_t maxObjects);
+
+        /**
+         * Destructor
+         */
+        ~AttributeCache();
+
+        /**
+         * Sets the maximum number of cached objects,
+         * clearing the cache if necessary.
+         *
+         * @param maxObjects maximum number of objects
+         */
+        void setMaxObjects(size_t maxObjects);
+
+        size_t getMaxObjects() const;
+
+        /**
+         * Reads attributes of an object into the cache which are not
+         * cached yet, clearing the cache if it is full.
+         * Missing attributes are remembered as missing,
+         * variable-length attributes are skipped.
+         *
+         * @param key object key
+         * @param parent handle of the object
+         * @param entries attributes to load, datatypes are ignored
+         * @param count number of entries
+         * @return number of attributes read from the object
+         */
+        size_t load(const std::string &key, hid_t parent,
+                const DCAttribute::BulkEntry *entries,
+                size_t count) throw (DCException);
+
+        /**
+         * Returns if one of the attributes is known to be missing.
+         *
+         * @param key object key
+         * @param entries attributes to check
+         * @param count number of entries
+         * @return true if an attribute has been loaded but does not exist
+         */
+        bool isMissing(const std::string &key, const DCAttribute::BulkEntry *entries,
+                size_t count) const;
+
+        /**
+         * Reads attributes of an object from the cache.
+         * Values are converted to the datatypes of the entries.
+         *
+         * @param key object key
+         * @param entries attributes to read
+         * @param count number of entries
+         * @return false if the object or one of the attributes is not cached
+         */
+        bool read(const std::string &key, const DCAttribute::BulkEntry *entries,
+                size_t count) throw (DCException);
+
+        void clear();
+
+        size_t getNumObjects() const;
+
+    private:
+        typedef struct
+        {
+            // file datatype, owned, -1 for a missing attribute
+            hid_t type;
+            size_t elements;
+            std::vector<uint8_t> data;
+        } Value;
+
+        typedef std::map<std::string, Value> ValueMap;
+        typedef std::map<std::string, ValueMap> ObjectMap;
+
+        typedef struct
+        {
+            ValueMap *values;
+            // names of the attributes to load
+            std::vector<const char*> names;
+            std::vector<bool> found;
+            size_t numFound;
+            size_t numRead;
+        } LoadParam;
+
+        AttributeCache(const AttributeCache &other);
+        AttributeCache &operator=(const AttributeCache &other);
+
+        static herr_t loadCallback(hid_t location, const char *name,
+                const H5A_info_t *info, void *op_data);
+
+        static bool isFixedSize(hid_t type);
+
+        static void closeValues(ValueMap &values);
+
+        ObjectMap objects;
+        size_t maxObjects;
+    };
+    /**
+     * \endcond
+     */
+
+}
+
+#endif /* ATTRIBUTECACHE_HPP */
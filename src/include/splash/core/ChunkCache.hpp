@@ -0,0 +1,126 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHUNKCACHE_HPP
+#define CHUNKCACHE_HPP
+
+#include <stdint.h>
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "splash/Dimensions.hpp"
+
+namespace splash
+{
+
+    /**
+     * \cond HIDDEN_SYMBOLS
+     */
+
+    /**
+     * Least recently used cache of decoded (decompressed) dataset chunks.
+     *
+     * Chunks are identified by a dataset key and their origin in the
+     * dataset. Unlike the HDF5 chunk cache, cached chunks survive closing
+     * the dataset, so consecutive slice reads can reuse them.
+     * The total size of all cached chunks is bounded by a maximum
+     * number of bytes, a size of 0 disables caching.
+     */
+    class ChunkCache
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param maxBytes maximum size of all cached chunks
+         */
+        ChunkCache(size_t maxBytes);
+
+        /**
+         * Sets the maximum size of all cached chunks,
+         * evicting chunks if necessary.
+         *
+         * @param maxBytes maximum size in bytes
+         */
+        void setMaxBytes(size_t maxBytes);
+
+        size_t getMaxBytes() const;
+
+        /**
+         * Returns a cached chunk and marks it as most recently used.
+         *
+         * @param key dataset key
+         * @param origin origin of the chunk in the dataset
+         * @return decoded chunk data or NULL if the chunk is not cached
+         */
+        const std::vector<uint8_t> *find(const std::string &key,
+                const Dimensions &origin);
+
+        /**
+         * Adds a chunk, evicting least recently used chunks if necessary.
+         * Chunks larger than the maximum size are not cached.
+         *
+         * @param key dataset key
+         * @param origin origin of the chunk in the dataset
+         * @param data decoded chunk data, swapped into the cache
+         */
+        void insert(const std::string &key, const Dimensions &origin,
+                std::vector<uint8_t> &data);
+
+        void clear();
+
+        size_t getSize() const;
+
+    private:
+        typedef struct
+        {
+            std::string key;
+            hsize_t origin[DSP_DIM_MAX];
+        } ChunkKey;
+
+        struct LessChunkKey
+        {
+            bool operator()(const ChunkKey &a, const ChunkKey &b) const;
+        };
+
+        typedef std::list<std::pair<ChunkKey, std::vector<uint8_t> > > ChunkList;
+        typedef std::map<ChunkKey, ChunkList::iterator, LessChunkKey> ChunkMap;
+
+        static ChunkKey makeKey(const std::string &key, const Dimensions &origin);
+
+        void evict(size_t maxBytes);
+
+        // most recently used chunk first
+        ChunkList chunks;
+        ChunkMap lookup;
+        size_t size;
+        size_t maxBytes;
+    };
+    /**
+     * \endcond
+     */
+
+}
+
+#endif /* CHUNKCACHE_HPP */
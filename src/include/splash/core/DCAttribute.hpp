@@ -39,6 +39,19 @@ namespace splash
     class DCAttribute
     {
     public:
+        /**
+         * Attribute of a bulk read or write.
+         */
+        typedef struct
+        {
+            /** name of the attribute */
+            const char *name;
+            /** datatype of the value in memory */
+            hid_t type;
+            /** buffer to read into or to write from */
+            void *data;
+        } BulkEntry;
+
         /**
          * Basic static method for reading an attribute.
          *
@@ -94,9 +107,41 @@ namespace splash
                 Dimensions dims,
                 const void *src) throw (DCException);
 
+        /**
+         * Reads several attributes of an object, iterating the
+         * attributes of the object once.
+         * Values are converted to the datatypes of the entries.
+         *
+         * @param parent parent object to get attributes from
+         * @param entries attributes to read
+         * @param count number of entries
+         * @param required if true, missing attributes raise an exception
+         * @return number of entries read
+         */
+        static size_t readAttributes(hid_t parent,
+                const BulkEntry *entries,
+                size_t count,
+                bool required = true) throw (DCException);
+
+        /**
+         * Writes several scalar attributes of an object, iterating the
+         * existing attributes of the object once.
+         * Existing attributes are overwritten.
+         *
+         * @param parent parent object to add attributes to
+         * @param entries attributes to write
+         * @param count number of entries
+         */
+        static void writeAttributes(hid_t parent,
+                const BulkEntry *entries,
+                size_t count) throw (DCException);
+
     private:
         DCAttribute();
 
+        static herr_t findAttributesCallback(hid_t location, const char *name,
+                const H5A_info_t *info, void *op_data);
+
         static std::string getExceptionString(const char *name, std::string msg);
     };
     /**
@@ -25,11 +25,13 @@
 
 #include <stdint.h>
 #include <string>
+#include <vector>
 #include <hdf5.h>
 
 #include "splash/DCException.hpp"
 #include "splash/Dimensions.hpp"
 #include "splash/Selection.hpp"
+#include "splash/MultiSelection.hpp"
 #include "splash/CollectionType.hpp"
 #include "splash/basetypes/ColTypeDim.hpp"
 
@@ -125,6 +127,22 @@ namespace splash
          */
         void write(Selection srcSelect, Dimensions dstOffset, const void* data) throw (DCException);
 
+        /**
+         * Writes several blocks to an open dataset in a single transfer.
+         *
+         * @param select blocks in src buffer and their offsets in the dataset
+         * @param data source buffer to read from
+         */
+        void write(const MultiSelection &select, const void* data) throw (DCException);
+
+        /**
+         * Reads several blocks from an open dataset in a single transfer.
+         *
+         * @param select blocks in dst buffer and their offsets in the dataset
+         * @param dst pointer to destination buffer for reading
+         */
+        void read(const MultiSelection &select, void* dst) throw (DCException);
+
         /**
          * Reads data from an open dataset.
          *
@@ -159,6 +177,27 @@ namespace splash
                 uint32_t& srcNDims,
                 void* dst) throw (DCException);
 
+        /**
+         * Reads every srcStride-th element from an open dataset.
+         *
+         * @param dstBuffer size of the buffer to read into
+         * @param dstOffset offset in destination buffer to read to
+         * @param srcSize number of elements to read in each dimension
+         * @param srcOffset offset in source buffer to read from
+         * @param srcStride distance of elements in source buffer, 1 means 'no stride'
+         * @param sizeRead returns the size of the read dataset
+         * @param srcNDims returns the dimensions of the read dataset
+         * @param dst pointer to destination buffer for reading
+         */
+        void read(Dimensions dstBuffer,
+                Dimensions dstOffset,
+                Dimensions srcSize,
+                Dimensions srcOffset,
+                Dimensions srcStride,
+                Dimensions& sizeRead,
+                uint32_t& srcNDims,
+                void* dst) throw (DCException);
+
         /**
          * Appends data to an open 1-dimensional dataset.
          *
@@ -174,6 +213,26 @@ namespace splash
                 size_t stride,
                 const void* data) throw (DCException);
 
+        /**
+         * Extends an open 1-dimensional dataset by totalCount elements
+         * and writes count elements at position (old size + totalOffset).
+         * Used for appending a contiguous region shared by several writers,
+         * where every writer extends by the same totalCount.
+         *
+         * @param count number of elements to write, may be 0
+         * @param offset the offset to be used for reading from the data buffer.
+         * @param stride size of striding to be used for reading from the data buffer.
+         * @param totalCount number of elements the dataset is extended by
+         * @param totalOffset offset of this write within the extended region
+         * @param data data for appending
+         */
+        void append(size_t count,
+                size_t offset,
+                size_t stride,
+                size_t totalCount,
+                size_t totalOffset,
+                const void* data) throw (DCException);
+
         /**
          * Returns the number of dimensions of the dataset.
          *
@@ -213,6 +272,30 @@ namespace splash
          */
         size_t getDataTypeSize() throw (DCException);
 
+        /**
+         * Returns the chunk size of a chunked dataset.
+         *
+         * @param chunkSize returns the size of every chunk
+         * @return false if the dataset is not chunked
+         */
+        bool getChunkSize(Dimensions &chunkSize) throw (DCException);
+
+        /**
+         * Returns the file addresses of the raw data if the dataset can be
+         * read without HDF5, i.e. it is stored unfiltered and fully allocated
+         * (contiguously or in chunks) in a single file without user block
+         * which was opened with the default (sec2) file driver.
+         * Chunk addresses require HDF5 1.10.5 or later.
+         *
+         * @param addresses returns the file offsets of all extents in bytes
+         * @param origins returns the offsets of all extents in the dataset
+         * @param extentSize returns the (allocated) size of every extent
+         * @return false if the dataset must be read with HDF5
+         */
+        bool getRawExtents(std::vector<haddr_t> &addresses,
+                std::vector<Dimensions> &origins,
+                Dimensions &extentSize) throw (DCException);
+
         /**
          * Returns the name of the dataset.
          *
@@ -252,6 +335,20 @@ namespace splash
     private:
         std::string getExceptionString(std::string msg);
 
+        void transferBlocks(const MultiSelection &select, bool write, void *buf)
+        throw (DCException);
+
+        void selectBlocks(hid_t space,
+                const std::vector<MultiSelection::Block> &blocks,
+                bool bufferSide) throw (DCException);
+
+        bool isOrderPreserving(const std::vector<MultiSelection::Block> &blocks);
+
+        static void copyBlock(const MultiSelection::Block &block,
+                const Dimensions bufferSize, uint8_t *buffer,
+                const Dimensions stageSize, const Dimensions stageOffset,
+                uint8_t *stage, size_t typeSize, bool toStage);
+
         ColTypeDim dimType;
     };
     /**
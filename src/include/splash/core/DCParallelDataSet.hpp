@@ -24,6 +24,7 @@
 #define DCPARALLELDATASET_HPP
 
 #include "splash/core/DCDataSet.hpp"
+#include "splash/TransferPolicy.hpp"
 
 
 namespace splash
@@ -56,7 +57,65 @@ namespace splash
 
         void setWriteIndependent()
         {
-            H5Pset_dxpl_mpio(dsetWriteProperties, H5FD_MPIO_INDEPENDENT);
+            setWriteCollective(false);
+        }
+
+        void setWriteCollective(bool collective)
+        {
+            H5Pset_dxpl_mpio(dsetWriteProperties,
+                    collective ? H5FD_MPIO_COLLECTIVE : H5FD_MPIO_INDEPENDENT);
+        }
+
+        void setReadCollective(bool collective)
+        {
+            H5Pset_dxpl_mpio(dsetReadProperties,
+                    collective ? H5FD_MPIO_COLLECTIVE : H5FD_MPIO_INDEPENDENT);
+        }
+
+        /**
+         * Returns true if the open dataset uses filters, e.g. compression.
+         * Filtered datasets require collective writes.
+         */
+        bool hasFilters()
+        {
+            if (!opened)
+                return compression;
+
+            hid_t create_plist = H5Dget_create_plist(dataset);
+            if (create_plist < 0)
+                return compression;
+
+            int nfilters = H5Pget_nfilters(create_plist);
+            H5Pclose(create_plist);
+
+            return (nfilters > 0);
+        }
+
+        /**
+         * Reports the transfer mode requested and actually used
+         * by the last write or read.
+         *
+         * @param write report the last write if true, else the last read
+         * @param report returns the report
+         */
+        void getTransferReport(bool write, TransferReport &report)
+        {
+            hid_t plist = write ? dsetWriteProperties : dsetReadProperties;
+
+            H5FD_mpio_xfer_t xfer_mode = H5FD_MPIO_COLLECTIVE;
+            H5Pget_dxpl_mpio(plist, &xfer_mode);
+            report.collectiveRequested = (xfer_mode == H5FD_MPIO_COLLECTIVE);
+
+            H5D_mpio_actual_io_mode_t actual_mode = H5D_MPIO_NO_COLLECTIVE;
+            if (H5Pget_mpio_actual_io_mode(plist, &actual_mode) >= 0)
+                report.actualMode = actual_mode;
+
+            uint32_t local_cause = 0, global_cause = 0;
+            if (H5Pget_mpio_no_collective_cause(plist, &local_cause, &global_cause) >= 0)
+            {
+                report.localNoCollectiveCause = local_cause;
+                report.globalNoCollectiveCause = global_cause;
+            }
         }
     };
     /**
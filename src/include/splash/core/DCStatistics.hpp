@@ -0,0 +1,163 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DCSTATISTICS_HPP
+#define DCSTATISTICS_HPP
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <hdf5.h>
+
+#include "splash/CollectionType.hpp"
+#include "splash/DCException.hpp"
+#include "splash/Dimensions.hpp"
+#include "splash/Selection.hpp"
+#include "splash/core/DCDataSet.hpp"
+
+namespace splash
+{
+
+    /**
+     * \cond HIDDEN_SYMBOLS
+     */
+
+    /**
+     * Static operations on min/max statistics of datasets.
+     *
+     * A dataset is partitioned into blocks of blockSize elements
+     * (in all dimensions) and the minimum and maximum value of every block
+     * is stored in a companion dataset of the same datatype as
+     * (min_0, max_0, min_1, max_1, ...), blocks ordered with x fastest.
+     * Blocks which only contain NaN store NaN and never match.
+     * Attributes of the companion dataset record the block size and the size
+     * of the described dataset, so outdated statistics are detected.
+     *
+     * Only 32 and 64 bit integer and floating point data is supported.
+     */
+    class DCStatistics
+    {
+    public:
+        /**
+         * Returns the type of supported datatypes.
+         *
+         * @param datatype HDF5 datatype
+         * @return type or DCDT_UNKNOWN if statistics are not supported
+         */
+        static DCDataType getDataType(hid_t datatype);
+
+        /**
+         * Creates statistics for a dataset written from a buffer,
+         * replacing existing statistics.
+         *
+         * @param group group for the statistics dataset
+         * @param name name of the statistics dataset
+         * @param colType collection type of the data
+         * @param blockSize size of blocks
+         * @param select selection of the dataset in the src buffer
+         * @param data src buffer
+         */
+        static void write(hid_t group, const std::string &name,
+                const CollectionType &colType, const Dimensions blockSize,
+                const Selection &select, const void *data) throw (DCException);
+
+        /**
+         * Updates statistics of a 1-dimensional dataset for appended data.
+         * New statistics are created if the dataset was empty.
+         *
+         * @param group group for the statistics dataset
+         * @param name name of the statistics dataset
+         * @param colType collection type of the data
+         * @param blockElements number of elements per block for new statistics
+         * @param oldSize number of elements in the dataset before appending
+         * @param count number of appended elements
+         * @param offset offset of the first element in data
+         * @param stride distance of elements in data
+         * @param data src buffer
+         * @return false if statistics for the existing data are missing or outdated
+         */
+        static bool append(hid_t group, const std::string &name,
+                const CollectionType &colType, size_t blockElements,
+                uint64_t oldSize, size_t count, size_t offset, size_t stride,
+                const void *data) throw (DCException);
+
+        /**
+         * Selects all blocks which may contain values in [minValue, maxValue].
+         *
+         * @param group group of the statistics dataset
+         * @param name name of the statistics dataset
+         * @param datasetSize current size of the described dataset
+         * @param minValue lower bound
+         * @param maxValue upper bound
+         * @param blockSize returns the size of blocks
+         * @param candidates returns for every block if it may contain matching values
+         * @return false if statistics are missing or outdated
+         */
+        static bool getCandidates(hid_t group, const std::string &name,
+                const Dimensions datasetSize, double minValue, double maxValue,
+                Dimensions &blockSize, std::vector<bool> &candidates) throw (DCException);
+
+        /**
+         * Appends the dataset indices (x fastest) of all values in
+         * [minValue, maxValue] of a buffer read from a dataset.
+         *
+         * @param type type of the data
+         * @param buffer data
+         * @param bufferSize size of buffer
+         * @param bufferOffset offset of buffer in the dataset
+         * @param datasetSize size of the dataset
+         * @param minValue lower bound
+         * @param maxValue upper bound
+         * @param indices matching indices are appended
+         */
+        static void filter(DCDataType type, const void *buffer,
+                const Dimensions bufferSize, const Dimensions bufferOffset,
+                const Dimensions datasetSize, double minValue, double maxValue,
+                std::vector<uint64_t> &indices);
+
+        /**
+         * Returns the number of blocks of a dataset in every dimension.
+         *
+         * @param datasetSize size of the dataset
+         * @param blockSize size of blocks
+         * @return number of blocks
+         */
+        static Dimensions getNumBlocks(const Dimensions datasetSize,
+                const Dimensions blockSize);
+
+    private:
+        DCStatistics();
+
+        static void writeAttributes(hid_t group, const std::string &name,
+                const Dimensions blockSize, const Dimensions datasetSize)
+        throw (DCException);
+
+        static bool readAttributes(hid_t group, const std::string &name,
+                Dimensions &blockSize, Dimensions &datasetSize) throw (DCException);
+    };
+    /**
+     * \endcond
+     */
+
+}
+
+#endif /* DCSTATISTICS_HPP */
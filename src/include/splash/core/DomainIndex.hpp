@@ -0,0 +1,101 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMAININDEX_HPP
+#define DOMAININDEX_HPP
+
+#include <vector>
+
+#include "splash/Dimensions.hpp"
+#include "splash/domains/Domain.hpp"
+
+namespace splash
+{
+
+    /**
+     * \cond HIDDEN_SYMBOLS
+     */
+
+    /**
+     * Static bounding volume hierarchy of domains.
+     *
+     * The hierarchy is built once from all domains by recursive
+     * median splits, so queries for the domains intersecting a request
+     * only visit O(log n + k) nodes for non-overlapping domains.
+     * Intersection uses the same inclusive bounds as
+     * Domain::testIntersection.
+     */
+    class DomainIndex
+    {
+    public:
+        DomainIndex();
+
+        /**
+         * Builds the index, replacing any previous content.
+         *
+         * @param domains domains to index, referenced by their position
+         */
+        void build(const std::vector<Domain> &domains);
+
+        /**
+         * Returns the positions of all domains intersecting a domain.
+         *
+         * @param domain domain to test
+         * @param result returns the positions in ascending order
+         */
+        void query(const Domain &domain, std::vector<size_t> &result) const;
+
+        size_t getSize() const;
+
+        void clear();
+
+    private:
+        typedef struct
+        {
+            Dimensions low;
+            Dimensions high;
+            // range in items
+            size_t begin;
+            size_t end;
+            // child nodes, 0 for leaves (the root is never a child)
+            size_t left;
+            size_t right;
+        } Node;
+
+        size_t buildNode(size_t begin, size_t end);
+
+        static bool intersects(const Dimensions &low1, const Dimensions &high1,
+                const Dimensions &low2, const Dimensions &high2);
+
+        std::vector<Node> nodes;
+        // domain positions, grouped by leaf
+        std::vector<size_t> items;
+        std::vector<Dimensions> lows;
+        std::vector<Dimensions> highs;
+    };
+    /**
+     * \endcond
+     */
+
+}
+
+#endif /* DOMAININDEX_HPP */
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef GRIDREADPOOL_HPP
+#define GRIDREADPOOL_HPP
+
+#include <stdint.h>
+#include <deque>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include <hdf5.h>
+
+#include "splash/DCException.hpp"
+#include "splash/Dimensions.hpp"
+
+namespace splash
+{
+
+    /**
+     * \cond HIDDEN_SYMBOLS
+     */
+
+    /**
+     * Pool of threads which copy hyperslabs of unfiltered datasets
+     * from several files into disjoint regions of one destination buffer.
+     *
+     * Workers read raw data with POSIX I/O at the file offsets determined
+     * by HDF5 beforehand and never call HDF5 themselves, so the calling
+     * thread may continue with HDF5 calls (e.g. opening the next file)
+     * while data is transferred, independent of HDF5 thread safety.
+     */
+    class GridReadPool
+    {
+    public:
+
+        /**
+         * Hyperslab of one file, sizes and offsets in elements.
+         * The raw data of the dataset is stored in extents (chunks or one
+         * contiguous block) of equal size, see DCDataSet::getRawExtents.
+         */
+        typedef struct
+        {
+            std::string filename;
+            std::vector<haddr_t> addresses;
+            std::vector<Dimensions> origins;
+            Dimensions extentSize;
+            Dimensions srcSize;
+            Dimensions srcOffset;
+            Dimensions dstOffset;
+        } Job;
+
+        /**
+         * Constructor
+         *
+         * @param dst destination buffer
+         * @param dstSize size of the destination buffer in elements
+         * @param typeSize size of one element in bytes
+         */
+        GridReadPool(void *dst, const Dimensions dstSize, size_t typeSize);
+
+        /**
+         * Destructor, waits for running workers.
+         */
+        virtual ~GridReadPool();
+
+        /**
+         * Starts the worker threads.
+         *
+         * @param numThreads number of workers
+         */
+        void start(uint32_t numThreads) throw (DCException);
+
+        /**
+         * Queues a hyperslab, may be called while workers are running.
+         *
+         * @param job hyperslab to read
+         */
+        void add(const Job &job);
+
+        /**
+         * Waits until all queued hyperslabs have been read
+         * and stops the workers.
+         * Throws if reading any hyperslab failed.
+         */
+        void finish() throw (DCException);
+
+    private:
+        static void *run(void *pool);
+
+        bool next(Job &job);
+
+        void process(const Job &job, std::vector<uint8_t> &buffer) throw (DCException);
+
+        void processExtents(int fd, const Job &job,
+                std::vector<uint8_t> &buffer) throw (DCException);
+
+        void stop();
+
+        static void readFully(int fd, const std::string &filename,
+                uint64_t position, uint8_t *buffer, size_t size) throw (DCException);
+
+        uint8_t *dst;
+        Dimensions dstSize;
+        size_t typeSize;
+
+        std::deque<Job> jobs;
+        std::vector<pthread_t> threads;
+        bool closed;
+        std::string error;
+
+        pthread_mutex_t mutex;
+        pthread_cond_t cond;
+    };
+    /**
+     * \endcond
+     */
+
+}
+
+#endif /* GRIDREADPOOL_HPP */
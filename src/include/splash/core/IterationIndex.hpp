@@ -0,0 +1,122 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ITERATIONINDEX_HPP
+#define ITERATIONINDEX_HPP
+
+#include <stdint.h>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "splash/DCException.hpp"
+
+namespace splash
+{
+
+    /**
+     * \cond HIDDEN_SYMBOLS
+     */
+
+    /**
+     * Set of iterations of a per-iteration file set (prefix_<id>.h5)
+     * which is persisted in a small append-only binary file
+     * next to the HDF5 files (prefix_iterations.idx).
+     *
+     * The file starts with a magic string followed by records of
+     * (int32 id, int32 operation). Added iterations are recorded
+     * in memory and appended on flush. Iterations are never removed
+     * since the files of removed iterations stay on disk.
+     * Deleting the index file forces a directory scan on next open.
+     */
+    class IterationIndex
+    {
+    public:
+        IterationIndex();
+
+        /**
+         * Returns the name of the index file for a file set.
+         *
+         * @param baseFilename base filename of the file set, e.g. /path/prefix
+         * @return index filename, e.g. /path/prefix_iterations.idx
+         */
+        static std::string getIndexFilename(const std::string baseFilename);
+
+        /**
+         * Replaces the iterations with the content of an index file.
+         *
+         * @param filename index file
+         * @return false if the file does not exist or is not a valid index
+         */
+        bool load(const std::string filename);
+
+        /**
+         * Replaces the iterations, e.g. with the result of a directory scan.
+         *
+         * @param ids new iterations
+         * @param persist if true, all iterations are written on next flush
+         */
+        void assign(const std::set<int32_t> &ids, bool persist);
+
+        void add(int32_t id);
+
+        /**
+         * Appends all pending operations to an index file,
+         * creating it if necessary.
+         *
+         * @param filename index file
+         */
+        void flush(const std::string filename) throw (DCException);
+
+        void clear();
+
+        const std::set<int32_t>& getIDs() const;
+
+        /**
+         * @return largest iteration or -1 if empty
+         */
+        int32_t getMaxID() const;
+
+    private:
+        enum Operation
+        {
+            OP_REMOVE = 0, OP_ADD = 1
+        };
+
+        typedef struct
+        {
+            int32_t id;
+            int32_t op;
+        } Record;
+
+        std::set<int32_t> ids;
+        std::vector<Record> pending;
+        // index file has to be rewritten from scratch on flush
+        bool truncate;
+    };
+    /**
+     * \endcond
+     */
+
+}
+
+#endif /* ITERATIONINDEX_HPP */
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RECORDTRANSPOSER_HPP
+#define RECORDTRANSPOSER_HPP
+
+#include <stddef.h>
+
+namespace splash
+{
+
+    /**
+     * \cond HIDDEN_SYMBOLS
+     */
+
+    /**
+     * Copies one member of a sequence of records (array of structs)
+     * from or to a contiguous array (struct of arrays).
+     *
+     * Common member sizes are copied with fixed-size kernels,
+     * which the compiler can turn into plain (vector) loads and stores.
+     */
+    class RecordTransposer
+    {
+    public:
+        /**
+         * Copies a member of \p count records to a contiguous array.
+         *
+         * @param src address of the member in the first record
+         * @param srcStride distance of records in bytes
+         * @param memberSize size of the member in bytes
+         * @param count number of records
+         * @param dst contiguous array of \p count members
+         */
+        static void gather(const void *src, size_t srcStride, size_t memberSize,
+                size_t count, void *dst);
+
+        /**
+         * Copies a contiguous array to a member of \p count records.
+         *
+         * @param src contiguous array of \p count members
+         * @param memberSize size of the member in bytes
+         * @param count number of records
+         * @param dst address of the member in the first record
+         * @param dstStride distance of records in bytes
+         */
+        static void scatter(const void *src, size_t memberSize, size_t count,
+                void *dst, size_t dstStride);
+    };
+    /**
+     * \endcond
+     */
+
+}
+
+#endif /* RECORDTRANSPOSER_HPP */
@@ -23,6 +23,7 @@
 #ifndef DATACONTAINER_HPP
 #define DATACONTAINER_HPP
 
+#include <algorithm>
 #include <vector>
 
 #include "splash/DCException.hpp"
@@ -32,6 +33,70 @@
 namespace splash
 {
 
+    /**
+     * Typed view on the contiguous elements of a single subdomain.
+     *
+     * @tparam T element type, its size must match the type size of the data
+     */
+    template<typename T>
+    class ElementSpan
+    {
+    public:
+
+        ElementSpan() :
+        data(NULL),
+        count(0),
+        first(0)
+        {
+        }
+
+        ElementSpan(T *data_, size_t count_, size_t first_) :
+        data(data_),
+        count(count_),
+        first(first_)
+        {
+        }
+
+        T* begin() const
+        {
+            return data;
+        }
+
+        T* end() const
+        {
+            return data + count;
+        }
+
+        /**
+         * @return number of elements
+         */
+        size_t size() const
+        {
+            return count;
+        }
+
+        /**
+         * Returns the index of the first element among all elements
+         * of the DataContainer.
+         *
+         * @return global index of the first element
+         */
+        size_t getFirstIndex() const
+        {
+            return first;
+        }
+
+        T& operator[](size_t index) const
+        {
+            return data[index];
+        }
+
+    private:
+        T *data;
+        size_t count;
+        size_t first;
+    };
+
     /**
      * Container for storing domain-annotated data representing a specific subdomain.
      * The container contains information on the specific subdomain and its global domain.
@@ -45,6 +110,7 @@ namespace splash
          * Constructor.
          */
         DataContainer() :
+        elementOffsets(1, 0),
         offset(0, 0, 0),
         size(1, 1, 1)
         {
@@ -75,7 +141,7 @@ namespace splash
             if (entry == NULL)
                 throw DCException("Entry in DataContainer must not be NULL.");
 
-            if (entry->getData() == NULL)
+            if (entry->getData() == NULL && !entry->isPaged())
                 throw DCException("Data in entry in DataContainer must not be NULL.");
 
             const Dimensions &entryOffset = entry->getOffset();
@@ -91,6 +157,8 @@ namespace splash
             }
 
             subdomains.push_back(entry);
+            elementOffsets.push_back(elementOffsets.back() +
+                    entry->getElements().getScalarSize());
         }
 
         /**
@@ -110,15 +178,7 @@ namespace splash
          */
         size_t getNumElements()
         {
-            size_t num_elements = 0;
-
-            for (std::vector<DomainData* >::const_iterator iter = subdomains.begin();
-                    iter != subdomains.end(); ++iter)
-            {
-                num_elements += (*iter)->getElements().getScalarSize();
-            }
-
-            return num_elements;
+            return elementOffsets.back();
         }
 
         /**
@@ -216,39 +276,84 @@ namespace splash
          *
          * @param index Index among all elements in this container,
          * see \ref DataContainer::getNumElements.
+         * Elements of lazily loaded subdomains are loaded on demand,
+         * see \ref DomainData::getElement.
          * @return Pointer to element.
          */
         void* getElement(size_t index)
         {
-            if (subdomains.size() == 0)
+            if (index >= getNumElements())
                 return NULL;
 
-            size_t elements = 0;
+            const size_t i = findSubdomain(index);
+            DomainData *subdomain = subdomains[i];
 
-            for (size_t i = 0; i < subdomains.size(); ++i)
-            {
-                DomainData *subdomain = subdomains[i];
-                size_t subdomain_elements = subdomain->getElements().getScalarSize();
+            assert(subdomain->getData() != NULL || subdomain->isPaged());
+            return subdomain->getElement(index - elementOffsets[i]);
+        }
+
+        /**
+         * Returns the index of the first element of a subdomain
+         * among all elements in this container.
+         *
+         * @param index Index of subdomain partition.
+         * @return Index of first element.
+         */
+        size_t getSubdomainOffset(size_t index)
+        {
+            if (subdomains.size() > index)
+                return elementOffsets[index];
 
-                if (elements + subdomain_elements > index)
-                {
-                    size_t type_size = subdomain->getTypeSize();
-                    size_t local_index = index - elements;
+            throw DCException("Invalid index in DataContainer");
+        }
 
-                    assert(subdomain->getData() != NULL);
-                    if (subdomain->getData() == NULL)
-                        return NULL;
+        /**
+         * Returns the index of the subdomain containing an element.
+         *
+         * @param index Index among all elements in this container.
+         * @return Index of subdomain partition.
+         */
+        size_t findSubdomain(size_t index)
+        {
+            if (index >= getNumElements())
+                throw DCException("Invalid element index in DataContainer");
 
-                    return (((uint8_t*) (subdomain->getData())) + (type_size * local_index));
-                } else
-                    elements += subdomain_elements;
-            }
+            // last subdomain starting at or before index,
+            // empty subdomains are skipped
+            return std::upper_bound(elementOffsets.begin(), elementOffsets.end(), index) -
+                    elementOffsets.begin() - 1;
+        }
+
+        /**
+         * Returns the elements of a subdomain as a typed contiguous span.
+         * Iterating over the spans of all subdomains visits all elements
+         * in the order of \ref DataContainer::getElement.
+         * Subdomains loaded on demand have to be loaded completely first
+         * (see \ref IDomainCollector::readDomainLazy).
+         *
+         * @param index Index of subdomain partition.
+         * @return Span of all elements of the subdomain.
+         */
+        template<typename T>
+        ElementSpan<T> getSpan(size_t index)
+        {
+            DomainData *subdomain = getIndex(index);
+
+            if (subdomain->getTypeSize() != sizeof (T))
+                throw DCException("Span type does not match data type in DataContainer");
+
+            if (subdomain->getData() == NULL)
+                throw DCException("Subdomain in DataContainer has not been loaded");
 
-            return NULL;
+            return ElementSpan<T>((T*) (subdomain->getData()),
+                    elementOffsets[index + 1] - elementOffsets[index],
+                    elementOffsets[index]);
         }
 
     private:
         std::vector<DomainData* > subdomains;
+        // index of the first element of every subdomain and total number of elements
+        std::vector<size_t> elementOffsets;
         Dimensions offset;
         Dimensions size;
     };
@@ -0,0 +1,180 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMAINALLOCATOR_HPP
+#define DOMAINALLOCATOR_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+#include "splash/DCException.hpp"
+
+namespace splash
+{
+
+    /**
+     * Interface for allocating the buffers of DomainData,
+     * see \ref DomainCollector::setAllocator.
+     *
+     * Allocators are not thread-safe and must outlive all buffers
+     * they allocated.
+     */
+    class DomainAllocator
+    {
+    public:
+
+        virtual ~DomainAllocator()
+        {
+        }
+
+        /**
+         * Allocates a buffer.
+         *
+         * @param bytes size of the buffer, may be 0
+         * @return pointer to the buffer, never NULL
+         */
+        virtual void* allocate(size_t bytes) throw (DCException) = 0;
+
+        /**
+         * Frees a buffer returned by allocate.
+         *
+         * @param ptr pointer to the buffer
+         * @param bytes size passed to allocate
+         */
+        virtual void deallocate(void *ptr, size_t bytes) = 0;
+    };
+
+    /**
+     * Allocates buffers aligned for SIMD loads,
+     * optionally backed by transparent huge pages.
+     */
+    class AlignedAllocator : public DomainAllocator
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param alignment alignment in bytes, a power of two (default 64)
+         * @param hugePages if true, buffers of at least 2 MiB are aligned to
+         * and advised for huge pages where the system supports this
+         */
+        AlignedAllocator(size_t alignment = 64, bool hugePages = false);
+
+        void* allocate(size_t bytes) throw (DCException);
+
+        void deallocate(void *ptr, size_t bytes);
+
+    private:
+        size_t alignment;
+        bool hugePages;
+    };
+
+    /**
+     * Keeps freed buffers and returns them for later allocations of
+     * the same size, e.g. when reading the same domain in every iteration.
+     */
+    class PoolAllocator : public DomainAllocator
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param upstream allocator for new buffers
+         * @param maxBytes maximum size of all kept buffers
+         */
+        PoolAllocator(DomainAllocator &upstream, size_t maxBytes);
+
+        /**
+         * Destructor, frees all kept buffers.
+         */
+        virtual ~PoolAllocator();
+
+        void* allocate(size_t bytes) throw (DCException);
+
+        void deallocate(void *ptr, size_t bytes);
+
+        /**
+         * Frees all kept buffers.
+         */
+        void release();
+
+        /**
+         * @return size of all kept buffers in bytes
+         */
+        size_t getPooledBytes() const;
+
+    private:
+        DomainAllocator &upstream;
+        size_t maxBytes;
+        size_t pooledBytes;
+        std::multimap<size_t, void*> pool;
+    };
+
+    /**
+     * Allocates buffers consecutively from large blocks.
+     * Single buffers are never freed, reset makes all blocks
+     * available again at once, e.g. after processing an iteration.
+     */
+    class ArenaAllocator : public DomainAllocator
+    {
+    public:
+        /**
+         * Constructor
+         *
+         * @param blockSize minimum size of blocks in bytes
+         * @param alignment alignment of buffers, a power of two
+         */
+        ArenaAllocator(size_t blockSize = 64 * 1024 * 1024, size_t alignment = 64);
+
+        /**
+         * Destructor, frees all blocks.
+         */
+        virtual ~ArenaAllocator();
+
+        void* allocate(size_t bytes) throw (DCException);
+
+        /**
+         * Does nothing, see reset.
+         */
+        void deallocate(void *ptr, size_t bytes);
+
+        /**
+         * Invalidates all buffers and reuses the blocks
+         * for following allocations.
+         */
+        void reset();
+
+    private:
+        AlignedAllocator blockAllocator;
+        size_t blockSize;
+        size_t alignment;
+
+        std::vector<std::pair<uint8_t*, size_t> > blocks;
+        size_t currentBlock;
+        size_t currentOffset;
+    };
+
+}
+
+#endif /* DOMAINALLOCATOR_HPP */
@@ -0,0 +1,178 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMAINATTRIBUTE_HPP
+#define DOMAINATTRIBUTE_HPP
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+#include <hdf5.h>
+
+#include "splash/CollectionType.hpp"
+#include "splash/Dimensions.hpp"
+#include "splash/basetypes/ColTypeDim.hpp"
+#include "splash/domains/Domain.hpp"
+#include "splash/domains/IDomainCollector.hpp"
+
+namespace splash
+{
+
+    /**
+     * Domain information of a dataset packed into the single compound
+     * attribute DOMCOL_ATTR_DOMAIN.
+     *
+     * It holds the values of the separate attributes DOMCOL_ATTR_OFFSET,
+     * DOMCOL_ATTR_SIZE, DOMCOL_ATTR_GLOBAL_OFFSET, DOMCOL_ATTR_GLOBAL_SIZE
+     * and DOMCOL_ATTR_CLASS, so readers need to open one attribute only.
+     */
+    class DomainAttribute
+    {
+    public:
+        /**
+         * Layout of the attribute in memory, see ColTypeDomainAttribute.
+         */
+        typedef struct
+        {
+            hsize_t offset[DSP_DIM_MAX];
+            hsize_t size[DSP_DIM_MAX];
+            hsize_t globalOffset[DSP_DIM_MAX];
+            hsize_t globalSize[DSP_DIM_MAX];
+            int32_t dataClass;
+        } Packed;
+
+        /**
+         * Constructor
+         */
+        DomainAttribute() :
+        localDomain(Dimensions(0, 0, 0), Dimensions(0, 0, 0)),
+        globalDomain(Dimensions(0, 0, 0), Dimensions(0, 0, 0)),
+        dataClass(IDomainCollector::UndefinedType)
+        {
+
+        }
+
+        /**
+         * Constructor
+         *
+         * @param localDomain_ local domain, relative to the offset of the global domain
+         * @param globalDomain_ global domain
+         * @param dataClass_ data class of the dataset
+         */
+        DomainAttribute(const Domain localDomain_, const Domain globalDomain_,
+                IDomainCollector::DomDataClass dataClass_) :
+        localDomain(localDomain_),
+        globalDomain(globalDomain_),
+        dataClass(dataClass_)
+        {
+
+        }
+
+        /**
+         * Serializes this attribute.
+         * The trailing padding of packed is zeroed, as it is written to files.
+         *
+         * @param packed destination
+         */
+        void toPacked(Packed &packed) const
+        {
+            memset(&packed, 0, sizeof (Packed));
+
+            for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            {
+                packed.offset[i] = localDomain.getOffset()[i];
+                packed.size[i] = localDomain.getSize()[i];
+                packed.globalOffset[i] = globalDomain.getOffset()[i];
+                packed.globalSize[i] = globalDomain.getSize()[i];
+            }
+
+            packed.dataClass = (int32_t) dataClass;
+        }
+
+        /**
+         * Deserializes this attribute.
+         *
+         * @param packed source
+         */
+        void fromPacked(const Packed &packed)
+        {
+            localDomain = Domain(
+                    Dimensions(packed.offset[0], packed.offset[1], packed.offset[2]),
+                    Dimensions(packed.size[0], packed.size[1], packed.size[2]));
+            globalDomain = Domain(
+                    Dimensions(packed.globalOffset[0], packed.globalOffset[1], packed.globalOffset[2]),
+                    Dimensions(packed.globalSize[0], packed.globalSize[1], packed.globalSize[2]));
+            dataClass = (IDomainCollector::DomDataClass) packed.dataClass;
+        }
+
+        /** local domain, relative to the offset of the global domain */
+        Domain localDomain;
+        /** global domain */
+        Domain globalDomain;
+        /** data class of the dataset */
+        IDomainCollector::DomDataClass dataClass;
+    };
+
+    /**
+     * CollectionType of DomainAttribute::Packed,
+     * the domains are stored as ColTypeDim members.
+     */
+    class ColTypeDomainAttribute : public CollectionType
+    {
+    public:
+
+        ColTypeDomainAttribute()
+        {
+            ColTypeDim dim_t;
+
+            this->type = H5Tcreate(H5T_COMPOUND, getSize());
+            H5Tinsert(this->type, "offset",
+                    HOFFSET(DomainAttribute::Packed, offset), dim_t.getDataType());
+            H5Tinsert(this->type, "size",
+                    HOFFSET(DomainAttribute::Packed, size), dim_t.getDataType());
+            H5Tinsert(this->type, "global_offset",
+                    HOFFSET(DomainAttribute::Packed, globalOffset), dim_t.getDataType());
+            H5Tinsert(this->type, "global_size",
+                    HOFFSET(DomainAttribute::Packed, globalSize), dim_t.getDataType());
+            H5Tinsert(this->type, "class",
+                    HOFFSET(DomainAttribute::Packed, dataClass), H5T_NATIVE_INT32);
+        }
+
+        ~ColTypeDomainAttribute()
+        {
+            H5Tclose(this->type);
+        }
+
+        size_t getSize() const
+        {
+            return sizeof (DomainAttribute::Packed);
+        }
+
+        std::string toString() const
+        {
+            return "DomainAttribute";
+        }
+    };
+
+}
+
+#endif /* DOMAINATTRIBUTE_HPP */
@@ -25,11 +25,14 @@
 
 #include <sstream>
 #include <cassert>
+#include <cstring>
 #include <string>
 #include <hdf5.h>
 
 #include "splash/Dimensions.hpp"
 #include "splash/domains/Domain.hpp"
+#include "splash/domains/DomainAllocator.hpp"
+#include "splash/domains/DomainPageLoader.hpp"
 #include "splash/core/DCDataSet.hpp"
 
 namespace splash
@@ -61,22 +64,36 @@ namespace splash
          * Constructor.
          * Allocates enough memory to hold 'elements' data of 'type'.
          *
+         * With a page loader, no memory is allocated (lazy loading).
+         * Elements are then loaded on demand by \p pageLoader_
+         * (see getElement and readElements) or completely after allocateData.
+         *
          * @param domain_ The underlying Domain.
          * @param elements_ Number of data elements in every dimension.
          * @param datatypeSize_ Size of each element in bytes.
          * @param datatype_ Internal representation of HDF5 datatype.
+         * @param allocator_ Allocator for the buffer, NULL uses new[].
+         * @param pageLoader_ Loader for elements on demand, NULL allocates
+         * the buffer immediately.
          */
         DomainData(const Domain& domain_, const Dimensions elements_,
-                size_t datatypeSize_, DCDataType datatype_) :
+                size_t datatypeSize_, DCDataType datatype_,
+                DomainAllocator *allocator_ = NULL,
+                DomainPageLoader *pageLoader_ = NULL) :
         Domain(domain_),
         elements(elements_),
         data(NULL),
         loadingReference(NULL),
+        pageLoader(pageLoader_),
+        allocator(allocator_),
         datatype(datatype_),
         datatypeSize(datatypeSize_)
         {
-            data = new uint8_t[datatypeSize * elements.getScalarSize()];
-            assert(data != NULL);
+            if (pageLoader == NULL)
+            {
+                allocateData();
+                assert(data != NULL);
+            }
         }
 
         /**
@@ -115,6 +132,80 @@ namespace splash
             return data;
         }
 
+        /**
+         * Returns a pointer to a single element.
+         * For lazily loaded subdomains without data (see isPaged),
+         * the element is loaded on demand and the pointer is only valid
+         * until the next element of a lazy subdomain is accessed.
+         *
+         * @param index index of the element
+         * @return pointer to the element or NULL if no data is available
+         */
+        void* getElement(size_t index) throw (DCException)
+        {
+            if (index >= elements.getScalarSize())
+                return NULL;
+
+            if (data != NULL)
+                return data + index * datatypeSize;
+
+            if (isPaged())
+                return pageLoader->loadElement(this, index);
+
+            return NULL;
+        }
+
+        /**
+         * Copies a range of elements to a buffer, loading them on demand
+         * for lazily loaded subdomains without data (see isPaged).
+         *
+         * @param first index of the first element
+         * @param count number of elements
+         * @param dst destination buffer for count elements
+         */
+        void readElements(size_t first, size_t count, void *dst) throw (DCException)
+        {
+            if (first + count > elements.getScalarSize())
+                throw DCException("DomainData::readElements: range exceeds elements");
+
+            if (count == 0)
+                return;
+
+            if (data != NULL)
+                memcpy(dst, data + first * datatypeSize, count * datatypeSize);
+            else if (isPaged())
+                pageLoader->loadElements(this, first, count, dst);
+            else
+                throw DCException("DomainData::readElements: no data available");
+        }
+
+        /**
+         * Returns true if elements of this subdomain are loaded on demand
+         * since no data has been allocated (yet).
+         *
+         * @return true if elements are loaded on demand
+         */
+        bool isPaged()
+        {
+            return (data == NULL) && (pageLoader != NULL) &&
+                    (loadingReference != NULL);
+        }
+
+        /**
+         * Internal use only!
+         * Allocates memory for all elements if no data exists.
+         */
+        void allocateData()
+        {
+            if (data != NULL)
+                return;
+
+            if (allocator != NULL)
+                data = (uint8_t*) allocator->allocate(getDataSize());
+            else
+                data = new uint8_t[getDataSize()];
+        }
+
         /**
          * Deallocate data of this subdomain, should be used for lazy loading.
          */
@@ -122,11 +213,49 @@ namespace splash
         {
             if (data != NULL)
             {
-                delete[] data;
+                if (allocator != NULL)
+                    allocator->deallocate(data, getDataSize());
+                else
+                    delete[] data;
                 data = NULL;
             }
         }
 
+        /**
+         * Passes the ownership of the internal buffer to the caller
+         * without copying. The caller must free the buffer with
+         * getAllocator()->deallocate(buffer, getDataSize()) or with
+         * delete[] if getAllocator() returns NULL.
+         *
+         * @return pointer to the former internal buffer, may be NULL
+         */
+        void* releaseData()
+        {
+            void *released = data;
+            data = NULL;
+            return released;
+        }
+
+        /**
+         * Returns the allocator of the internal buffer.
+         *
+         * @return allocator or NULL if the buffer is allocated with new[]
+         */
+        DomainAllocator *getAllocator()
+        {
+            return allocator;
+        }
+
+        /**
+         * Returns the size of the internal buffer.
+         *
+         * @return size in bytes
+         */
+        size_t getDataSize()
+        {
+            return datatypeSize * elements.getScalarSize();
+        }
+
         /**
          * Returns the size in bytes of the buffer's data type.
          *
@@ -223,6 +352,8 @@ namespace splash
         Dimensions elements;
         uint8_t* data;
         DomainH5Ref *loadingReference;
+        DomainPageLoader *pageLoader;
+        DomainAllocator *allocator;
 
         DCDataType datatype;
         size_t datatypeSize;
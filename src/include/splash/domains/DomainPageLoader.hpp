@@ -0,0 +1,73 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMAINPAGELOADER_HPP
+#define DOMAINPAGELOADER_HPP
+
+#include <stddef.h>
+
+#include "splash/DCException.hpp"
+
+namespace splash
+{
+
+    class DomainData;
+
+    /**
+     * Interface for loading elements of lazily loaded subdomains on demand.
+     * Internal use only, implemented by \ref DomainCollector.
+     */
+    class DomainPageLoader
+    {
+    public:
+
+        virtual ~DomainPageLoader()
+        {
+        }
+
+        /**
+         * Returns a pointer to a single element of a lazy subdomain.
+         * The pointer is valid until the next element of a lazy subdomain
+         * of the same loader is accessed, changes to the element are lost.
+         *
+         * @param domainData lazy subdomain
+         * @param index index of the element
+         * @return pointer to the element
+         */
+        virtual void* loadElement(DomainData *domainData,
+                size_t index) throw (DCException) = 0;
+
+        /**
+         * Copies elements of a lazy subdomain to a buffer.
+         *
+         * @param domainData lazy subdomain
+         * @param first index of the first element
+         * @param count number of elements
+         * @param dst destination buffer for count elements
+         */
+        virtual void loadElements(DomainData *domainData,
+                size_t first, size_t count, void *dst) throw (DCException) = 0;
+    };
+
+}
+
+#endif /* DOMAINPAGELOADER_HPP */
@@ -0,0 +1,154 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMAINTABLE_HPP
+#define DOMAINTABLE_HPP
+
+#include <stdint.h>
+#include <string>
+#include <sstream>
+
+#include "splash/Dimensions.hpp"
+#include "splash/domains/Domain.hpp"
+#include "splash/domains/IDomainCollector.hpp"
+
+namespace splash
+{
+
+    /**
+     * One row of the global domain table of a dataset.
+     *
+     * The table is written at write time to the header group of the
+     * (first) file and describes the subdomain of every writing process,
+     * so readers can plan all data accesses after opening a single file.
+     * In the file, every row is stored as NUM_COLUMNS unsigned 64 bit
+     * integers (mpi position, domain offset, domain size, offset of the
+     * process's data in the dataset, number of elements, data class).
+     */
+    class DomainTableEntry
+    {
+    public:
+        /**
+         * Number of values per row in the table dataset.
+         */
+        static const uint32_t NUM_COLUMNS = 5 * DSP_DIM_MAX + 1;
+
+        /**
+         * Constructor
+         */
+        DomainTableEntry() :
+        mpiPosition(0, 0, 0),
+        domain(Dimensions(0, 0, 0), Dimensions(0, 0, 0)),
+        dataOffset(0, 0, 0),
+        elements(0, 0, 0),
+        dataClass(IDomainCollector::UndefinedType)
+        {
+
+        }
+
+        /**
+         * Constructor
+         *
+         * @param mpiPosition_ position of the writing process in the MPI topology
+         * @param domain_ absolute (local + global offset) domain of the process
+         * @param dataOffset_ offset of the process's data in the dataset
+         * @param elements_ number of data elements written by the process
+         * @param dataClass_ data class of the dataset
+         */
+        DomainTableEntry(Dimensions mpiPosition_, Domain domain_,
+                Dimensions dataOffset_, Dimensions elements_,
+                IDomainCollector::DomDataClass dataClass_) :
+        mpiPosition(mpiPosition_),
+        domain(domain_),
+        dataOffset(dataOffset_),
+        elements(elements_),
+        dataClass(dataClass_)
+        {
+
+        }
+
+        /**
+         * Serializes this entry into NUM_COLUMNS values.
+         *
+         * @param row destination buffer
+         */
+        void toRow(uint64_t *row) const
+        {
+            for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            {
+                row[i] = mpiPosition[i];
+                row[DSP_DIM_MAX + i] = domain.getOffset()[i];
+                row[2 * DSP_DIM_MAX + i] = domain.getSize()[i];
+                row[3 * DSP_DIM_MAX + i] = dataOffset[i];
+                row[4 * DSP_DIM_MAX + i] = elements[i];
+            }
+
+            row[5 * DSP_DIM_MAX] = (uint64_t) dataClass;
+        }
+
+        /**
+         * Deserializes this entry from NUM_COLUMNS values.
+         *
+         * @param row source buffer
+         */
+        void fromRow(const uint64_t *row)
+        {
+            Dimensions offset, size;
+            for (uint32_t i = 0; i < DSP_DIM_MAX; ++i)
+            {
+                mpiPosition[i] = row[i];
+                offset[i] = row[DSP_DIM_MAX + i];
+                size[i] = row[2 * DSP_DIM_MAX + i];
+                dataOffset[i] = row[3 * DSP_DIM_MAX + i];
+                elements[i] = row[4 * DSP_DIM_MAX + i];
+            }
+
+            domain = Domain(offset, size);
+            dataClass = (IDomainCollector::DomDataClass) row[5 * DSP_DIM_MAX];
+        }
+
+        std::string toString() const
+        {
+            std::stringstream stream;
+            stream << "(mpi_position=" << mpiPosition.toString() <<
+                    " domain=" << domain.toString() <<
+                    " data_offset=" << dataOffset.toString() <<
+                    " elements=" << elements.toString() <<
+                    " class=" << dataClass << ")";
+            return stream.str();
+        }
+
+        /** position of the writing process in the MPI topology */
+        Dimensions mpiPosition;
+        /** absolute domain of the process (local + global offset) */
+        Domain domain;
+        /** offset of the process's data in the dataset */
+        Dimensions dataOffset;
+        /** number of data elements of the process */
+        Dimensions elements;
+        /** data class of the dataset */
+        IDomainCollector::DomDataClass dataClass;
+    };
+
+}
+
+#endif /* DOMAINTABLE_HPP */
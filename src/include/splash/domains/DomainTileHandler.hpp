@@ -0,0 +1,59 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef DOMAINTILEHANDLER_HPP
+#define DOMAINTILEHANDLER_HPP
+
+#include "splash/DCException.hpp"
+
+namespace splash
+{
+
+    class DomainData;
+
+    /**
+     * Interface for processing the tiles of a domain as they are read,
+     * see \ref DomainCollector::readDomainTiled.
+     */
+    class DomainTileHandler
+    {
+    public:
+
+        virtual ~DomainTileHandler()
+        {
+        }
+
+        /**
+         * Called for every tile after it has been read.
+         * Only DCExceptions may be thrown, they abort reading.
+         *
+         * @param tile data of the tile, the buffer is freed after this call.
+         * For Grid data, the domain of the tile is its position in the
+         * global domain. For Poly data, the domain is the domain of the
+         * file containing the elements of the tile.
+         */
+        virtual void processTile(DomainData &tile) throw (DCException) = 0;
+    };
+
+}
+
+#endif /* DOMAINTILEHANDLER_HPP */
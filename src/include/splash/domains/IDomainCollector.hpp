@@ -34,6 +34,8 @@
 #define DOMCOL_ATTR_OFFSET "_start"
 #define DOMCOL_ATTR_GLOBAL_OFFSET "_global_start"
 #define DOMCOL_ATTR_ELEMENTS "_elements"
+#define DOMCOL_ATTR_DOMAIN "_domain"
+#define DOMCOL_GROUP_TABLE "domain_table"
 
 namespace splash
 {
@@ -93,7 +95,8 @@ namespace splash
          * @param domain Domain for reading.
          * @param dataClass Optional domain type annotation, can be NULL.
          * @param lazyLoad Set to load only size information for each subdomain,
-         * data must be loaded later using \ref IDomainCollector::readDomainLazy.
+         * data must be loaded later using \ref IDomainCollector::readDomainLazy
+         * or may be loaded on demand (see \ref DomainData::getElement).
          * @return Returns a pointer to a newly allocated DataContainer holding all subdomains.
          */
         virtual DataContainer *readDomain(int32_t id,
@@ -102,6 +105,30 @@ namespace splash
                 DomDataClass* dataClass,
                 bool lazyLoad = false) = 0;
 
+        /**
+         * Reads every stride-th element of domain-annotated data,
+         * e.g. for previews of large Grid data at a lower level of detail.
+         * The stride is applied in the hyperslab selections of the files,
+         * so only the selected elements are read.
+         *
+         * For Grid data, the elements at domain offset + n * stride are
+         * read into a single subdomain which covers the requested domain and
+         * has ceil(domain size / stride) elements in each dimension.
+         * For Poly data, every stride-th element of each subdomain is read.
+         *
+         * @param id ID of the iteration.
+         * @param name Name of the dataset.
+         * @param domain Domain for reading.
+         * @param stride Distance of read elements in each dimension, 1 means 'no stride'.
+         * @param dataClass Optional domain type annotation, can be NULL.
+         * @return Returns a pointer to a newly allocated DataContainer holding all subdomains.
+         */
+        virtual DataContainer *readDomain(int32_t id,
+                const char* name,
+                const Domain domain,
+                const Dimensions stride,
+                DomDataClass* dataClass) = 0;
+
         /**
          * Reads a subdomain which has been loaded using readDomain with lazyLoad activated.
          * The DomainCollector instance must not have been closed in between.
@@ -29,6 +29,7 @@ namespace splash
 #define SDC_GROUP_DATA "/data"
 #define SDC_GROUP_ITERATION "iteration"
 #define SDC_GROUP_CUSTOM "/"
+#define SDC_GROUP_STATISTICS "/statistics"
 #define SDC_ATTR_DIM_LOCAL "dim_local"
 #define SDC_ATTR_DIM_GLOBAL "dim_global"
 #define SDC_ATTR_MAX_ID "max_id"
@@ -37,6 +38,8 @@ namespace splash
 #define SDC_ATTR_GRID_SIZE "grid_size"
 #define SDC_ATTR_SIZE "client_size"
 #define SDC_ATTR_COMPRESSION "compression"
+#define SDC_ATTR_BLOCK_SIZE "block_size"
+#define SDC_ATTR_DATA_SIZE "data_size"
 #define SDC_ATTR_VERSION "splashVersion"
 #define SDC_ATTR_FORMAT "splashFormat"
 }
@@ -30,9 +30,11 @@
 
 #include "splash/SerialDataCollector.hpp"
 #include "splash/DomainCollector.hpp"
+#include "splash/IterationReader.hpp"
 
 #include "splash/ParallelDataCollector.hpp"
 #include "splash/ParallelDomainCollector.hpp"
+#include "splash/DistributedDomainCollector.hpp"
 
 #include "splash/basetypes/basetypes.hpp"
 #include "splash/AttributeInfo.hpp"
@@ -29,6 +29,7 @@
 
 #include "splash/SerialDataCollector.hpp"
 #include "splash/DomainCollector.hpp"
+#include "splash/IterationReader.hpp"
 
 #include "splash/basetypes/basetypes.hpp"
 #include "splash/AttributeInfo.hpp"
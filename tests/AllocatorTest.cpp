@@ -0,0 +1,158 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "AllocatorTest.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(AllocatorTest);
+
+using namespace splash;
+
+const char* hdf5_file_allocator = "h5/testAllocator";
+
+AllocatorTest::AllocatorTest()
+{
+}
+
+AllocatorTest::~AllocatorTest()
+{
+}
+
+void AllocatorTest::testAllocators()
+{
+    AlignedAllocator aligned(64);
+    for (size_t bytes = 0; bytes < 1000; bytes += 37)
+    {
+        void *ptr = aligned.allocate(bytes);
+        CPPUNIT_ASSERT(ptr != NULL);
+        CPPUNIT_ASSERT((size_t) ptr % 64 == 0);
+        aligned.deallocate(ptr, bytes);
+    }
+
+    AlignedAllocator huge(64, true);
+    void *huge_ptr = huge.allocate(4 * 1024 * 1024);
+    CPPUNIT_ASSERT((size_t) huge_ptr % (2 * 1024 * 1024) == 0);
+    huge.deallocate(huge_ptr, 4 * 1024 * 1024);
+
+    // buffers of the same size are reused
+    PoolAllocator pool(aligned, 1000);
+    void *ptr1 = pool.allocate(400);
+    void *ptr2 = pool.allocate(400);
+    void *ptr3 = pool.allocate(300);
+    CPPUNIT_ASSERT(ptr1 != ptr2);
+
+    pool.deallocate(ptr1, 400);
+    pool.deallocate(ptr2, 400);
+    CPPUNIT_ASSERT(pool.getPooledBytes() == 800);
+
+    // exceeds maxBytes, freed immediately
+    pool.deallocate(ptr3, 300);
+    CPPUNIT_ASSERT(pool.getPooledBytes() == 800);
+
+    void *ptr4 = pool.allocate(400);
+    CPPUNIT_ASSERT(ptr4 == ptr1 || ptr4 == ptr2);
+    CPPUNIT_ASSERT(pool.getPooledBytes() == 400);
+    pool.deallocate(ptr4, 400);
+
+    pool.release();
+    CPPUNIT_ASSERT(pool.getPooledBytes() == 0);
+
+    // arena buffers are aligned and disjoint, reset reuses blocks
+    ArenaAllocator arena(1024, 32);
+    uint8_t *first = (uint8_t*) arena.allocate(10);
+    uint8_t *second = (uint8_t*) arena.allocate(100);
+    uint8_t *large = (uint8_t*) arena.allocate(5000);
+    CPPUNIT_ASSERT((size_t) first % 32 == 0);
+    CPPUNIT_ASSERT((size_t) second % 32 == 0);
+    CPPUNIT_ASSERT((size_t) large % 32 == 0);
+    CPPUNIT_ASSERT(second >= first + 10);
+
+    arena.reset();
+    CPPUNIT_ASSERT(arena.allocate(10) == first);
+}
+
+void AllocatorTest::testReadDomain()
+{
+    const Dimensions size(64, 32, 16);
+    const Domain domain(Dimensions(0, 0, 0), size);
+
+    float *data_write = new float[size.getScalarSize()];
+    for (size_t i = 0; i < size.getScalarSize(); ++i)
+        data_write[i] = (float) i;
+
+    DomainCollector dc(1);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_CREATE;
+    dc.open(hdf5_file_allocator, fattr);
+    dc.writeDomain(0, ctFloat, 3, Selection(size), "grid", domain, domain,
+            IDomainCollector::GridType, data_write);
+    dc.writeDomain(0, ctFloat, 1, Selection(Dimensions(1000, 1, 1)), "poly",
+            domain, domain, IDomainCollector::PolyType, data_write);
+    dc.close();
+
+    AlignedAllocator aligned(64);
+    PoolAllocator pool(aligned, 64 * 1024 * 1024);
+
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dc.open(hdf5_file_allocator, fattr);
+    dc.setAllocator(&pool);
+
+    // the buffer of the previous iteration is reused
+    void *previous = NULL;
+    for (size_t iteration = 0; iteration < 3; ++iteration)
+    {
+        DataContainer *container = dc.readDomain(0, "grid", domain, NULL);
+        DomainData *subdomain = container->getIndex(0);
+
+        CPPUNIT_ASSERT(subdomain->getAllocator() == &pool);
+        CPPUNIT_ASSERT((size_t) subdomain->getData() % 64 == 0);
+        CPPUNIT_ASSERT(previous == NULL || subdomain->getData() == previous);
+        previous = subdomain->getData();
+
+        for (size_t i = 0; i < size.getScalarSize(); ++i)
+            CPPUNIT_ASSERT(((float*) subdomain->getData())[i] == data_write[i]);
+
+        delete container;
+    }
+
+    CPPUNIT_ASSERT(pool.getPooledBytes() == size.getScalarSize() * sizeof (float));
+
+    // buffers can be kept after deleting the container
+    DataContainer *container = dc.readDomain(0, "poly", domain, NULL);
+    DomainData *subdomain = container->getIndex(0);
+    const size_t bytes = subdomain->getDataSize();
+    CPPUNIT_ASSERT(bytes == 1000 * sizeof (float));
+
+    float *released = (float*) subdomain->releaseData();
+    CPPUNIT_ASSERT(subdomain->getData() == NULL);
+    delete container;
+
+    for (size_t i = 0; i < 1000; ++i)
+        CPPUNIT_ASSERT(released[i] == data_write[i]);
+    pool.deallocate(released, bytes);
+
+    dc.setAllocator(NULL);
+    dc.close();
+
+    delete[] data_write;
+}
@@ -48,6 +48,7 @@ using namespace splash;
 #define TEST_FILE_META "h5/attributes_meta"
 #define TEST_FILE2 "h5/attributes_array"
 #define TEST_FILE_ARRAYMETA "h5/attributes_arraymeta"
+#define TEST_FILE_BULK "h5/attributes_bulk"
 
 AttributesTest::AttributesTest() :
 ctString4(4)
@@ -437,3 +438,135 @@ void AttributesTest::testArrayAttributesMeta()
 
     dataCollector->close();
 }
+
+/**
+ * Reads the attributes written by testBulkAttributes in one call.
+ */
+static void checkBulkAttributes(SerialDataCollector &dc, const char *dataName)
+{
+    ColTypeInt32 ctInt32;
+    ColTypeDouble ctDouble;
+    ColTypeFloat ctFloat;
+    ColTypeDim ctDim;
+    ColTypeString ctString(7);
+    ColTypeString ctVarString;
+
+    int32_t int_value = 0;
+    double double_value = 0.0;
+    Dimensions dim_value(0, 0, 0);
+    char text[8];
+    char *var_text = NULL;
+    // converted while reading
+    double int_as_double = 0.0;
+    float double_as_float = 0.0f;
+
+    const SerialDataCollector::AttributeEntry entries[] = {
+        {"int", &ctInt32, &int_value},
+        {"double", &ctDouble, &double_value},
+        {"dim", &ctDim, dim_value.getPointer()},
+        {"text", &ctString, text},
+        {"vartext", &ctVarString, &var_text},
+        {"int", &ctDouble, &int_as_double},
+        {"double", &ctFloat, &double_as_float}
+    };
+    const size_t num_entries = sizeof (entries) / sizeof (entries[0]);
+
+    dc.readAttributes(0, dataName, entries, num_entries);
+
+    CPPUNIT_ASSERT(int_value == 43);
+    CPPUNIT_ASSERT(double_value == 2.5);
+    CPPUNIT_ASSERT(dim_value == Dimensions(1, 2, 3));
+    CPPUNIT_ASSERT(strcmp(text, "splash!") == 0);
+    CPPUNIT_ASSERT(var_text != NULL && strcmp(var_text, "variable") == 0);
+    CPPUNIT_ASSERT(int_as_double == 43.0);
+    CPPUNIT_ASSERT(double_as_float == 2.5f);
+    free(var_text);
+
+    // single attributes match the bulk read
+    int32_t single_value = 0;
+    dc.readAttributeInfo(0, dataName, "int").read(&single_value,
+            sizeof (single_value));
+    CPPUNIT_ASSERT(single_value == int_value);
+
+    const SerialDataCollector::AttributeEntry missing[] = {
+        {"int", &ctInt32, &int_value},
+        {"missing", &ctInt32, &int_value}
+    };
+
+    bool thrown = false;
+    try
+    {
+        dc.readAttributes(0, dataName, missing, 2);
+    } catch (const DCException&)
+    {
+        thrown = true;
+    }
+    CPPUNIT_ASSERT(thrown);
+}
+
+void AttributesTest::testBulkAttributes()
+{
+    ColTypeInt32 ctInt32;
+    ColTypeDim ctDim;
+    ColTypeString ctString7(7);
+    SerialDataCollector dc(10);
+
+    int32_t int_value = 42;
+    double double_value = 2.5;
+    Dimensions dim_value(1, 2, 3);
+    char text[8] = "splash!";
+    const char *var_text = "variable";
+
+    SerialDataCollector::AttributeEntry entries[] = {
+        {"int", &ctInt32, &int_value},
+        {"double", &ctDouble, &double_value},
+        {"dim", &ctDim, dim_value.getPointer()},
+        {"text", &ctString7, text},
+        {"vartext", &ctString, &var_text}
+    };
+    const size_t num_entries = sizeof (entries) / sizeof (entries[0]);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_CREATE;
+    dc.open(TEST_FILE_BULK, fattr);
+
+    int data[10] = {0};
+    dc.write(0, ctInt32, 1, Selection(Dimensions(10, 1, 1)), "data", data);
+
+    // dataset, iteration group and a new group
+    const char *data_names[] = {"data", NULL, "group/sub"};
+    for (size_t i = 0; i < 3; ++i)
+        dc.writeAttributes(0, data_names[i], entries, num_entries);
+
+    dc.close();
+
+    fattr.fileAccType = DataCollector::FAT_WRITE;
+    dc.open(TEST_FILE_BULK, fattr);
+
+    // existing attributes are overwritten
+    int_value = 43;
+    for (size_t i = 0; i < 3; ++i)
+        dc.writeAttributes(0, data_names[i], entries, 1);
+
+    // not cached while writing
+    for (size_t i = 0; i < 3; ++i)
+        checkBulkAttributes(dc, data_names[i]);
+
+    dc.close();
+
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dc.open(TEST_FILE_BULK, fattr);
+
+    // loaded into the cache and read from the cache
+    for (size_t r = 0; r < 2; ++r)
+        for (size_t i = 0; i < 3; ++i)
+            checkBulkAttributes(dc, data_names[i]);
+
+    dc.setAttributeCacheSize(0);
+    for (size_t i = 0; i < 3; ++i)
+        checkBulkAttributes(dc, data_names[i]);
+
+    dc.setAttributeCacheSize(1024);
+    dc.close();
+}
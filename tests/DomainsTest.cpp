@@ -20,18 +20,30 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <time.h>
 #include <stdlib.h>
 #include <string.h>
 #include <mpi.h>
 
 #include "DomainsTest.h"
+#include "splash/DistributedDomainCollector.hpp"
+#include "splash/core/DomainIndex.hpp"
 
 CPPUNIT_TEST_SUITE_REGISTRATION(DomainsTest);
 
 const char* hdf5_file_grid = "h5/testDomainsGrid";
 const char* hdf5_file_poly = "h5/testDomainsPoly";
 const char* hdf5_file_append = "h5/testDomainsAppend";
+const char* hdf5_file_table = "h5/testDomainsTable";
+const char* hdf5_file_collective = "h5/testDomainsCollective";
+const char* hdf5_file_strided = "h5/testDomainsStrided";
+const char* hdf5_file_filtered = "h5/testDomainsFiltered";
+const char* hdf5_file_lazy = "h5/testDomainsLazy";
+const char* hdf5_file_into = "h5/testDomainsInto";
+const char* hdf5_file_tiled = "h5/testDomainsTiled";
+const char* hdf5_file_packed = "h5/testDomainsPacked";
+const char* hdf5_file_threaded = "h5/testDomainsThreaded";
 
 using namespace splash;
 
@@ -629,3 +641,1116 @@ void DomainsTest::testAppendDomains()
 
     MPI_Barrier(MPI_COMM_WORLD);
 }
+
+void DomainsTest::testDomainIndex()
+{
+    // 8x6 domains of a moving window, shifted by three domains in x
+    std::vector<Domain> domains;
+    const Dimensions domain_size(5, 4, 1);
+    for (size_t y = 0; y < 6; ++y)
+        for (size_t x = 0; x < 8; ++x)
+        {
+            domains.push_back(Domain(
+                    Dimensions(((x + 3) % 8) * domain_size[0], y * domain_size[1], 0),
+                    domain_size));
+        }
+
+    DomainIndex index;
+    index.build(domains);
+    CPPUNIT_ASSERT(index.getSize() == domains.size());
+
+    // query results must match testing every domain
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const Dimensions offset(rand() % 40, rand() % 24, 0);
+        const Dimensions size(1 + rand() % (40 - offset[0]),
+                1 + rand() % (24 - offset[1]), 1);
+        const Domain request(offset, size);
+
+        std::vector<size_t> result;
+        index.query(request, result);
+
+        std::vector<size_t> expected;
+        for (size_t d = 0; d < domains.size(); ++d)
+        {
+            if (Domain::testIntersection(request, domains[d]))
+                expected.push_back(d);
+        }
+
+        CPPUNIT_ASSERT(result == expected);
+    }
+
+    std::vector<size_t> result;
+    index.query(Domain(Dimensions(100, 100, 0), Dimensions(1, 1, 1)), result);
+    CPPUNIT_ASSERT(result.empty());
+
+    index.clear();
+    index.query(Domain(Dimensions(0, 0, 0), Dimensions(1, 1, 1)), result);
+    CPPUNIT_ASSERT(result.empty());
+}
+
+void DomainsTest::testElementAccess()
+{
+    DataContainer container;
+    CPPUNIT_ASSERT(container.getNumElements() == 0);
+    CPPUNIT_ASSERT(container.getElement(0) == NULL);
+
+    // subdomains of varying size including empty ones
+    size_t num_elements = 0;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        const size_t elements = (i % 7 == 3) ? 0 : rand() % 50;
+        DomainData *subdomain = new DomainData(
+                Domain(Dimensions(i, 0, 0), Dimensions(1, 1, 1)),
+                Dimensions(elements, 1, 1), sizeof (int), DCDT_INT32);
+
+        for (size_t j = 0; j < elements; ++j)
+            ((int*) subdomain->getData())[j] = num_elements + j;
+
+        container.add(subdomain);
+        CPPUNIT_ASSERT(container.getSubdomainOffset(i) == num_elements);
+        num_elements += elements;
+    }
+
+    CPPUNIT_ASSERT(container.getNumElements() == num_elements);
+    CPPUNIT_ASSERT(container.getElement(num_elements) == NULL);
+
+    for (size_t i = 0; i < num_elements; ++i)
+    {
+        CPPUNIT_ASSERT(*((int*) container.getElement(i)) == (int) i);
+
+        const size_t subdomain = container.findSubdomain(i);
+        CPPUNIT_ASSERT(container.getIndex(subdomain)->getElements().getScalarSize() > 0);
+        CPPUNIT_ASSERT(container.getSubdomainOffset(subdomain) <= i);
+    }
+
+    size_t next_index = 0;
+    for (size_t i = 0; i < container.getNumSubdomains(); ++i)
+    {
+        ElementSpan<int> span = container.getSpan<int>(i);
+        CPPUNIT_ASSERT(span.getFirstIndex() == next_index);
+
+        for (int *iter = span.begin(); iter != span.end(); ++iter)
+            CPPUNIT_ASSERT(*iter == (int) (next_index++));
+    }
+    CPPUNIT_ASSERT(next_index == num_elements);
+
+    CPPUNIT_ASSERT_THROW(container.getSpan<double>(0), DCException);
+}
+
+void DomainsTest::testDomainTable()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(2, 2, 1);
+        const Dimensions local_size(4, 3, 1);
+        const Dimensions global_offset(10, 20, 0);
+        const Dimensions global_size(8, 6, 1);
+
+        std::vector<DomainTableEntry> table;
+        for (size_t y = 0; y < mpi_size[1]; ++y)
+            for (size_t x = 0; x < mpi_size[0]; ++x)
+            {
+                const Dimensions mpi_position(x, y, 0);
+                const Dimensions local_offset(x * local_size[0], y * local_size[1], 0);
+                table.push_back(DomainTableEntry(mpi_position,
+                        Domain(local_offset + global_offset, local_size),
+                        Dimensions(0, 0, 0), local_size, IDomainCollector::GridType));
+            }
+
+        int data_write[12];
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            const Dimensions &mpi_position = table[i].mpiPosition;
+
+            DataCollector::FileCreationAttr fattr;
+            fattr.fileAccType = DataCollector::FAT_CREATE;
+            fattr.mpiSize.set(mpi_size);
+            fattr.mpiPosition.set(mpi_position);
+            dataCollector->open(hdf5_file_table, fattr);
+
+            for (size_t j = 0; j < local_size.getScalarSize(); ++j)
+                data_write[j] = i * 100 + j;
+
+            dataCollector->writeDomain(0, ctInt, 2, Selection(local_size), "grid_data",
+                    Domain(table[i].domain.getOffset() - global_offset, local_size),
+                    Domain(global_offset, global_size),
+                    IDomainCollector::GridType, data_write);
+
+            // the table of all processes is written by the first one
+            if (i == 0)
+                dataCollector->writeDomainTable(0, "grid_data", table);
+
+            dataCollector->close();
+        }
+
+        DataCollector::FileCreationAttr fattr;
+        fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fattr.mpiSize.set(mpi_size);
+        dataCollector->open(hdf5_file_table, fattr);
+
+        std::vector<DomainTableEntry> table_read;
+        CPPUNIT_ASSERT(dataCollector->readDomainTable(0, "grid_data", table_read));
+        CPPUNIT_ASSERT(table_read.size() == table.size());
+        for (size_t i = 0; i < table.size(); ++i)
+        {
+            CPPUNIT_ASSERT(table_read[i].mpiPosition == table[i].mpiPosition);
+            CPPUNIT_ASSERT(table_read[i].domain.getOffset() == table[i].domain.getOffset());
+            CPPUNIT_ASSERT(table_read[i].domain.getSize() == table[i].domain.getSize());
+            CPPUNIT_ASSERT(table_read[i].elements == table[i].elements);
+            CPPUNIT_ASSERT(table_read[i].dataClass == IDomainCollector::GridType);
+        }
+
+        CPPUNIT_ASSERT(!dataCollector->readDomainTable(0, "missing_data", table_read));
+        CPPUNIT_ASSERT(table_read.empty());
+
+        // read a subdomain crossing all four files
+        const Domain request(Dimensions(12, 21, 0), Dimensions(4, 4, 1));
+        IDomainCollector::DomDataClass data_class = IDomainCollector::UndefinedType;
+        DataContainer *container = dataCollector->readDomain(0, "grid_data",
+                request, &data_class);
+
+        CPPUNIT_ASSERT(data_class == IDomainCollector::GridType);
+        CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+
+        int *data_read = (int*) (container->getIndex(0)->getData());
+        for (size_t y = 0; y < request.getSize()[1]; ++y)
+            for (size_t x = 0; x < request.getSize()[0]; ++x)
+            {
+                const size_t gx = request.getOffset()[0] - global_offset[0] + x;
+                const size_t gy = request.getOffset()[1] - global_offset[1] + y;
+                const size_t file = (gy / local_size[1]) * mpi_size[0] + gx / local_size[0];
+                const size_t lx = gx % local_size[0];
+                const size_t ly = gy % local_size[1];
+
+                CPPUNIT_ASSERT(data_read[y * request.getSize()[0] + x] ==
+                        (int) (file * 100 + ly * local_size[0] + lx));
+            }
+
+        delete container;
+        dataCollector->close();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void DomainsTest::testCollectiveRead()
+{
+    const Dimensions mpi_size(3, 2, 1);
+    const Dimensions local_size(4, 3, 1);
+    const Dimensions global_size(local_size * mpi_size);
+
+    if (totalMpiRank == 0)
+    {
+        int data_write[12];
+        for (size_t y = 0; y < mpi_size[1]; ++y)
+            for (size_t x = 0; x < mpi_size[0]; ++x)
+            {
+                const size_t file = y * mpi_size[0] + x;
+                const Domain local_domain(
+                        Dimensions(x * local_size[0], y * local_size[1], 0), local_size);
+
+                DataCollector::FileCreationAttr fattr;
+                fattr.fileAccType = DataCollector::FAT_CREATE;
+                fattr.mpiSize.set(mpi_size);
+                fattr.mpiPosition.set(x, y, 0);
+                dataCollector->open(hdf5_file_collective, fattr);
+
+                for (size_t j = 0; j < local_size.getScalarSize(); ++j)
+                    data_write[j] = file * 100 + j;
+
+                dataCollector->writeDomain(0, ctInt, 2, Selection(local_size), "grid_data",
+                        local_domain, Domain(Dimensions(0, 0, 0), global_size),
+                        IDomainCollector::GridType, data_write);
+
+                dataCollector->writeDomain(0, ctInt, 1,
+                        Selection(Dimensions(file + 1, 1, 1)), "poly_data",
+                        local_domain, Domain(Dimensions(0, 0, 0), global_size),
+                        IDomainCollector::PolyType, data_write);
+
+                dataCollector->close();
+            }
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+    fattr.mpiSize.set(mpi_size);
+
+    DistributedDomainCollector distCollector(MPI_COMM_WORLD, 3);
+    distCollector.open(hdf5_file_collective, fattr);
+    dataCollector->open(hdf5_file_collective, fattr);
+
+    // every process requests a different subdomain,
+    // the last process does not request any data
+    srand(totalMpiRank);
+    for (size_t i = 0; i < 4; ++i)
+    {
+        Dimensions offset(rand() % global_size[0], rand() % global_size[1], 0);
+        Dimensions size(1 + rand() % (global_size[0] - offset[0]),
+                1 + rand() % (global_size[1] - offset[1]), 1);
+        if (totalMpiRank == totalMpiSize - 1)
+            size.set(0, 0, 0);
+
+        const Domain request(offset, size);
+        const char *names[] = {"grid_data", "poly_data"};
+
+        for (size_t n = 0; n < 2; ++n)
+        {
+            IDomainCollector::DomDataClass expected_class = IDomainCollector::UndefinedType;
+            DataContainer *expected = dataCollector->readDomain(0, names[n],
+                    request, &expected_class);
+
+            IDomainCollector::DomDataClass data_class = IDomainCollector::UndefinedType;
+            DataContainer *container = distCollector.readDomainCollective(0, names[n],
+                    request, &data_class);
+
+            CPPUNIT_ASSERT(data_class == expected_class);
+            CPPUNIT_ASSERT(container->getNumSubdomains() == expected->getNumSubdomains());
+            CPPUNIT_ASSERT(container->getNumElements() == expected->getNumElements());
+
+            for (size_t d = 0; d < container->getNumSubdomains(); ++d)
+            {
+                DomainData *subdomain = container->getIndex(d);
+                DomainData *expected_subdomain = expected->getIndex(d);
+
+                CPPUNIT_ASSERT(subdomain->getOffset() == expected_subdomain->getOffset());
+                CPPUNIT_ASSERT(subdomain->getElements() == expected_subdomain->getElements());
+                CPPUNIT_ASSERT(memcmp(subdomain->getData(), expected_subdomain->getData(),
+                        subdomain->getElements().getScalarSize() * sizeof (int)) == 0);
+            }
+
+            delete container;
+            delete expected;
+        }
+    }
+
+    distCollector.close();
+    dataCollector->close();
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void DomainsTest::testStridedDomains()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(2, 2, 2);
+        const Dimensions local_size(5, 4, 3);
+        const Dimensions global_size(local_size * mpi_size);
+        const Domain global_domain(Dimensions(0, 0, 0), global_size);
+
+        // grid elements are set to their global index
+        int data_write[5 * 4 * 3];
+        for (size_t z = 0; z < mpi_size[2]; ++z)
+            for (size_t y = 0; y < mpi_size[1]; ++y)
+                for (size_t x = 0; x < mpi_size[0]; ++x)
+                {
+                    const size_t file = (z * mpi_size[1] + y) * mpi_size[0] + x;
+                    const Dimensions local_offset(Dimensions(x, y, z) * local_size);
+
+                    DataCollector::FileCreationAttr fattr;
+                    fattr.fileAccType = DataCollector::FAT_CREATE;
+                    fattr.mpiSize.set(mpi_size);
+                    fattr.mpiPosition.set(x, y, z);
+                    dataCollector->open(hdf5_file_strided, fattr);
+
+                    for (size_t i = 0; i < local_size.getScalarSize(); ++i)
+                    {
+                        const size_t gx = local_offset[0] + i % local_size[0];
+                        const size_t gy = local_offset[1] + (i / local_size[0]) % local_size[1];
+                        const size_t gz = local_offset[2] + i / (local_size[0] * local_size[1]);
+                        data_write[i] = (gz * global_size[1] + gy) * global_size[0] + gx;
+                    }
+
+                    dataCollector->writeDomain(0, ctInt, 3, Selection(local_size), "grid_data",
+                            Domain(local_offset, local_size), global_domain,
+                            IDomainCollector::GridType, data_write);
+
+                    for (size_t i = 0; i < file + 7; ++i)
+                        data_write[i] = file * 100 + i;
+
+                    dataCollector->writeDomain(0, ctInt, 1, Selection(Dimensions(file + 7, 1, 1)),
+                            "poly_data", Domain(local_offset, local_size), global_domain,
+                            IDomainCollector::PolyType, data_write);
+
+                    dataCollector->close();
+                }
+
+        DataCollector::FileCreationAttr fattr;
+        DataCollector::initFileCreationAttr(fattr);
+        fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fattr.mpiSize.set(mpi_size);
+        dataCollector->open(hdf5_file_strided, fattr);
+
+        for (size_t i = 0; i < 20; ++i)
+        {
+            const Dimensions offset(rand() % global_size[0], rand() % global_size[1],
+                    rand() % global_size[2]);
+            const Dimensions size(1 + rand() % (global_size[0] - offset[0]),
+                    1 + rand() % (global_size[1] - offset[1]),
+                    1 + rand() % (global_size[2] - offset[2]));
+            const Dimensions stride(1 + rand() % 4, 1 + rand() % 4, 1 + rand() % 3);
+            const Domain request(offset, size);
+
+            IDomainCollector::DomDataClass data_class = IDomainCollector::UndefinedType;
+            DataContainer *container = dataCollector->readDomain(0, "grid_data",
+                    request, stride, &data_class);
+
+            CPPUNIT_ASSERT(data_class == IDomainCollector::GridType);
+            CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+
+            DomainData *subdomain = container->getIndex(0);
+            const Dimensions elements = subdomain->getElements();
+            for (uint32_t d = 0; d < 3; ++d)
+                CPPUNIT_ASSERT(elements[d] == (size[d] + stride[d] - 1) / stride[d]);
+
+            int *data_read = (int*) (subdomain->getData());
+            for (size_t z = 0; z < elements[2]; ++z)
+                for (size_t y = 0; y < elements[1]; ++y)
+                    for (size_t x = 0; x < elements[0]; ++x)
+                    {
+                        const size_t gx = offset[0] + x * stride[0];
+                        const size_t gy = offset[1] + y * stride[1];
+                        const size_t gz = offset[2] + z * stride[2];
+
+                        CPPUNIT_ASSERT(data_read[(z * elements[1] + y) * elements[0] + x] ==
+                                (int) ((gz * global_size[1] + gy) * global_size[0] + gx));
+                    }
+
+            delete container;
+        }
+
+        // every third particle of every file
+        IDomainCollector::DomDataClass data_class = IDomainCollector::UndefinedType;
+        DataContainer *container = dataCollector->readDomain(0, "poly_data",
+                global_domain, Dimensions(3, 1, 1), &data_class);
+
+        CPPUNIT_ASSERT(data_class == IDomainCollector::PolyType);
+        CPPUNIT_ASSERT(container->getNumSubdomains() == mpi_size.getScalarSize());
+
+        for (size_t file = 0; file < container->getNumSubdomains(); ++file)
+        {
+            DomainData *subdomain = container->getIndex(file);
+            CPPUNIT_ASSERT(subdomain->getElements() == Dimensions((file + 9) / 3, 1, 1));
+
+            int *data_read = (int*) (subdomain->getData());
+            for (size_t i = 0; i < subdomain->getElements()[0]; ++i)
+                CPPUNIT_ASSERT(data_read[i] == (int) (file * 100 + i * 3));
+        }
+
+        delete container;
+        dataCollector->close();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void DomainsTest::testPolyFiltered()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(2, 2, 1);
+        const Dimensions local_size(8, 8, 1);
+        const Dimensions global_size(local_size * mpi_size);
+        const Domain global_domain(Dimensions(0, 0, 0), global_size);
+
+        std::vector<std::vector<float> > pos_x(mpi_size.getScalarSize());
+        std::vector<std::vector<float> > pos_y(mpi_size.getScalarSize());
+
+        for (size_t y = 0; y < mpi_size[1]; ++y)
+            for (size_t x = 0; x < mpi_size[0]; ++x)
+            {
+                const size_t file = y * mpi_size[0] + x;
+                const Dimensions local_offset(Dimensions(x, y, 0) * local_size);
+                const Domain local_domain(local_offset, local_size);
+                const size_t num_elements = 500 + file * 37;
+
+                DataCollector::FileCreationAttr fattr;
+                fattr.fileAccType = DataCollector::FAT_CREATE;
+                fattr.mpiSize.set(mpi_size);
+                fattr.mpiPosition.set(x, y, 0);
+                dataCollector->open(hdf5_file_filtered, fattr);
+
+                // the last file has no statistics
+                dataCollector->setStatisticsBlockSize(
+                        (file + 1 < mpi_size.getScalarSize()) ? 32 : 0);
+
+                // positions on a quarter-cell raster to hit domain borders
+                std::vector<int> ids(num_elements);
+                for (size_t i = 0; i < num_elements; ++i)
+                {
+                    pos_x[file].push_back(local_offset[0] + (rand() % (local_size[0] * 4)) / 4.0f);
+                    pos_y[file].push_back(local_offset[1] + (rand() % (local_size[1] * 4)) / 4.0f);
+                    ids[i] = file * 10000 + i;
+                }
+
+                const Selection select(Dimensions(num_elements, 1, 1));
+                dataCollector->writeDomain(0, ctFloat, 1, select, "position_x",
+                        local_domain, global_domain, IDomainCollector::PolyType,
+                        &(pos_x[file][0]));
+                dataCollector->writeDomain(0, ctFloat, 1, select, "position_y",
+                        local_domain, global_domain, IDomainCollector::PolyType,
+                        &(pos_y[file][0]));
+                dataCollector->writeDomain(0, ctInt, 1, select, "ids",
+                        local_domain, global_domain, IDomainCollector::PolyType,
+                        &(ids[0]));
+
+                dataCollector->close();
+            }
+
+        dataCollector->setStatisticsBlockSize(0);
+
+        DataCollector::FileCreationAttr fattr;
+        DataCollector::initFileCreationAttr(fattr);
+        fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fattr.mpiSize.set(mpi_size);
+        dataCollector->open(hdf5_file_filtered, fattr);
+
+        std::vector<std::string> position_names;
+        position_names.push_back("position_x");
+        position_names.push_back("position_y");
+
+        std::vector<std::string> names;
+        names.push_back("ids");
+        names.push_back("position_x");
+
+        for (size_t r = 0; r < 20; ++r)
+        {
+            const Dimensions offset(rand() % global_size[0], rand() % global_size[1], 0);
+            const Dimensions size(1 + rand() % (global_size[0] - offset[0]),
+                    1 + rand() % (global_size[1] - offset[1]), 1);
+            const Domain request(offset, size);
+
+            std::vector<DataContainer*> containers;
+            dataCollector->readPolyDomain(0, request, position_names, names, containers);
+            CPPUNIT_ASSERT(containers.size() == names.size());
+
+            std::vector<int> ids_read;
+            for (size_t i = 0; i < containers[0]->getNumSubdomains(); ++i)
+            {
+                DomainData *ids_data = containers[0]->getIndex(i);
+                DomainData *x_data = containers[1]->getIndex(i);
+                CPPUNIT_ASSERT(ids_data->getElements() == x_data->getElements());
+
+                for (size_t j = 0; j < ids_data->getElements()[0]; ++j)
+                    ids_read.push_back(((int*) ids_data->getData())[j]);
+            }
+
+            // compare with all particles in the request
+            std::vector<int> ids_expected;
+            for (size_t file = 0; file < pos_x.size(); ++file)
+                for (size_t i = 0; i < pos_x[file].size(); ++i)
+                {
+                    if (pos_x[file][i] >= offset[0] && pos_x[file][i] < offset[0] + size[0] &&
+                            pos_y[file][i] >= offset[1] && pos_y[file][i] < offset[1] + size[1])
+                        ids_expected.push_back(file * 10000 + i);
+                }
+
+            std::sort(ids_read.begin(), ids_read.end());
+            CPPUNIT_ASSERT(ids_read == ids_expected);
+
+            for (size_t i = 0; i < containers[0]->getNumSubdomains(); ++i)
+            {
+                DomainData *ids_data = containers[0]->getIndex(i);
+                DomainData *x_data = containers[1]->getIndex(i);
+                for (size_t j = 0; j < ids_data->getElements()[0]; ++j)
+                {
+                    const int id = ((int*) ids_data->getData())[j];
+                    CPPUNIT_ASSERT(((float*) x_data->getData())[j] ==
+                            pos_x[id / 10000][id % 10000]);
+                }
+            }
+
+            for (size_t i = 0; i < containers.size(); ++i)
+                delete containers[i];
+        }
+
+        dataCollector->close();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void DomainsTest::testLazyPaging()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(2, 1, 1);
+        const Dimensions local_size(10, 10, 1);
+        const Domain global_domain(Dimensions(0, 0, 0), local_size * mpi_size);
+        const size_t num_elements = 10000;
+
+        std::vector<int> data_write(num_elements);
+        for (size_t x = 0; x < mpi_size[0]; ++x)
+        {
+            DataCollector::FileCreationAttr fattr;
+            fattr.fileAccType = DataCollector::FAT_CREATE;
+            fattr.mpiSize.set(mpi_size);
+            fattr.mpiPosition.set(x, 0, 0);
+            dataCollector->open(hdf5_file_lazy, fattr);
+
+            for (size_t i = 0; i < num_elements; ++i)
+                data_write[i] = x * num_elements + i;
+
+            dataCollector->writeDomain(0, ctInt, 1, Selection(Dimensions(num_elements, 1, 1)),
+                    "poly_data", Domain(Dimensions(x * local_size[0], 0, 0), local_size),
+                    global_domain, IDomainCollector::PolyType, &(data_write[0]));
+
+            dataCollector->close();
+        }
+
+        DataCollector::FileCreationAttr fattr;
+        DataCollector::initFileCreationAttr(fattr);
+        fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fattr.mpiSize.set(mpi_size);
+        dataCollector->open(hdf5_file_lazy, fattr);
+
+        // cache holds 8 pages of 256 elements
+        dataCollector->setLazyPageCache(1024, 8 * 1024);
+
+        DataContainer *container = dataCollector->readDomain(0, "poly_data",
+                global_domain, NULL, true);
+        CPPUNIT_ASSERT(container->getNumSubdomains() == mpi_size[0]);
+        CPPUNIT_ASSERT(container->getNumElements() == mpi_size[0] * num_elements);
+
+        for (size_t x = 0; x < mpi_size[0]; ++x)
+        {
+            CPPUNIT_ASSERT(container->getIndex(x)->getData() == NULL);
+            CPPUNIT_ASSERT(container->getIndex(x)->isPaged());
+        }
+
+        for (size_t i = 0; i < 1000; ++i)
+        {
+            const size_t index = rand() % (mpi_size[0] * num_elements);
+            CPPUNIT_ASSERT(*((int*) container->getElement(index)) == (int) index);
+        }
+
+        DomainData *subdomain = container->getIndex(1);
+        std::vector<int> data_read(num_elements);
+        for (size_t i = 0; i < 100; ++i)
+        {
+            const size_t first = rand() % num_elements;
+            const size_t count = rand() % (num_elements - first + 1) / ((i % 2) ? 1 : 50);
+
+            subdomain->readElements(first, count, &(data_read[0]));
+            for (size_t j = 0; j < count; ++j)
+                CPPUNIT_ASSERT(data_read[j] == (int) (num_elements + first + j));
+        }
+
+        // complete loading is still possible
+        dataCollector->readDomainLazy(subdomain);
+        CPPUNIT_ASSERT(!subdomain->isPaged());
+        for (size_t i = 0; i < num_elements; ++i)
+            CPPUNIT_ASSERT(((int*) subdomain->getData())[i] == (int) (num_elements + i));
+
+        delete container;
+
+        // without cache, lazy subdomains are allocated completely
+        dataCollector->setLazyPageCache(1024, 0);
+        container = dataCollector->readDomain(0, "poly_data", global_domain, NULL, true);
+        CPPUNIT_ASSERT(container->getIndex(0)->getData() != NULL);
+        CPPUNIT_ASSERT(!container->getIndex(0)->isPaged());
+        delete container;
+
+        dataCollector->setLazyPageCache(256 * 1024, 64 * 1024 * 1024);
+        dataCollector->close();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void DomainsTest::testReadInto()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(2, 2, 1);
+        const Dimensions local_size(6, 5, 4);
+        const Dimensions global_size(local_size * mpi_size);
+        const Domain global_domain(Dimensions(0, 0, 0), global_size);
+
+        // grid elements are set to their global index
+        int data_write[6 * 5 * 4];
+        for (size_t y = 0; y < mpi_size[1]; ++y)
+            for (size_t x = 0; x < mpi_size[0]; ++x)
+            {
+                const size_t file = y * mpi_size[0] + x;
+                const Dimensions local_offset(Dimensions(x, y, 0) * local_size);
+
+                DataCollector::FileCreationAttr fattr;
+                fattr.fileAccType = DataCollector::FAT_CREATE;
+                fattr.mpiSize.set(mpi_size);
+                fattr.mpiPosition.set(x, y, 0);
+                dataCollector->open(hdf5_file_into, fattr);
+
+                for (size_t i = 0; i < local_size.getScalarSize(); ++i)
+                {
+                    const size_t gx = local_offset[0] + i % local_size[0];
+                    const size_t gy = local_offset[1] + (i / local_size[0]) % local_size[1];
+                    const size_t gz = i / (local_size[0] * local_size[1]);
+                    data_write[i] = (gz * global_size[1] + gy) * global_size[0] + gx;
+                }
+
+                dataCollector->writeDomain(0, ctInt, 3, Selection(local_size), "grid_data",
+                        Domain(local_offset, local_size), global_domain,
+                        IDomainCollector::GridType, data_write);
+
+                const size_t num_elements = file + 5;
+                for (size_t i = 0; i < num_elements; ++i)
+                    data_write[i] = file * 100 + i;
+
+                dataCollector->writeDomain(0, ctInt, 1, Selection(Dimensions(num_elements, 1, 1)),
+                        "poly_data", Domain(local_offset, local_size), global_domain,
+                        IDomainCollector::PolyType, data_write);
+
+                dataCollector->close();
+            }
+
+        DataCollector::FileCreationAttr fattr;
+        DataCollector::initFileCreationAttr(fattr);
+        fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fattr.mpiSize.set(mpi_size);
+        dataCollector->open(hdf5_file_into, fattr);
+
+        for (size_t r = 0; r < 20; ++r)
+        {
+            const Dimensions offset(rand() % global_size[0], rand() % global_size[1],
+                    rand() % global_size[2]);
+            const Dimensions size(1 + rand() % (global_size[0] - offset[0]),
+                    1 + rand() % (global_size[1] - offset[1]),
+                    1 + rand() % (global_size[2] - offset[2]));
+            const Domain request(offset, size);
+
+            // request is placed with an offset and stride in a larger buffer
+            const Dimensions dst_offset(rand() % 3, rand() % 3, rand() % 2);
+            const Dimensions dst_stride(1 + rand() % 2, 1 + rand() % 2, 1);
+            const Dimensions buffer_size(dst_offset + size * dst_stride);
+            std::vector<int> buffer(buffer_size.getScalarSize(), -1);
+
+            Dimensions size_read;
+            IDomainCollector::DomDataClass data_class = IDomainCollector::UndefinedType;
+            dataCollector->readDomainInto(0, "grid_data", request,
+                    Selection(buffer_size, size, dst_offset, dst_stride),
+                    size_read, &(buffer[0]), &data_class);
+
+            CPPUNIT_ASSERT(data_class == IDomainCollector::GridType);
+            CPPUNIT_ASSERT(size_read == size);
+
+            for (size_t z = 0; z < buffer_size[2]; ++z)
+                for (size_t y = 0; y < buffer_size[1]; ++y)
+                    for (size_t x = 0; x < buffer_size[0]; ++x)
+                    {
+                        const int value = buffer[(z * buffer_size[1] + y) * buffer_size[0] + x];
+                        const Dimensions pos(x, y, z);
+
+                        bool inside = true;
+                        for (uint32_t d = 0; d < 3; ++d)
+                        {
+                            if (pos[d] < dst_offset[d] || (pos[d] - dst_offset[d]) % dst_stride[d] != 0)
+                                inside = false;
+                        }
+
+                        if (!inside)
+                        {
+                            CPPUNIT_ASSERT(value == -1);
+                            continue;
+                        }
+
+                        const size_t gx = offset[0] + (x - dst_offset[0]) / dst_stride[0];
+                        const size_t gy = offset[1] + (y - dst_offset[1]) / dst_stride[1];
+                        const size_t gz = offset[2] + (z - dst_offset[2]) / dst_stride[2];
+                        CPPUNIT_ASSERT(value ==
+                                (int) ((gz * global_size[1] + gy) * global_size[0] + gx));
+                    }
+        }
+
+        // planning pass returns the number of particles only
+        Dimensions size_read;
+        dataCollector->readDomainInto(0, "poly_data", global_domain,
+                Selection(Dimensions(1, 1, 1)), size_read, NULL);
+        CPPUNIT_ASSERT(size_read == Dimensions(5 + 6 + 7 + 8, 1, 1));
+
+        // particles are concatenated, every second element is written
+        std::vector<int> buffer(2 * size_read[0] + 1, -1);
+        dataCollector->readDomainInto(0, "poly_data", global_domain,
+                Selection(Dimensions(buffer.size(), 1, 1), size_read,
+                Dimensions(1, 0, 0), Dimensions(2, 1, 1)), size_read, &(buffer[0]));
+
+        DataContainer *container = dataCollector->readDomain(0, "poly_data",
+                global_domain, NULL);
+        CPPUNIT_ASSERT(container->getNumElements() == size_read[0]);
+
+        for (size_t i = 0; i < buffer.size(); ++i)
+        {
+            if (i % 2 == 0)
+                CPPUNIT_ASSERT(buffer[i] == -1);
+            else
+                CPPUNIT_ASSERT(buffer[i] == *((int*) container->getElement(i / 2)));
+        }
+
+        delete container;
+
+        CPPUNIT_ASSERT_THROW(dataCollector->readDomainInto(0, "poly_data", global_domain,
+                Selection(Dimensions(size_read[0] - 1, 1, 1)), size_read, &(buffer[0])),
+                DCException);
+
+        dataCollector->close();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+/**
+ * Copies Grid tiles to their position in a buffer of the request
+ * and appends Poly tiles.
+ */
+class TileCollector : public DomainTileHandler
+{
+public:
+
+    TileCollector(const Domain &request, size_t maxTileBytes, bool polyData) :
+    request(request),
+    maxTileBytes(maxTileBytes),
+    polyData(polyData),
+    grid(request.getSize().getScalarSize(), -1)
+    {
+    }
+
+    void processTile(DomainData &tile) throw (DCException)
+    {
+        const Dimensions elements = tile.getElements();
+        CPPUNIT_ASSERT(elements.getScalarSize() > 0);
+        CPPUNIT_ASSERT(elements.getScalarSize() * sizeof (int) <= maxTileBytes);
+        CPPUNIT_ASSERT(tile.getTypeSize() == sizeof (int));
+
+        const int *data = (const int*) tile.getData();
+        if (polyData)
+        {
+            poly.insert(poly.end(), data, data + elements[0]);
+            return;
+        }
+
+        const Dimensions offset(tile.getOffset() - request.getOffset());
+        const Dimensions &size = request.getSize();
+        for (size_t i = 0; i < elements.getScalarSize(); ++i)
+        {
+            const size_t x = offset[0] + i % elements[0];
+            const size_t y = offset[1] + (i / elements[0]) % elements[1];
+            const size_t z = offset[2] + i / (elements[0] * elements[1]);
+            CPPUNIT_ASSERT(x < size[0] && y < size[1] && z < size[2]);
+
+            int &value = grid[(z * size[1] + y) * size[0] + x];
+            CPPUNIT_ASSERT(value == -1);
+            value = data[i];
+        }
+    }
+
+    Domain request;
+    size_t maxTileBytes;
+    bool polyData;
+    std::vector<int> grid;
+    std::vector<int> poly;
+};
+
+void DomainsTest::testReadTiled()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(2, 2, 1);
+        const Dimensions local_size(12, 10, 8);
+        const Dimensions global_size(local_size * mpi_size);
+        const Domain global_domain(Dimensions(0, 0, 0), global_size);
+
+        // grid elements are set to their global index
+        std::vector<int> data_write(local_size.getScalarSize());
+        for (size_t y = 0; y < mpi_size[1]; ++y)
+            for (size_t x = 0; x < mpi_size[0]; ++x)
+            {
+                const size_t file = y * mpi_size[0] + x;
+                const Dimensions local_offset(Dimensions(x, y, 0) * local_size);
+
+                DataCollector::FileCreationAttr fattr;
+                fattr.fileAccType = DataCollector::FAT_CREATE;
+                fattr.mpiSize.set(mpi_size);
+                fattr.mpiPosition.set(x, y, 0);
+                dataCollector->open(hdf5_file_tiled, fattr);
+
+                for (size_t i = 0; i < local_size.getScalarSize(); ++i)
+                {
+                    const size_t gx = local_offset[0] + i % local_size[0];
+                    const size_t gy = local_offset[1] + (i / local_size[0]) % local_size[1];
+                    const size_t gz = i / (local_size[0] * local_size[1]);
+                    data_write[i] = (gz * global_size[1] + gy) * global_size[0] + gx;
+                }
+
+                dataCollector->writeDomain(0, ctInt, 3, Selection(local_size), "grid_data",
+                        Domain(local_offset, local_size), global_domain,
+                        IDomainCollector::GridType, &(data_write[0]));
+
+                const size_t num_elements = 100 + file * 37;
+                for (size_t i = 0; i < num_elements; ++i)
+                    data_write[i] = file * 1000 + i;
+
+                dataCollector->writeDomain(0, ctInt, 1, Selection(Dimensions(num_elements, 1, 1)),
+                        "poly_data", Domain(local_offset, local_size), global_domain,
+                        IDomainCollector::PolyType, &(data_write[0]));
+
+                dataCollector->close();
+            }
+
+        DataCollector::FileCreationAttr fattr;
+        DataCollector::initFileCreationAttr(fattr);
+        fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fattr.mpiSize.set(mpi_size);
+        dataCollector->open(hdf5_file_tiled, fattr);
+
+        const size_t budgets[] = {sizeof (int), 7 * sizeof (int), 100 * sizeof (int),
+            1000 * sizeof (int), 1000000};
+
+        for (size_t r = 0; r < 20; ++r)
+        {
+            const Dimensions offset(rand() % global_size[0], rand() % global_size[1],
+                    rand() % global_size[2]);
+            const Dimensions size(1 + rand() % (global_size[0] - offset[0]),
+                    1 + rand() % (global_size[1] - offset[1]),
+                    1 + rand() % (global_size[2] - offset[2]));
+            const Domain request(offset, size);
+            const size_t budget = budgets[r % (sizeof (budgets) / sizeof (budgets[0]))];
+
+            TileCollector collector(request, budget, false);
+            IDomainCollector::DomDataClass data_class = IDomainCollector::UndefinedType;
+            const size_t num_tiles = dataCollector->readDomainTiled(0, "grid_data",
+                    request, budget, collector, &data_class);
+
+            CPPUNIT_ASSERT(data_class == IDomainCollector::GridType);
+            CPPUNIT_ASSERT(num_tiles > 0);
+            if (budget >= size.getScalarSize() * sizeof (int))
+                CPPUNIT_ASSERT(num_tiles <= 4);
+
+            for (size_t i = 0; i < collector.grid.size(); ++i)
+            {
+                const size_t gx = offset[0] + i % size[0];
+                const size_t gy = offset[1] + (i / size[0]) % size[1];
+                const size_t gz = offset[2] + i / (size[0] * size[1]);
+                CPPUNIT_ASSERT(collector.grid[i] ==
+                        (int) ((gz * global_size[1] + gy) * global_size[0] + gx));
+            }
+        }
+
+        // Poly elements arrive in the order of readDomain
+        DataContainer *container = dataCollector->readDomain(0, "poly_data",
+                global_domain, NULL);
+
+        for (size_t b = 0; b < sizeof (budgets) / sizeof (budgets[0]); ++b)
+        {
+            TileCollector collector(global_domain, budgets[b], true);
+            dataCollector->readDomainTiled(0, "poly_data", global_domain,
+                    budgets[b], collector);
+
+            CPPUNIT_ASSERT(collector.poly.size() == container->getNumElements());
+            for (size_t i = 0; i < collector.poly.size(); ++i)
+                CPPUNIT_ASSERT(collector.poly[i] == *((int*) container->getElement(i)));
+        }
+
+        delete container;
+
+        TileCollector collector(global_domain, 1, false);
+        CPPUNIT_ASSERT_THROW(dataCollector->readDomainTiled(0, "grid_data",
+                global_domain, 1, collector), DCException);
+
+        dataCollector->close();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void DomainsTest::testPackedAttributes()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(2, 2, 1);
+        const Dimensions local_size(4, 3, 1);
+        const Dimensions global_offset(10, 20, 0);
+        const Dimensions global_size(local_size * mpi_size);
+        const size_t num_files = mpi_size.getScalarSize();
+
+        // separate attributes only, packed attribute only, both
+        const char *names[] = {"separate_data", "packed_data", "both_data"};
+        const size_t num_names = sizeof (names) / sizeof (names[0]);
+
+        int data_write[12];
+        for (size_t y = 0; y < mpi_size[1]; ++y)
+            for (size_t x = 0; x < mpi_size[0]; ++x)
+            {
+                const size_t file = y * mpi_size[0] + x;
+                const Domain local_domain(
+                        Dimensions(x * local_size[0], y * local_size[1], 0), local_size);
+
+                DataCollector::FileCreationAttr fattr;
+                fattr.fileAccType = DataCollector::FAT_CREATE;
+                fattr.mpiSize.set(mpi_size);
+                fattr.mpiPosition.set(x, y, 0);
+                dataCollector->open(hdf5_file_packed, fattr);
+
+                for (size_t j = 0; j < local_size.getScalarSize(); ++j)
+                    data_write[j] = file * 100 + j;
+
+                for (size_t n = 0; n < num_names; ++n)
+                {
+                    dataCollector->setPackedDomainAttributes(n > 0, n == 2);
+                    dataCollector->writeDomain(0, ctInt, 2, Selection(local_size),
+                            names[n], local_domain, Domain(global_offset, global_size),
+                            IDomainCollector::GridType, data_write);
+                }
+
+                dataCollector->close();
+            }
+
+        dataCollector->setPackedDomainAttributes(false);
+
+        DataCollector::FileCreationAttr fattr;
+        fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+        fattr.mpiSize.set(mpi_size);
+        dataCollector->open(hdf5_file_packed, fattr);
+
+        // without the attribute cache, every file is probed by readDomain
+        dataCollector->setAttributeCacheSize(0);
+
+        uint64_t attribute_reads[num_names];
+        for (size_t n = 0; n < num_names; ++n)
+        {
+            const uint64_t reads = dataCollector->getNumAttributeReads();
+
+            IDomainCollector::DomDataClass data_class = IDomainCollector::UndefinedType;
+            DataContainer *container = dataCollector->readDomain(0, names[n],
+                    Domain(global_offset, global_size), &data_class);
+
+            attribute_reads[n] = dataCollector->getNumAttributeReads() - reads;
+
+            CPPUNIT_ASSERT(data_class == IDomainCollector::GridType);
+            CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+
+            int *data_read = (int*) (container->getIndex(0)->getData());
+            for (size_t gy = 0; gy < global_size[1]; ++gy)
+                for (size_t gx = 0; gx < global_size[0]; ++gx)
+                {
+                    const size_t file = (gy / local_size[1]) * mpi_size[0] + gx / local_size[0];
+                    const size_t lx = gx % local_size[0];
+                    const size_t ly = gy % local_size[1];
+
+                    CPPUNIT_ASSERT(data_read[gy * global_size[0] + gx] ==
+                            (int) (file * 100 + ly * local_size[0] + lx));
+                }
+
+            delete container;
+
+            CPPUNIT_ASSERT(dataCollector->getGlobalDomain(0, names[n]) ==
+                    Domain(global_offset, global_size));
+            CPPUNIT_ASSERT(dataCollector->getLocalDomain(0, names[n]) ==
+                    Domain(Dimensions(0, 0, 0), local_size));
+        }
+
+        CPPUNIT_ASSERT(attribute_reads[0] == 5 * num_files);
+        CPPUNIT_ASSERT(attribute_reads[1] == num_files);
+        CPPUNIT_ASSERT(attribute_reads[2] == num_files);
+
+        // packed only and separate only
+        bool thrown = false;
+        try
+        {
+            dataCollector->readAttributeInfo(0, names[1], DOMCOL_ATTR_SIZE);
+        } catch (const DCException&)
+        {
+            thrown = true;
+        }
+        CPPUNIT_ASSERT(thrown);
+
+        thrown = false;
+        try
+        {
+            dataCollector->readAttributeInfo(0, names[0], DOMCOL_ATTR_DOMAIN);
+        } catch (const DCException&)
+        {
+            thrown = true;
+        }
+        CPPUNIT_ASSERT(thrown);
+
+        dataCollector->setAttributeCacheSize(1024);
+        dataCollector->close();
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+void DomainsTest::testThreadedRead()
+{
+    if (totalMpiRank == 0)
+    {
+        const Dimensions mpi_size(4, 4, 1);
+        const Dimensions local_size(16, 8, 1);
+        const Dimensions global_size(local_size * mpi_size);
+
+        float data_write[16 * 8];
+        for (size_t y = 0; y < mpi_size[1]; ++y)
+            for (size_t x = 0; x < mpi_size[0]; ++x)
+            {
+                DataCollector::FileCreationAttr fattr;
+                fattr.fileAccType = DataCollector::FAT_CREATE;
+                fattr.mpiSize.set(mpi_size);
+                fattr.mpiPosition.set(x, y, 0);
+                dataCollector->open(hdf5_file_threaded, fattr);
+
+                const Dimensions offset(x * local_size[0], y * local_size[1], 0);
+                for (size_t i = 0; i < local_size.getScalarSize(); ++i)
+                    data_write[i] = (float) ((offset[1] + i / local_size[0]) *
+                        global_size[0] + offset[0] + i % local_size[0]);
+
+                dataCollector->writeDomain(0, ctFloat, 2, Selection(local_size), "grid",
+                        Domain(offset, local_size),
+                        Domain(Dimensions(0, 0, 0), global_size),
+                        IDomainCollector::GridType, data_write);
+
+                dataCollector->close();
+            }
+
+        // request a domain which crosses all files except the outer ones
+        const Domain request(Dimensions(local_size[0] / 2, local_size[1] / 2, 0),
+                Dimensions((mpi_size[0] - 1) * local_size[0],
+                (mpi_size[1] - 1) * local_size[1], 1));
+
+        const uint32_t threads[] = {1, 4};
+        for (size_t t = 0; t < sizeof (threads) / sizeof (threads[0]); ++t)
+        {
+            DataCollector::FileCreationAttr fattr;
+            fattr.fileAccType = DataCollector::FAT_READ_MERGED;
+            fattr.mpiSize.set(mpi_size);
+            dataCollector->setReadThreads(threads[t]);
+            dataCollector->open(hdf5_file_threaded, fattr);
+
+            // later reads reuse the raw locations kept with the domain index
+            for (size_t r = 0; r < 2; ++r)
+            {
+                DataContainer *container = dataCollector->readDomain(0, "grid",
+                        request, NULL);
+                CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+                CPPUNIT_ASSERT(container->getIndex(0)->getSize() == request.getSize());
+
+                const float *data_read = (const float*) container->getIndex(0)->getData();
+                const size_t width = request.getSize()[0];
+                for (size_t i = 0; i < request.getSize().getScalarSize(); ++i)
+                    CPPUNIT_ASSERT(data_read[i] == (float) ((request.getOffset()[1] +
+                        i / width) * global_size[0] + request.getOffset()[0] + i % width));
+
+                delete container;
+            }
+
+            dataCollector->close();
+        }
+
+        dataCollector->setReadThreads(1);
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
@@ -32,6 +32,10 @@ CPPUNIT_TEST_SUITE_REGISTRATION(Parallel_DomainsTest);
 const char* hdf5_file_grid = "h5/testDomainsGridParallel";
 const char* hdf5_file_poly = "h5/testDomainsPolyParallel";
 const char* hdf5_file_append = "h5/testDomainsAppendParallel";
+const char* hdf5_file_coll_append = "h5/testDomainsCollAppendParallel";
+const char* hdf5_file_redist = "h5/testDomainsRedistParallel";
+const char* hdf5_file_table = "h5/testDomainsTableParallel";
+const char* hdf5_file_strided = "h5/testDomainsStridedParallel";
 
 #define MPI_CHECK(cmd) \
         { \
@@ -595,3 +599,350 @@ void Parallel_DomainsTest::testAppendDomains()
 
     MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
 }
+
+void Parallel_DomainsTest::testCollectiveAppendDomains()
+{
+    const Dimensions mpi_size(totalMpiSize, 1, 1);
+    const Domain global_domain(Dimensions(0, 0, 0), Dimensions(100, 1, 1));
+    const size_t local_count = myMpiRank + 1;
+    const size_t total_count = (totalMpiSize * (totalMpiSize + 1)) / 2;
+
+    ParallelDomainCollector *pdc =
+            new ParallelDomainCollector(MPI_COMM_WORLD, MPI_INFO_NULL, mpi_size, 1);
+    DomainCollector::FileCreationAttr fAttr;
+    fAttr.fileAccType = DataCollector::FAT_CREATE;
+
+    pdc->open(hdf5_file_coll_append, fAttr);
+
+    // every process appends (rank + 1) elements per round, the first
+    // round creates the dataset, the second one extends it
+    int buffer[2 * local_count];
+    for (int m = 0; m < 2; ++m)
+    {
+        for (size_t i = 0; i < 2 * local_count; ++i)
+            buffer[i] = (i % 2 == 0) ? (m * 1000 + myMpiRank) : -1;
+
+        pdc->appendDomain(10, ctInt, local_count, 0, 2, "coll_append/data",
+                global_domain, global_domain, buffer);
+    }
+
+    // processes without data participate, too
+    pdc->append(10, ctInt, (myMpiRank == 0) ? 1 : 0, "coll_append/plain", buffer);
+
+    pdc->close();
+
+    // test data
+    fAttr.fileAccType = DataCollector::FAT_READ;
+    pdc->open(hdf5_file_coll_append, fAttr);
+
+    Dimensions size_read;
+    pdc->read(10, "coll_append/plain", size_read, NULL);
+    CPPUNIT_ASSERT(size_read == Dimensions(1, 1, 1));
+
+    DomainCollector::DomDataClass data_class = DomainCollector::UndefinedType;
+    DataContainer *container = pdc->readDomain(10, "coll_append/data",
+            global_domain, &data_class, false);
+
+    CPPUNIT_ASSERT(container);
+    CPPUNIT_ASSERT(data_class == DomainCollector::PolyType);
+    CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+    CPPUNIT_ASSERT(container->getNumElements() == 2 * total_count);
+
+    int *data = (int*)(container->getIndex(0)->getData());
+    size_t index = 0;
+    for (int m = 0; m < 2; ++m)
+        for (int r = 0; r < totalMpiSize; ++r)
+            for (int i = 0; i <= r; ++i)
+            {
+                CPPUNIT_ASSERT(data[index] == m * 1000 + r);
+                index++;
+            }
+
+    delete container;
+
+    pdc->close();
+
+    delete pdc;
+    pdc = NULL;
+
+    MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+}
+
+void Parallel_DomainsTest::testRedistributionRead()
+{
+    const Dimensions mpi_size(totalMpiSize, 1, 1);
+    const Dimensions grid_size(4, 3, 1);
+    const Dimensions global_grid_size(4 * totalMpiSize, 3, 1);
+    const Domain global_grid_domain(Dimensions(0, 0, 0), global_grid_size);
+    const Domain global_poly_domain(Dimensions(0, 0, 0), Dimensions(100, 1, 1));
+
+    ParallelDomainCollector *pdc =
+            new ParallelDomainCollector(MPI_COMM_WORLD, MPI_INFO_NULL, mpi_size, 1);
+    DomainCollector::FileCreationAttr fAttr;
+    fAttr.fileAccType = DataCollector::FAT_CREATE;
+
+    pdc->open(hdf5_file_redist, fAttr);
+
+    // every process writes a 4x3 block of the grid along x,
+    // elements are set to their global index
+    int grid_data[4 * 3];
+    for (size_t y = 0; y < grid_size[1]; ++y)
+        for (size_t x = 0; x < grid_size[0]; ++x)
+            grid_data[y * grid_size[0] + x] = y * global_grid_size[0] +
+                myMpiRank * grid_size[0] + x;
+
+    pdc->writeDomain(10, ctInt, 2, Selection(grid_size), "redist/grid",
+            Domain(Dimensions(myMpiRank * grid_size[0], 0, 0), grid_size),
+            global_grid_domain, IDomainCollector::GridType, grid_data);
+
+    int poly_data[totalMpiSize];
+    for (int i = 0; i <= myMpiRank; ++i)
+        poly_data[i] = myMpiRank * 100 + i;
+
+    pdc->appendDomain(10, ctInt, myMpiRank + 1, "redist/poly",
+            global_poly_domain, global_poly_domain, poly_data);
+
+    pdc->close();
+
+    // read with a decomposition which differs from the written one,
+    // rank 0 requests an empty grid domain
+    fAttr.fileAccType = DataCollector::FAT_READ;
+    pdc->open(hdf5_file_redist, fAttr);
+
+    const Dimensions request_size(4, 2, 1);
+    Domain grid_request(Dimensions(0, 0, 0), Dimensions(0, 0, 0));
+    if (myMpiRank > 0)
+        grid_request = Domain(Dimensions(myMpiRank - 1, 1, 0), request_size);
+
+    DomainCollector::DomDataClass data_class = DomainCollector::UndefinedType;
+    DataContainer *container = pdc->readDomainCollective(10, "redist/grid",
+            grid_request, &data_class);
+
+    CPPUNIT_ASSERT(container);
+    CPPUNIT_ASSERT(data_class == DomainCollector::GridType);
+
+    if (myMpiRank == 0)
+    {
+        CPPUNIT_ASSERT(container->getNumSubdomains() == 0);
+    } else
+    {
+        CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+        CPPUNIT_ASSERT(container->getNumElements() == request_size.getScalarSize());
+
+        int *data = (int*) (container->getIndex(0)->getData());
+        for (size_t y = 0; y < request_size[1]; ++y)
+            for (size_t x = 0; x < request_size[0]; ++x)
+            {
+                const int expected = (y + 1) * global_grid_size[0] +
+                        myMpiRank - 1 + x;
+                CPPUNIT_ASSERT(data[y * request_size[0] + x] == expected);
+            }
+    }
+
+    delete container;
+
+    // only every second process requests the Poly data
+    const Domain poly_request = (myMpiRank % 2 == 0) ? global_poly_domain :
+            Domain(Dimensions(0, 0, 0), Dimensions(0, 0, 0));
+
+    data_class = DomainCollector::UndefinedType;
+    container = pdc->readDomainCollective(10, "redist/poly",
+            poly_request, &data_class);
+
+    CPPUNIT_ASSERT(container);
+    CPPUNIT_ASSERT(data_class == DomainCollector::PolyType);
+
+    if (myMpiRank % 2 == 0)
+    {
+        CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+        CPPUNIT_ASSERT(container->getNumElements() ==
+                (size_t) (totalMpiSize * (totalMpiSize + 1)) / 2);
+
+        int *data = (int*) (container->getIndex(0)->getData());
+        size_t index = 0;
+        for (int r = 0; r < totalMpiSize; ++r)
+            for (int i = 0; i <= r; ++i)
+            {
+                CPPUNIT_ASSERT(data[index] == r * 100 + i);
+                index++;
+            }
+    } else
+        CPPUNIT_ASSERT(container->getNumSubdomains() == 0);
+
+    delete container;
+
+    pdc->close();
+
+    delete pdc;
+    pdc = NULL;
+
+    MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+}
+
+void Parallel_DomainsTest::testDomainTable()
+{
+    const Dimensions mpi_size(totalMpiSize, 1, 1);
+    const Dimensions grid_size(4, 3, 1);
+    const Domain global_domain(Dimensions(5, 0, 0),
+            Dimensions(4 * totalMpiSize, 3, 1));
+
+    ParallelDomainCollector *pdc =
+            new ParallelDomainCollector(MPI_COMM_WORLD, MPI_INFO_NULL, mpi_size, 1);
+    pdc->setDomainTableEnabled(true);
+
+    DomainCollector::FileCreationAttr fAttr;
+    fAttr.fileAccType = DataCollector::FAT_CREATE;
+    pdc->open(hdf5_file_table, fAttr);
+
+    int data[4 * 3];
+    for (size_t i = 0; i < grid_size.getScalarSize(); ++i)
+        data[i] = myMpiRank;
+
+    // the second write replaces the table of the first one
+    for (int i = 0; i < 2; ++i)
+        pdc->writeDomain(0, ctInt, 2, Selection(grid_size), "table/grid",
+                Domain(Dimensions(myMpiRank * grid_size[0], 0, 0), grid_size),
+                global_domain, IDomainCollector::GridType, data);
+
+    // two appends add two rows for every process
+    for (int i = 0; i < 2; ++i)
+        pdc->appendDomain(0, ctInt, myMpiRank + 1, "table/poly",
+                Domain(Dimensions(myMpiRank, 0, 0), Dimensions(1, 1, 1)),
+                global_domain, data);
+
+    pdc->close();
+
+    fAttr.fileAccType = DataCollector::FAT_READ;
+    pdc->open(hdf5_file_table, fAttr);
+
+    std::vector<DomainTableEntry> table;
+    CPPUNIT_ASSERT(pdc->readDomainTable(0, "table/grid", table));
+    CPPUNIT_ASSERT(table.size() == (size_t) totalMpiSize);
+
+    for (int r = 0; r < totalMpiSize; ++r)
+    {
+        CPPUNIT_ASSERT(table[r].mpiPosition == Dimensions(r, 0, 0));
+        CPPUNIT_ASSERT(table[r].domain.getOffset() ==
+                Dimensions(5 + r * grid_size[0], 0, 0));
+        CPPUNIT_ASSERT(table[r].domain.getSize() == grid_size);
+        CPPUNIT_ASSERT(table[r].dataOffset == Dimensions(r * grid_size[0], 0, 0));
+        CPPUNIT_ASSERT(table[r].elements == grid_size);
+        CPPUNIT_ASSERT(table[r].dataClass == IDomainCollector::GridType);
+    }
+
+    CPPUNIT_ASSERT(pdc->readDomainTable(0, "table/poly", table));
+    CPPUNIT_ASSERT(table.size() == (size_t) (2 * totalMpiSize));
+
+    // every row addresses the elements appended by its process
+    const size_t total_elements = totalMpiSize * (totalMpiSize + 1) / 2;
+    for (int i = 0; i < 2; ++i)
+        for (int r = 0; r < totalMpiSize; ++r)
+        {
+            const DomainTableEntry &entry = table[i * totalMpiSize + r];
+            CPPUNIT_ASSERT(entry.domain.getOffset() == Dimensions(5 + r, 0, 0));
+            CPPUNIT_ASSERT(entry.dataOffset ==
+                    Dimensions(i * total_elements + r * (r + 1) / 2, 0, 0));
+            CPPUNIT_ASSERT(entry.elements == Dimensions(r + 1, 1, 1));
+            CPPUNIT_ASSERT(entry.dataClass == IDomainCollector::PolyType);
+        }
+
+    CPPUNIT_ASSERT(!pdc->readDomainTable(0, "table/missing", table));
+
+    pdc->close();
+    delete pdc;
+}
+
+void Parallel_DomainsTest::testStridedRead()
+{
+    const Dimensions mpi_size(totalMpiSize, 1, 1);
+    const Dimensions grid_size(4, 3, 1);
+    const Dimensions global_grid_size(4 * totalMpiSize, 3, 1);
+    const Domain global_grid_domain(Dimensions(0, 0, 0), global_grid_size);
+    const Domain global_poly_domain(Dimensions(0, 0, 0), Dimensions(100, 1, 1));
+
+    ParallelDomainCollector *pdc =
+            new ParallelDomainCollector(MPI_COMM_WORLD, MPI_INFO_NULL, mpi_size, 1);
+    DomainCollector::FileCreationAttr fAttr;
+    fAttr.fileAccType = DataCollector::FAT_CREATE;
+
+    pdc->open(hdf5_file_strided, fAttr);
+
+    // grid elements are set to their global index
+    int grid_data[4 * 3];
+    for (size_t y = 0; y < grid_size[1]; ++y)
+        for (size_t x = 0; x < grid_size[0]; ++x)
+            grid_data[y * grid_size[0] + x] = y * global_grid_size[0] +
+                myMpiRank * grid_size[0] + x;
+
+    pdc->writeDomain(10, ctInt, 2, Selection(grid_size), "strided/grid",
+            Domain(Dimensions(myMpiRank * grid_size[0], 0, 0), grid_size),
+            global_grid_domain, IDomainCollector::GridType, grid_data);
+
+    int poly_data[totalMpiSize];
+    for (int i = 0; i <= myMpiRank; ++i)
+        poly_data[i] = myMpiRank * 100 + i;
+
+    pdc->appendDomain(10, ctInt, myMpiRank + 1, "strided/poly",
+            global_poly_domain, global_poly_domain, poly_data);
+
+    pdc->close();
+
+    fAttr.fileAccType = DataCollector::FAT_READ;
+    pdc->open(hdf5_file_strided, fAttr);
+
+    // every process requests a different part of the grid
+    const Dimensions offset(myMpiRank % global_grid_size[0], myMpiRank % 2, 0);
+    const Dimensions size(global_grid_size - offset);
+    const Dimensions stride(3, 2, 1);
+
+    DomainCollector::DomDataClass data_class = DomainCollector::UndefinedType;
+    DataContainer *container = pdc->readDomain(10, "strided/grid",
+            Domain(offset, size), stride, &data_class);
+
+    CPPUNIT_ASSERT(data_class == DomainCollector::GridType);
+    CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+
+    const Dimensions elements = container->getIndex(0)->getElements();
+    CPPUNIT_ASSERT(elements == Dimensions((size[0] + 2) / 3, (size[1] + 1) / 2, 1));
+
+    int *data = (int*) (container->getIndex(0)->getData());
+    for (size_t y = 0; y < elements[1]; ++y)
+        for (size_t x = 0; x < elements[0]; ++x)
+        {
+            const int expected = (offset[1] + y * stride[1]) * global_grid_size[0] +
+                    offset[0] + x * stride[0];
+            CPPUNIT_ASSERT(data[y * elements[0] + x] == expected);
+        }
+
+    delete container;
+
+    // every second particle
+    data_class = DomainCollector::UndefinedType;
+    container = pdc->readDomain(10, "strided/poly", global_poly_domain,
+            Dimensions(2, 1, 1), &data_class);
+
+    CPPUNIT_ASSERT(data_class == DomainCollector::PolyType);
+    CPPUNIT_ASSERT(container->getNumSubdomains() == 1);
+
+    const size_t num_particles = (totalMpiSize * (totalMpiSize + 1)) / 2;
+    CPPUNIT_ASSERT(container->getNumElements() == (num_particles + 1) / 2);
+
+    data = (int*) (container->getIndex(0)->getData());
+    size_t index = 0;
+    for (int r = 0; r < totalMpiSize; ++r)
+        for (int i = 0; i <= r; ++i)
+        {
+            if (index % 2 == 0)
+                CPPUNIT_ASSERT(data[index / 2] == r * 100 + i);
+            index++;
+        }
+
+    delete container;
+
+    pdc->close();
+
+    delete pdc;
+    pdc = NULL;
+
+    MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+}
@@ -27,6 +27,7 @@
 #include <iostream>
 #include <sstream>
 #include <stdlib.h>
+#include <stdio.h>
 #include <cppunit/TestAssert.h>
 #include <vector>
 
@@ -129,3 +130,68 @@ void Parallel_ListFilesTest::testListFiles()
     delete dataCollector;
     delete[] tmp_ids;
 }
+
+void Parallel_ListFilesTest::testIterationIndex()
+{
+    DataCollector::FileCreationAttr attr;
+    DataCollector::initFileCreationAttr(attr);
+
+    IParallelDataCollector *dataCollector = new ParallelDataCollector(
+            MPI_COMM_WORLD, MPI_INFO_NULL, Dimensions(MPI_SIZE_X, 1, 1), 1);
+
+    std::stringstream fileName;
+    fileName << TEST_FILE << "_index";
+    const std::string indexName = fileName.str() + "_iterations.idx";
+
+    /* start without a stale index from previous runs */
+    if (mpiRank == 0)
+        remove(indexName.c_str());
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    /* creating iterations maintains the index */
+    dataCollector->open(fileName.str().c_str(), attr);
+    for (int32_t id = 0; id < 30; id += 10)
+        dataCollector->write(id, ctInt, 1, Dimensions(1, 1, 1), "data", &id);
+    dataCollector->close();
+
+    FILE *indexFile = fopen(indexName.c_str(), "rb");
+    CPPUNIT_ASSERT(indexFile != NULL);
+    fclose(indexFile);
+
+    /* removing an iteration keeps its file, and so does the index */
+    attr.fileAccType = DataCollector::FAT_WRITE;
+    dataCollector->open(fileName.str().c_str(), attr);
+    CPPUNIT_ASSERT(dataCollector->getMaxID() == 20);
+    dataCollector->remove(20);
+    CPPUNIT_ASSERT(dataCollector->getMaxID() == 20);
+    dataCollector->close();
+
+    attr.fileAccType = DataCollector::FAT_READ;
+    dataCollector->open(fileName.str().c_str(), attr);
+    size_t num_ids = 0;
+    int32_t index_ids[3];
+    dataCollector->getEntryIDs(NULL, &num_ids);
+    CPPUNIT_ASSERT(num_ids == 3);
+    dataCollector->getEntryIDs(index_ids, NULL);
+    CPPUNIT_ASSERT(dataCollector->getMaxID() == 20);
+    dataCollector->close();
+
+    /* without an index, the directory scan finds the same iterations */
+    MPI_Barrier(MPI_COMM_WORLD);
+    if (mpiRank == 0)
+        remove(indexName.c_str());
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    dataCollector->open(fileName.str().c_str(), attr);
+    int32_t scanned_ids[3];
+    dataCollector->getEntryIDs(NULL, &num_ids);
+    CPPUNIT_ASSERT(num_ids == 3);
+    dataCollector->getEntryIDs(scanned_ids, NULL);
+    for (size_t i = 0; i < num_ids; ++i)
+        CPPUNIT_ASSERT(scanned_ids[i] == index_ids[i]);
+    CPPUNIT_ASSERT(dataCollector->getMaxID() == 20);
+    dataCollector->close();
+
+    dataCollector->finalize();
+    delete dataCollector;
+}
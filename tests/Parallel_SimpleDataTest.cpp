@@ -569,3 +569,140 @@ void Parallel_SimpleDataTest::testFill()
 
     MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
 }
+
+void Parallel_SimpleDataTest::testTransferPolicy()
+{
+    const Dimensions mpi_size(totalMpiSize, 1, 1);
+    const Dimensions local_size(16, 1, 1);
+    int32_t data[16];
+    for (size_t i = 0; i < local_size.getScalarSize(); ++i)
+        data[i] = myMpiRank;
+
+    ParallelDataCollector *pdc = new ParallelDataCollector(MPI_COMM_WORLD,
+            MPI_INFO_NULL, mpi_size, 1);
+
+    DataCollector::FileCreationAttr fileCAttr;
+    DataCollector::initFileCreationAttr(fileCAttr);
+    fileCAttr.fileAccType = DataCollector::FAT_CREATE;
+    pdc->open(HDF5_FILE "_transfer", fileCAttr);
+
+    TransferPolicy policy;
+    TransferReport report;
+    CPPUNIT_ASSERT(!pdc->getTransferReport(0, "forced_collective", report));
+
+    policy.mode = TransferPolicy::TRANSFER_COLLECTIVE;
+    pdc->setTransferPolicy(policy);
+    pdc->write(0, ctInt32, 1, Selection(local_size), "forced_collective", data);
+    CPPUNIT_ASSERT(pdc->getTransferReport(0, "forced_collective", report));
+    CPPUNIT_ASSERT(report.collectiveRequested);
+
+    policy.mode = TransferPolicy::TRANSFER_INDEPENDENT;
+    pdc->setTransferPolicy(policy);
+    pdc->write(0, ctInt32, 1, Selection(local_size), "forced_independent", data);
+    CPPUNIT_ASSERT(pdc->getTransferReport(0, "forced_independent", report));
+    CPPUNIT_ASSERT(!report.collectiveRequested);
+    CPPUNIT_ASSERT(!report.isCollectiveBroken());
+
+    // a few bytes in total are written independently
+    policy.mode = TransferPolicy::TRANSFER_AUTO;
+    pdc->setTransferPolicy(policy);
+    pdc->write(0, ctInt32, 1, Selection(local_size), "auto_small", data);
+    CPPUNIT_ASSERT(pdc->getTransferReport(0, "auto_small", report));
+    CPPUNIT_ASSERT(!report.collectiveRequested);
+
+    // imbalance decides
+    CPPUNIT_ASSERT(policy.useCollective(1024 * 1024, 1024, 1024, false));
+    CPPUNIT_ASSERT(!policy.useCollective(1024 * 1024, 512 * 1024, 1024, false));
+    CPPUNIT_ASSERT(policy.useCollective(1024, 1024, 1, true));
+
+    pdc->close();
+
+    // data is independent of the transfer mode
+    fileCAttr.fileAccType = DataCollector::FAT_READ;
+    pdc->open(HDF5_FILE "_transfer", fileCAttr);
+
+    const char *names[] = {"forced_collective", "forced_independent", "auto_small"};
+    for (size_t n = 0; n < 3; ++n)
+    {
+        int32_t data_read[16];
+        Dimensions size_read;
+        pdc->read(0, local_size, local_size * Dimensions(myMpiRank, 0, 0),
+                names[n], local_size, Dimensions(0, 0, 0), size_read, data_read);
+        CPPUNIT_ASSERT(size_read == local_size);
+
+        for (size_t i = 0; i < local_size.getScalarSize(); ++i)
+            CPPUNIT_ASSERT(data_read[i] == myMpiRank);
+
+        CPPUNIT_ASSERT(pdc->getTransferReport(0, names[n], report));
+        CPPUNIT_ASSERT(report.collectiveRequested);
+    }
+
+    pdc->close();
+    pdc->finalize();
+    delete pdc;
+
+    MPI_CHECK(MPI_Barrier(MPI_COMM_WORLD));
+}
+
+void Parallel_SimpleDataTest::testMultiSelection()
+{
+    const Dimensions mpi_size(totalMpiSize, 1, 1);
+    const Dimensions global_size(2 * totalMpiSize, 4, 1);
+
+    ParallelDataCollector *pdc = new ParallelDataCollector(MPI_COMM_WORLD,
+            MPI_INFO_NULL, mpi_size, 1);
+
+    DataCollector::FileCreationAttr fileCAttr;
+    DataCollector::initFileCreationAttr(fileCAttr);
+    fileCAttr.fileAccType = DataCollector::FAT_CREATE;
+    pdc->open(HDF5_FILE "_multi", fileCAttr);
+
+    // every process owns two columns at both ends of the dataset,
+    // which are stored one after the other in its buffer
+    const size_t columns[2] = {(size_t) myMpiRank, global_size[0] - 1 - myMpiRank};
+    int32_t data[8];
+    MultiSelection select(Dimensions(1, 8, 1));
+    for (size_t b = 0; b < 2; ++b)
+    {
+        for (size_t y = 0; y < 4; ++y)
+            data[b * 4 + y] = columns[b] * 10 + y;
+
+        select.add(Dimensions(1, 4, 1), Dimensions(0, b * 4, 0),
+                Dimensions(columns[b], 0, 0));
+    }
+
+    pdc->write(0, global_size, ctInt32, 2, select, "multi", data);
+    pdc->close();
+
+    // read the columns of the next process, rank 0 reads nothing
+    fileCAttr.fileAccType = DataCollector::FAT_READ;
+    pdc->open(HDF5_FILE "_multi", fileCAttr);
+
+    const int other = (myMpiRank + 1) % totalMpiSize;
+    const size_t other_columns[2] = {(size_t) other, global_size[0] - 1 - other};
+    MultiSelection read_select(Dimensions(1, 8, 1));
+    if (myMpiRank > 0 || totalMpiSize == 1)
+    {
+        for (size_t b = 0; b < 2; ++b)
+            read_select.add(Dimensions(1, 4, 1), Dimensions(0, b * 4, 0),
+                Dimensions(other_columns[b], 0, 0));
+    }
+
+    int32_t data_read[8];
+    for (size_t i = 0; i < 8; ++i)
+        data_read[i] = -1;
+
+    pdc->read(0, "multi", read_select, data_read);
+
+    for (size_t b = 0; b < 2; ++b)
+        for (size_t y = 0; y < 4; ++y)
+        {
+            if (read_select.blocks.empty())
+                CPPUNIT_ASSERT(data_read[b * 4 + y] == -1);
+            else
+                CPPUNIT_ASSERT(data_read[b * 4 + y] == (int32_t) (other_columns[b] * 10 + y));
+        }
+
+    pdc->close();
+    delete pdc;
+}
@@ -24,18 +24,34 @@
 
 #include <time.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <stdint.h>
 #include <limits.h>
 #include <set>
 #include <string>
 #include <cstring>
 #include <typeinfo>
+#include <vector>
 
 #include "SimpleDataTest.h"
 
+typedef struct
+{
+    float x, y, z;
+} float3;
+
+SPLASH_COLTYPE_TRAITS(float3, splash::ColTypeFloat3)
+
 CPPUNIT_TEST_SUITE_REGISTRATION(SimpleDataTest);
 
 #define HDF5_FILE "h5/testWriteRead"
+#define HDF5_FILE_SLICES "h5/testSlices"
+#define HDF5_FILE_ITERATIONS "h5/testIterationReader"
+#define HDF5_FILE_ITERATIONS_COMPRESSED "h5/testIterationReaderCompressed"
+#define HDF5_FILE_TYPED "h5/testTypedAccess"
+#define HDF5_FILE_TYPES "h5/testCollectionTypes"
+#define HDF5_FILE_RECORDS "h5/testRecords"
+#define HDF5_FILE_MEMBERS "h5/testMemberView"
 
 //#define TESTS_DEBUG
 
@@ -338,6 +354,741 @@ void SimpleDataTest::testWriteRead()
 
 }
 
+/**
+ * Tests a slice of data (x varying fastest) with value (z * ny + y) * nx + x.
+ */
+static bool checkSlice(const Dimensions &gridSize, uint32_t axis,
+        size_t position, const float *data)
+{
+    Dimensions slice_size(gridSize);
+    slice_size[axis] = 1;
+
+    for (size_t z = 0; z < slice_size[2]; ++z)
+        for (size_t y = 0; y < slice_size[1]; ++y)
+            for (size_t x = 0; x < slice_size[0]; ++x)
+            {
+                Dimensions pos(x, y, z);
+                pos[axis] = position;
+
+                const size_t index = (z * slice_size[1] + y) * slice_size[0] + x;
+                if (data[index] != (float) ((pos[2] * gridSize[1] + pos[1]) *
+                        gridSize[0] + pos[0]))
+                    return false;
+            }
+
+    return true;
+}
+
+void SimpleDataTest::testSlices()
+{
+    const Dimensions grid_size(128, 64, 32);
+    ColTypeFloat ctFloat;
+    SerialDataCollector dc(1);
+
+    DataCollector::FileCreationAttr fileCAttr;
+    DataCollector::initFileCreationAttr(fileCAttr);
+    fileCAttr.enableCompression = true;
+    dc.open(HDF5_FILE_SLICES, fileCAttr);
+
+    float *data = new float[grid_size.getScalarSize()];
+    for (size_t i = 0; i < grid_size.getScalarSize(); ++i)
+        data[i] = (float) i;
+
+    dc.write(0, ctFloat, 3, Selection(grid_size), "grid", data);
+    dc.close();
+
+    fileCAttr.fileAccType = DataCollector::FAT_READ;
+    dc.open(HDF5_FILE_SLICES, fileCAttr);
+
+    Dimensions size_read;
+    for (uint32_t axis = 0; axis < 3; ++axis)
+    {
+        Dimensions expected_size(grid_size);
+        expected_size[axis] = 1;
+
+        dc.readSlice(0, "grid", axis, 0, size_read, NULL);
+        CPPUNIT_ASSERT(size_read == expected_size);
+
+        // neighbouring and repeated slices are (partially) cached
+        const size_t positions[] = {0, 1, grid_size[axis] / 2 + 3, 1,
+            grid_size[axis] - 1};
+        for (size_t p = 0; p < sizeof (positions) / sizeof (positions[0]); ++p)
+        {
+            memset(data, 0, sizeof (float) * expected_size.getScalarSize());
+            dc.readSlice(0, "grid", axis, positions[p], size_read, data);
+
+            CPPUNIT_ASSERT(size_read == expected_size);
+            CPPUNIT_ASSERT(checkSlice(grid_size, axis, positions[p], data));
+        }
+
+        // chunks which do not fit into the cache are not cached
+        dc.setSliceCacheSize(1024);
+        memset(data, 0, sizeof (float) * expected_size.getScalarSize());
+        dc.readSlice(0, "grid", axis, 2, size_read, data);
+        CPPUNIT_ASSERT(checkSlice(grid_size, axis, 2, data));
+
+        // disabled cache
+        dc.setSliceCacheSize(0);
+        memset(data, 0, sizeof (float) * expected_size.getScalarSize());
+        dc.readSlice(0, "grid", axis, 3, size_read, data);
+        CPPUNIT_ASSERT(checkSlice(grid_size, axis, 3, data));
+
+        dc.setSliceCacheSize(64 * 1024 * 1024);
+    }
+
+    CPPUNIT_ASSERT_THROW(dc.readSlice(0, "grid", 3, 0, size_read, data),
+            DCException);
+    CPPUNIT_ASSERT_THROW(dc.readSlice(0, "grid", 2, grid_size[2], size_read, data),
+            DCException);
+
+    dc.close();
+    delete[] data;
+}
+
+/**
+ * Writes iterations (in non-ascending order) of a particle
+ * and a grid dataset for testIterationReader.
+ */
+static void writeIterations(const char *filename, uint32_t numIterations,
+        size_t elements, const Dimensions &gridSize, bool compression)
+{
+    ColTypeInt ctInt;
+    ColTypeDouble ctDouble;
+    SerialDataCollector dc(1);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.enableCompression = compression;
+    dc.open(filename, fattr);
+
+    double *data = new double[elements];
+    int *grid = new int[gridSize.getScalarSize()];
+
+    for (uint32_t n = 0; n < numIterations; ++n)
+    {
+        const int32_t id = (int32_t) (((n * 7) % numIterations) * 10);
+
+        for (size_t i = 0; i < elements; ++i)
+            data[i] = (double) id + (double) i * 0.5;
+
+        for (size_t i = 0; i < gridSize.getScalarSize(); ++i)
+            grid[i] = id * 1000 + (int) i;
+
+        dc.write(id, ctDouble, 1, Selection(Dimensions(elements, 1, 1)),
+                "particles/x", data);
+        dc.write(id, ctInt, 3, Selection(gridSize), "fields/grid", grid);
+    }
+
+    delete[] grid;
+    delete[] data;
+
+    dc.close();
+}
+
+/**
+ * Reads all iterations written by writeIterations with an IterationReader.
+ */
+static void checkIterations(const char *filename, uint32_t numIterations,
+        size_t elements, const Dimensions &gridSize, size_t maxPrefetchBytes,
+        bool prefetched)
+{
+    SerialDataCollector dc(1);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dc.open(filename, fattr);
+
+    std::vector<std::string> names;
+    names.push_back("particles/x");
+    names.push_back("fields/grid");
+
+    IterationReader reader(dc, names, maxPrefetchBytes);
+    CPPUNIT_ASSERT(reader.getNumIterations() == numIterations);
+    CPPUNIT_ASSERT_THROW(reader.getID(), DCException);
+
+    uint32_t n = 0;
+    while (reader.next())
+    {
+        const int32_t id = reader.getID();
+        CPPUNIT_ASSERT(id == (int32_t) (n * 10));
+
+        CPPUNIT_ASSERT(reader.getSize("particles/x") == Dimensions(elements, 1, 1));
+        const double *data = (const double*) reader.getData("particles/x");
+        for (size_t i = 0; i < elements; ++i)
+            CPPUNIT_ASSERT(data[i] == (double) id + (double) i * 0.5);
+
+        CPPUNIT_ASSERT(reader.getSize("fields/grid") == gridSize);
+        const int *grid = (const int*) reader.getData("fields/grid");
+        for (size_t i = 0; i < gridSize.getScalarSize(); ++i)
+            CPPUNIT_ASSERT(grid[i] == id * 1000 + (int) i);
+
+        CPPUNIT_ASSERT_THROW(reader.getData("unknown"), DCException);
+        n++;
+    }
+
+    CPPUNIT_ASSERT(n == numIterations);
+    CPPUNIT_ASSERT(!reader.next());
+
+#if defined(SPLASH_HAVE_THREADS)
+    if (prefetched)
+        CPPUNIT_ASSERT(reader.getNumPrefetched() == 2 * numIterations);
+    else
+        CPPUNIT_ASSERT(reader.getNumPrefetched() == 0);
+#else
+    // without threads support, nothing is read in the background
+    (void) prefetched;
+    CPPUNIT_ASSERT(reader.getNumPrefetched() == 0);
+#endif
+
+    dc.close();
+}
+
+void SimpleDataTest::testIterationReader()
+{
+    const uint32_t num_iterations = 13;
+    const size_t elements = 1000;
+    const Dimensions grid_size(8, 4, 2);
+
+    writeIterations(HDF5_FILE_ITERATIONS, num_iterations, elements,
+            grid_size, false);
+    checkIterations(HDF5_FILE_ITERATIONS, num_iterations, elements,
+            grid_size, 1024 * 1024, true);
+
+    // iterations larger than the prefetch limit are read synchronously
+    checkIterations(HDF5_FILE_ITERATIONS, num_iterations, elements,
+            grid_size, 1024, false);
+
+    // compressed datasets can only be read with HDF5
+    writeIterations(HDF5_FILE_ITERATIONS_COMPRESSED, num_iterations, elements,
+            grid_size, true);
+    checkIterations(HDF5_FILE_ITERATIONS_COMPRESSED, num_iterations, elements,
+            grid_size, 1024 * 1024, false);
+}
+
+template<typename T>
+static void checkType(DataCollector *dc, const char *name,
+        const std::string typeName)
+{
+    Dimensions size_read;
+    CollectionType *type = dc->readMeta(0, name, Dimensions(0, 0, 0),
+            Dimensions(0, 0, 0), size_read);
+    CPPUNIT_ASSERT(type != NULL);
+    CPPUNIT_ASSERT(type->toString() == typeName);
+    CPPUNIT_ASSERT(type->getSize() == sizeof (T));
+    delete type;
+
+    // one object per type
+    CPPUNIT_ASSERT(&getColType<T>() == &getColType<T>());
+    CPPUNIT_ASSERT(getColType<T>().getSize() == sizeof (T));
+}
+
+void SimpleDataTest::testTypedAccess()
+{
+    const Dimensions size(5, 4, 3);
+    const size_t elements = size.getScalarSize();
+
+    std::vector<float3> vectors(elements);
+    std::vector<int64_t> ints(elements);
+    std::vector<uint8_t> bytes(elements);
+    std::vector<double> doubles(elements);
+    for (size_t i = 0; i < elements; ++i)
+    {
+        vectors[i].x = (float) i;
+        vectors[i].y = (float) i + 0.25f;
+        vectors[i].z = (float) i + 0.5f;
+        ints[i] = -((int64_t) i << 40);
+        bytes[i] = (uint8_t) (i * 3);
+        doubles[i] = (double) i / 3.0;
+    }
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_CREATE;
+    dataCollector->open(HDF5_FILE_TYPED, fattr);
+
+    dataCollector->write(0, Selection(size), "vectors", &(vectors[0]));
+    dataCollector->write(0, Selection(Dimensions(elements, 1, 1)), "ints", &(ints[0]));
+    dataCollector->write<uint8_t>(0, Selection(Dimensions(5, 12, 1)), "bytes", &(bytes[0]));
+    dataCollector->write(0, Selection(size, Dimensions(3, 2, 1), Dimensions(1, 1, 1)),
+            "doubles", &(doubles[0]));
+
+    dataCollector->close();
+
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dataCollector->open(HDF5_FILE_TYPED, fattr);
+
+    checkType<float3>(dataCollector, "vectors", "Float3");
+    checkType<int64_t>(dataCollector, "ints", "Int64");
+    checkType<uint8_t>(dataCollector, "bytes", "UInt8");
+    checkType<double>(dataCollector, "doubles", "Double");
+
+    Dimensions size_read;
+    std::vector<float3> vectors_read(elements);
+    dataCollector->read(0, "vectors", size_read, &(vectors_read[0]));
+    CPPUNIT_ASSERT(size_read == size);
+    for (size_t i = 0; i < elements; ++i)
+    {
+        CPPUNIT_ASSERT(vectors_read[i].x == vectors[i].x);
+        CPPUNIT_ASSERT(vectors_read[i].y == vectors[i].y);
+        CPPUNIT_ASSERT(vectors_read[i].z == vectors[i].z);
+    }
+
+    std::vector<int64_t> ints_read(elements);
+    dataCollector->read(0, "ints", size_read, &(ints_read[0]));
+    CPPUNIT_ASSERT(size_read == Dimensions(elements, 1, 1));
+    CPPUNIT_ASSERT(ints_read == ints);
+
+    std::vector<uint8_t> bytes_read(elements);
+    dataCollector->read<uint8_t>(0, "bytes", size_read, &(bytes_read[0]));
+    CPPUNIT_ASSERT(size_read == Dimensions(5, 12, 1));
+    CPPUNIT_ASSERT(bytes_read == bytes);
+
+    std::vector<double> doubles_read(6);
+    dataCollector->read(0, "doubles", size_read, &(doubles_read[0]));
+    CPPUNIT_ASSERT(size_read == Dimensions(3, 2, 1));
+    for (size_t y = 0; y < 2; ++y)
+        for (size_t x = 0; x < 3; ++x)
+            CPPUNIT_ASSERT(doubles_read[y * 3 + x] ==
+                doubles[(1 * size[1] + 1 + y) * size[0] + 1 + x]);
+
+    dataCollector->close();
+}
+
+/**
+ * User-defined particle record.
+ */
+class ColTypeParticle : public CollectionType
+{
+public:
+
+    ColTypeParticle()
+    {
+        type = H5Tcreate(H5T_COMPOUND, getSize());
+        H5Tinsert(type, "position", 0, ColTypeFloat3().getDataType());
+        H5Tinsert(type, "weight", 3 * sizeof (float), H5T_NATIVE_FLOAT);
+    }
+
+    ~ColTypeParticle()
+    {
+        H5Tclose(type);
+    }
+
+    size_t getSize() const
+    {
+        return 4 * sizeof (float);
+    }
+
+    static CollectionType* genType(hid_t datatype_id)
+    {
+        bool found = false;
+        if (H5Tget_class(datatype_id) == H5T_COMPOUND &&
+                H5Tget_nmembers(datatype_id) == 2)
+        {
+            char *m0 = H5Tget_member_name(datatype_id, 0);
+            char *m1 = H5Tget_member_name(datatype_id, 1);
+            found = (strcmp(m0, "position") == 0 && strcmp(m1, "weight") == 0);
+            free(m1);
+            free(m0);
+        }
+
+        if (found)
+            return new ColTypeParticle;
+        else
+            return NULL;
+    }
+
+    std::string toString() const
+    {
+        return "Particle";
+    }
+};
+
+/**
+ * Lists "name:type" of all datasets of iteration 0.
+ */
+static void listEntries(DataCollector *dataCollector,
+        std::vector<std::string> &types)
+{
+    size_t num_entries = 0;
+    dataCollector->getEntriesForID(0, NULL, &num_entries);
+
+    std::vector<DataCollector::DCEntry> entries(num_entries);
+    dataCollector->getEntriesForID(0, &(entries[0]), NULL);
+
+    types.clear();
+    for (size_t i = 0; i < num_entries; ++i)
+    {
+        types.push_back(entries[i].name + std::string(":") +
+                entries[i].colType->toString());
+        delete entries[i].colType;
+    }
+}
+
+void SimpleDataTest::testTypeRecognition()
+{
+    const CollectionType* types[] = {new ColTypeInt8(), new ColTypeUInt16(),
+        new ColTypeInt32(), new ColTypeUInt64(), new ColTypeFloat(),
+        new ColTypeDouble(), new ColTypeChar(), new ColTypeBool(),
+        new ColTypeString(7), new ColTypeFloat3Array(), new ColTypeInt2Array(),
+        new ColTypeDimArray(), new ColTypeDim(), new ColTypeFloat2(),
+        new ColTypeDouble4(), new ColTypeInt3(), new ColTypeParticle()};
+    const size_t num_types = sizeof (types) / sizeof (types[0]);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_CREATE;
+    dataCollector->open(HDF5_FILE_TYPES, fattr);
+
+    // every type is written twice for cache hits
+    std::vector<uint8_t> buffer(1024, 0);
+    for (size_t r = 0; r < 2; ++r)
+        for (size_t i = 0; i < num_types; ++i)
+        {
+            char name[32];
+            snprintf(name, sizeof (name), "data%u_%u", (unsigned) r, (unsigned) i);
+            dataCollector->write(0, *(types[i]), 1, Selection(Dimensions(2, 1, 1)),
+                    name, &(buffer[0]));
+        }
+
+    dataCollector->close();
+
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dataCollector->open(HDF5_FILE_TYPES, fattr);
+
+    std::vector<std::string> uncached, cached, cached_again, registered;
+
+    setCollectionTypeCacheSize(0);
+    listEntries(dataCollector, uncached);
+
+    setCollectionTypeCacheSize(4096);
+    listEntries(dataCollector, cached);
+    listEntries(dataCollector, cached_again);
+
+    CPPUNIT_ASSERT(uncached.size() == 2 * num_types);
+    CPPUNIT_ASSERT(cached == uncached);
+    CPPUNIT_ASSERT(cached_again == uncached);
+
+    // user types are recognized after registration only
+    size_t unknown = 0;
+    for (size_t i = 0; i < uncached.size(); ++i)
+    {
+        if (uncached[i].find(":Unknown") != std::string::npos)
+            unknown++;
+    }
+    CPPUNIT_ASSERT(unknown == 2);
+
+    registerCollectionType(&ColTypeParticle::genType);
+    listEntries(dataCollector, registered);
+    CPPUNIT_ASSERT(registered.size() == uncached.size());
+
+    size_t particles = 0;
+    for (size_t i = 0; i < registered.size(); ++i)
+    {
+        if (registered[i].find(":Particle") != std::string::npos)
+            particles++;
+        else
+            CPPUNIT_ASSERT(registered[i] == uncached[i]);
+    }
+    CPPUNIT_ASSERT(particles == 2);
+
+    dataCollector->close();
+
+    for (size_t i = 0; i < num_types; ++i)
+        delete types[i];
+}
+
+typedef struct
+{
+    float pos[3];
+    float mom[3];
+    float weight;
+    // padding before id
+    int64_t id;
+} RecordParticle;
+
+static void initRecord(ColTypeRecord &record)
+{
+    SPLASH_RECORD_MEMBER(record, RecordParticle, pos, ColTypeFloat3Array());
+    SPLASH_RECORD_MEMBER(record, RecordParticle, mom, ColTypeFloat3Array());
+    SPLASH_RECORD_MEMBER(record, RecordParticle, weight, ColTypeFloat());
+    SPLASH_RECORD_MEMBER(record, RecordParticle, id, ColTypeInt64());
+}
+
+static void initParticles(std::vector<RecordParticle> &particles)
+{
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+        {
+            particles[i].pos[j] = (float) (i * 3 + j);
+            particles[i].mom[j] = -(float) (i * 3 + j);
+        }
+        particles[i].weight = (float) i * 0.5f;
+        particles[i].id = ((int64_t) i << 33) + 7;
+    }
+}
+
+static bool equalParticles(const RecordParticle &p1, const RecordParticle &p2)
+{
+    for (size_t j = 0; j < 3; ++j)
+    {
+        if (p1.pos[j] != p2.pos[j] || p1.mom[j] != p2.mom[j])
+            return false;
+    }
+
+    return (p1.weight == p2.weight) && (p1.id == p2.id);
+}
+
+void SimpleDataTest::testRecords()
+{
+    const size_t num_particles = 1000;
+
+    ColTypeRecord record("Particle", sizeof (RecordParticle));
+    initRecord(record);
+    CPPUNIT_ASSERT(record.getNumMembers() == 4);
+    CPPUNIT_ASSERT(record.getSize() == sizeof (RecordParticle));
+    CPPUNIT_ASSERT(record.getMember(3).name == "id");
+    CPPUNIT_ASSERT(record.getMember(3).offset == offsetof(RecordParticle, id));
+    CPPUNIT_ASSERT(record.getMember(3).size == sizeof (int64_t));
+
+    // members must fit into the record
+    ColTypeRecord small("Small", sizeof (float));
+    CPPUNIT_ASSERT_THROW(small.addMember("d", 0, ColTypeDouble()), DCException);
+
+    std::vector<RecordParticle> particles(num_particles);
+    initParticles(particles);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_CREATE;
+    dataCollector->open(HDF5_FILE_RECORDS, fattr);
+
+    dataCollector->write(0, record, 1, Selection(Dimensions(num_particles, 1, 1)),
+            "particles", &(particles[0]));
+
+    dataCollector->close();
+
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dataCollector->open(HDF5_FILE_RECORDS, fattr);
+
+    Dimensions size_read;
+    std::vector<RecordParticle> particles_read(num_particles);
+    dataCollector->read(0, "particles", size_read, &(particles_read[0]));
+    CPPUNIT_ASSERT(size_read == Dimensions(num_particles, 1, 1));
+
+    for (size_t i = 0; i < num_particles; ++i)
+        CPPUNIT_ASSERT(equalParticles(particles_read[i], particles[i]));
+
+    dataCollector->close();
+}
+
+void SimpleDataTest::testRecordsSoA()
+{
+    ColTypeRecord record("Particle", sizeof (RecordParticle));
+    SerialDataCollector dc(10);
+    initRecord(record);
+
+    // selection with offset and stride from a 2D buffer
+    const Dimensions size(8, 6, 1);
+    const Selection select(size, Dimensions(3, 4, 1), Dimensions(1, 1, 0),
+            Dimensions(2, 1, 1));
+
+    std::vector<RecordParticle> particles(size.getScalarSize());
+    initParticles(particles);
+
+    // 1D records exceeding the staging buffer
+    std::vector<RecordParticle> particles_1d(300000);
+    initParticles(particles_1d);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_CREATE;
+    dc.open(HDF5_FILE_RECORDS, fattr);
+
+    dc.writeRecordsSoA(0, record, 2, select, "frame", &(particles[0]));
+    dc.writeRecordsSoA(0, record, 1,
+            Selection(Dimensions(particles_1d.size(), 1, 1)), "frame1d",
+            &(particles_1d[0]));
+
+    dc.close();
+
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dc.open(HDF5_FILE_RECORDS, fattr);
+
+    // every member is a dataset
+    Dimensions size_read;
+    std::vector<float> weights(select.count.getScalarSize());
+    dc.read(0, "frame/weight", size_read, &(weights[0]));
+    CPPUNIT_ASSERT(size_read == select.count);
+
+    std::vector<RecordParticle> particles_read(select.count.getScalarSize());
+    dc.readRecordsSoA(0, record, "frame", size_read, NULL);
+    CPPUNIT_ASSERT(size_read == select.count);
+    dc.readRecordsSoA(0, record, "frame", size_read, &(particles_read[0]));
+    CPPUNIT_ASSERT(size_read == select.count);
+
+    for (size_t y = 0; y < select.count[1]; ++y)
+        for (size_t x = 0; x < select.count[0]; ++x)
+        {
+            size_t index = y * select.count[0] + x;
+            size_t src_index = (select.offset[1] + y * select.stride[1]) * size[0] +
+                    select.offset[0] + x * select.stride[0];
+
+            CPPUNIT_ASSERT(equalParticles(particles_read[index], particles[src_index]));
+            CPPUNIT_ASSERT(weights[index] == particles[src_index].weight);
+        }
+
+    std::vector<RecordParticle> particles_1d_read(particles_1d.size());
+    dc.readRecordsSoA(0, record, "frame1d", size_read, &(particles_1d_read[0]));
+    CPPUNIT_ASSERT(size_read == Dimensions(particles_1d.size(), 1, 1));
+
+    for (size_t i = 0; i < particles_1d.size(); ++i)
+        CPPUNIT_ASSERT(equalParticles(particles_1d_read[i], particles_1d[i]));
+
+    // member datatypes must match
+    ColTypeRecord other("Other", sizeof (RecordParticle));
+    other.addMember("weight", 0, ColTypeDouble());
+    CPPUNIT_ASSERT_THROW(dc.readRecordsSoA(0, other, "frame", size_read,
+            &(particles_read[0])), DCException);
+
+    dc.close();
+}
+
+typedef struct
+{
+    double pos[3];
+    float weight;
+    int32_t id;
+} ViewParticle;
+
+static const char* COMPONENTS[] = {"x", "y", "z"};
+
+static void initField(std::vector<float3> &field)
+{
+    for (size_t i = 0; i < field.size(); ++i)
+    {
+        field[i].x = (float) i;
+        field[i].y = (float) i + 0.25f;
+        field[i].z = -(float) i;
+    }
+}
+
+static float getComponent(const float3 &value, size_t component)
+{
+    const float *components = &(value.x);
+    return components[component];
+}
+
+void SimpleDataTest::testMemberView()
+{
+    const Dimensions size(7, 5, 4);
+    const Selection select(size, Dimensions(3, 4, 2), Dimensions(1, 0, 1),
+            Dimensions(2, 1, 2));
+
+    std::vector<float3> field(size.getScalarSize());
+    initField(field);
+
+    std::vector<ViewParticle> particles(100);
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        for (size_t j = 0; j < 3; ++j)
+            particles[i].pos[j] = (double) (i * 3 + j);
+        particles[i].weight = (float) i * 0.5f;
+        particles[i].id = (int32_t) i - 50;
+    }
+
+    ColTypeRecord record("Particle", sizeof (ViewParticle));
+    SPLASH_RECORD_MEMBER(record, ViewParticle, pos, ColTypeDouble3Array());
+    SPLASH_RECORD_MEMBER(record, ViewParticle, weight, ColTypeFloat());
+    SPLASH_RECORD_MEMBER(record, ViewParticle, id, ColTypeInt32());
+
+    // members must be aligned to their size
+    CPPUNIT_ASSERT_THROW(MemberView(ColTypeFloat(), 10, 0), DCException);
+    CPPUNIT_ASSERT_THROW(MemberView(ColTypeFloat(), sizeof (float3), 2), DCException);
+    CPPUNIT_ASSERT_THROW(MemberView(record, "pos"), DCException);
+    CPPUNIT_ASSERT_THROW(MemberView(record, "mom"), DCException);
+
+    DataCollector::FileCreationAttr fattr;
+    DataCollector::initFileCreationAttr(fattr);
+    fattr.fileAccType = DataCollector::FAT_CREATE;
+    dataCollector->open(HDF5_FILE_MEMBERS, fattr);
+
+    for (size_t c = 0; c < 3; ++c)
+    {
+        MemberView component(ColTypeFloat(), sizeof (float3), c * sizeof (float));
+        CPPUNIT_ASSERT(component.getSize() == sizeof (float));
+
+        dataCollector->write(0, component, 3, Selection(size),
+                (std::string("field/") + COMPONENTS[c]).c_str(), &(field[0]));
+        dataCollector->write(0, component, 3, select,
+                (std::string("selected/") + COMPONENTS[c]).c_str(), &(field[0]));
+
+        // strided member selection of other collectors
+        dataCollector->DataCollector::write(0, component, 3, select,
+                (std::string("strided/") + COMPONENTS[c]).c_str(), &(field[0]));
+    }
+
+    const Selection all_particles(Dimensions(particles.size(), 1, 1));
+    dataCollector->write(0, MemberView(record, "weight"), 1, all_particles,
+            "weight", &(particles[0]));
+    dataCollector->write(0, MemberView(record, "id"), 1, all_particles,
+            "id", &(particles[0]));
+
+    dataCollector->close();
+
+    fattr.fileAccType = DataCollector::FAT_READ;
+    dataCollector->open(HDF5_FILE_MEMBERS, fattr);
+
+    Dimensions size_read;
+    for (size_t c = 0; c < 3; ++c)
+    {
+        std::vector<float> values(size.getScalarSize());
+        dataCollector->read(0, (std::string("field/") + COMPONENTS[c]).c_str(),
+                size_read, &(values[0]));
+        CPPUNIT_ASSERT(size_read == size);
+
+        for (size_t i = 0; i < values.size(); ++i)
+            CPPUNIT_ASSERT(values[i] == getComponent(field[i], c));
+
+        const char* prefixes[] = {"selected/", "strided/"};
+        for (size_t p = 0; p < 2; ++p)
+        {
+            dataCollector->read(0, (std::string(prefixes[p]) + COMPONENTS[c]).c_str(),
+                    size_read, &(values[0]));
+            CPPUNIT_ASSERT(size_read == select.count);
+
+            for (size_t z = 0; z < select.count[2]; ++z)
+                for (size_t y = 0; y < select.count[1]; ++y)
+                    for (size_t x = 0; x < select.count[0]; ++x)
+                    {
+                        size_t index = (z * select.count[1] + y) * select.count[0] + x;
+                        size_t src_index =
+                                ((select.offset[2] + z * select.stride[2]) * size[1] +
+                                select.offset[1] + y * select.stride[1]) * size[0] +
+                                select.offset[0] + x * select.stride[0];
+
+                        CPPUNIT_ASSERT(values[index] == getComponent(field[src_index], c));
+                    }
+        }
+    }
+
+    std::vector<float> weights(particles.size());
+    std::vector<int32_t> ids(particles.size());
+    dataCollector->read(0, "weight", size_read, &(weights[0]));
+    CPPUNIT_ASSERT(size_read == all_particles.count);
+    dataCollector->read(0, "id", size_read, &(ids[0]));
+    CPPUNIT_ASSERT(size_read == all_particles.count);
+
+    for (size_t i = 0; i < particles.size(); ++i)
+    {
+        CPPUNIT_ASSERT(weights[i] == particles[i].weight);
+        CPPUNIT_ASSERT(ids[i] == particles[i].id);
+    }
+
+    dataCollector->close();
+}
+
 void SimpleDataTest::testNullWrite()
 {
     DataCollector::FileCreationAttr fileCAttr;
@@ -0,0 +1,244 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "StatisticsTest.h"
+
+#include <time.h>
+#include <stdlib.h>
+#include <math.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StatisticsTest);
+
+#define HDF5_FILE "h5/testStatistics"
+
+using namespace splash;
+
+StatisticsTest::StatisticsTest()
+{
+    dataCollector = new SerialDataCollector(10);
+    srand(time(NULL));
+}
+
+StatisticsTest::~StatisticsTest()
+{
+    if (dataCollector != NULL)
+    {
+        delete dataCollector;
+        dataCollector = NULL;
+    }
+}
+
+template<typename T>
+void StatisticsTest::getExpected(const T *data, size_t elements,
+        double minValue, double maxValue, std::vector<uint64_t> &indices)
+{
+    indices.clear();
+    for (size_t i = 0; i < elements; ++i)
+        if ((double) data[i] >= minValue && (double) data[i] <= maxValue)
+            indices.push_back(i);
+}
+
+void StatisticsTest::testGridRange()
+{
+    const Dimensions grid_size(64, 48, 40);
+    const Dimensions border(2, 1, 0);
+    const Dimensions buffer_size(grid_size[0] + 2 * border[0],
+            grid_size[1] + 2 * border[1], grid_size[2] + 2 * border[2]);
+    const size_t elements = grid_size.getScalarSize();
+
+    // smooth field with NaN in the border and in the last plane
+    float *buffer = new float[buffer_size.getScalarSize()];
+    float *data = new float[elements];
+    for (size_t z = 0; z < buffer_size[2]; ++z)
+        for (size_t y = 0; y < buffer_size[1]; ++y)
+            for (size_t x = 0; x < buffer_size[0]; ++x)
+            {
+                const size_t index = (z * buffer_size[1] + y) * buffer_size[0] + x;
+                if (x < border[0] || y < border[1] || z < border[2] ||
+                        x >= border[0] + grid_size[0] || y >= border[1] + grid_size[1] ||
+                        z >= border[2] + grid_size[2] || z == buffer_size[2] - 1)
+                {
+                    buffer[index] = NAN;
+                } else
+                    buffer[index] = (float) (x + 2 * y + 4 * z);
+            }
+
+    for (size_t z = 0; z < grid_size[2]; ++z)
+        for (size_t y = 0; y < grid_size[1]; ++y)
+            for (size_t x = 0; x < grid_size[0]; ++x)
+                data[(z * grid_size[1] + y) * grid_size[0] + x] =
+                    buffer[((z + border[2]) * buffer_size[1] + y + border[1]) *
+                    buffer_size[0] + x + border[0]];
+
+    DataCollector::FileCreationAttr fileCAttr;
+    DataCollector::initFileCreationAttr(fileCAttr);
+    fileCAttr.enableCompression = true;
+    dataCollector->open(HDF5_FILE, fileCAttr);
+
+    dataCollector->setStatisticsBlockSize(1);
+    dataCollector->write(0, ctFloat, 3,
+            Selection(buffer_size, grid_size, border), "grid", buffer);
+    // without statistics
+    dataCollector->setStatisticsBlockSize(0);
+    dataCollector->write(0, ctFloat, 3,
+            Selection(buffer_size, grid_size, border), "plain", buffer);
+
+    dataCollector->close();
+
+    fileCAttr.fileAccType = DataCollector::FAT_READ;
+    dataCollector->open(HDF5_FILE, fileCAttr);
+
+    std::vector<uint64_t> indices, expected;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        const double min_value = (double) (rand() % 300);
+        const double max_value = min_value + (double) (rand() % 20);
+
+        getExpected(data, elements, min_value, max_value, expected);
+
+        const uint64_t elements_read = dataCollector->readRange(0, "grid",
+                min_value, max_value, indices);
+        CPPUNIT_ASSERT(indices == expected);
+        CPPUNIT_ASSERT(elements_read >= expected.size());
+        CPPUNIT_ASSERT(elements_read < elements);
+
+        CPPUNIT_ASSERT(dataCollector->readRange(0, "plain",
+                min_value, max_value, indices) == elements);
+        CPPUNIT_ASSERT(indices == expected);
+    }
+
+    // only NaN
+    CPPUNIT_ASSERT(dataCollector->readRange(0, "grid", 1000.0, 2000.0, indices) == 0);
+    CPPUNIT_ASSERT(indices.empty());
+
+    dataCollector->close();
+
+    delete[] buffer;
+    delete[] data;
+}
+
+void StatisticsTest::testPolyRange()
+{
+    const size_t num_appends = 7;
+    const size_t block_elements = 100;
+
+    DataCollector::FileCreationAttr fileCAttr;
+    DataCollector::initFileCreationAttr(fileCAttr);
+    dataCollector->open(HDF5_FILE, fileCAttr);
+    dataCollector->setStatisticsBlockSize(block_elements);
+
+    // sorted positions, every part is appended twice,
+    // parts do not align with blocks
+    std::vector<int64_t> data;
+    int64_t value = -500;
+    for (size_t i = 0; i < num_appends; ++i)
+    {
+        const size_t count = (i == 3) ? 0 : 50 + rand() % 200;
+        std::vector<int64_t> part(2 * count + 1);
+        for (size_t j = 0; j < count; ++j)
+            part[2 * j + 1] = value++;
+
+        for (size_t k = 0; k < 2; ++k)
+        {
+            // every second element of part
+            dataCollector->append(0, ctInt64, count, 1, 2, "position", &(part[0]));
+            for (size_t j = 0; j < count; ++j)
+                data.push_back(part[2 * j + 1]);
+        }
+    }
+
+    dataCollector->setStatisticsBlockSize(0);
+    dataCollector->close();
+
+    fileCAttr.fileAccType = DataCollector::FAT_READ;
+    dataCollector->open(HDF5_FILE, fileCAttr);
+
+    std::vector<uint64_t> indices, expected;
+    for (size_t i = 0; i < 20; ++i)
+    {
+        const double min_value = (double) (rand() % (data.size() / 2)) - 500.0;
+        const double max_value = min_value + (double) (rand() % 50);
+
+        getExpected(&(data[0]), data.size(), min_value, max_value, expected);
+
+        const uint64_t elements_read = dataCollector->readRange(0, "position",
+                min_value, max_value, indices);
+        CPPUNIT_ASSERT(indices == expected);
+        // matches form up to three runs (across two parts),
+        // with partial blocks at both ends
+        CPPUNIT_ASSERT(elements_read <= expected.size() + 6 * block_elements);
+    }
+
+    dataCollector->close();
+}
+
+void StatisticsTest::testOutdatedStatistics()
+{
+    const size_t elements = 1000;
+    float data[elements];
+    for (size_t i = 0; i < elements; ++i)
+        data[i] = (float) i;
+
+    DataCollector::FileCreationAttr fileCAttr;
+    DataCollector::initFileCreationAttr(fileCAttr);
+    dataCollector->open(HDF5_FILE, fileCAttr);
+    dataCollector->close();
+
+    // reading is permitted when writing to an existing file
+    fileCAttr.fileAccType = DataCollector::FAT_WRITE;
+    dataCollector->open(HDF5_FILE, fileCAttr);
+
+    std::vector<uint64_t> indices;
+
+    // appending without statistics invalidates them
+    dataCollector->setStatisticsBlockSize(10);
+    dataCollector->append(0, ctFloat, elements / 2, "data", data);
+    CPPUNIT_ASSERT(dataCollector->readRange(0, "data", 0.0, 5.0, indices) == 10);
+    CPPUNIT_ASSERT(indices.size() == 6);
+
+    dataCollector->setStatisticsBlockSize(0);
+    dataCollector->append(0, ctFloat, elements / 2, "data", data + elements / 2);
+    CPPUNIT_ASSERT(dataCollector->readRange(0, "data", 0.0, 5.0, indices) == elements);
+    CPPUNIT_ASSERT(indices.size() == 6);
+
+    // statistics cannot be extended for existing data without statistics
+    dataCollector->setStatisticsBlockSize(10);
+    dataCollector->append(0, ctFloat, 1, "data", data);
+    CPPUNIT_ASSERT(dataCollector->readRange(0, "data", 0.0, 5.0, indices) == elements + 1);
+    CPPUNIT_ASSERT(indices.size() == 7);
+
+    // rewriting without statistics removes them
+    dataCollector->write(0, ctFloat, 1, Selection(Dimensions(elements, 1, 1)),
+            "grid", data);
+    CPPUNIT_ASSERT(dataCollector->readRange(0, "grid", 0.0, 5.0, indices) == 10);
+
+    dataCollector->setStatisticsBlockSize(0);
+    dataCollector->write(0, ctFloat, 1, Selection(Dimensions(elements, 1, 1)),
+            "grid", data);
+    CPPUNIT_ASSERT(dataCollector->readRange(0, "grid", 0.0, 5.0, indices) == elements);
+    CPPUNIT_ASSERT(indices.size() == 6);
+
+    dataCollector->remove(0, "data");
+    dataCollector->remove(0);
+
+    dataCollector->close();
+}
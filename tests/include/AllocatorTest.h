@@ -0,0 +1,51 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALLOCATORTEST_H
+#define ALLOCATORTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "splash/splash.h"
+
+using namespace splash;
+
+class AllocatorTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(AllocatorTest);
+
+    CPPUNIT_TEST(testAllocators);
+    CPPUNIT_TEST(testReadDomain);
+
+    CPPUNIT_TEST_SUITE_END();
+public:
+
+    AllocatorTest();
+    virtual ~AllocatorTest();
+private:
+    void testAllocators();
+    void testReadDomain();
+
+    ColTypeFloat ctFloat;
+};
+
+#endif /* ALLOCATORTEST_H */
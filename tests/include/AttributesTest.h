@@ -37,6 +37,7 @@ class AttributesTest  : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST(testAttributesMeta);
     CPPUNIT_TEST(testArrayTypes);
     CPPUNIT_TEST(testArrayAttributesMeta);
+    CPPUNIT_TEST(testBulkAttributes);
 
     CPPUNIT_TEST_SUITE_END();
 public:
@@ -47,6 +48,7 @@ private:
     void testArrayTypes();
     void testAttributesMeta();
     void testArrayAttributesMeta();
+    void testBulkAttributes();
 
     ColTypeChar ctChar;
     ColTypeDouble ctDouble;
@@ -36,6 +36,17 @@ class DomainsTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST(testGridDomains);
     CPPUNIT_TEST(testPolyDomains);
     CPPUNIT_TEST(testAppendDomains);
+    CPPUNIT_TEST(testDomainIndex);
+    CPPUNIT_TEST(testElementAccess);
+    CPPUNIT_TEST(testDomainTable);
+    CPPUNIT_TEST(testCollectiveRead);
+    CPPUNIT_TEST(testStridedDomains);
+    CPPUNIT_TEST(testPolyFiltered);
+    CPPUNIT_TEST(testLazyPaging);
+    CPPUNIT_TEST(testReadInto);
+    CPPUNIT_TEST(testReadTiled);
+    CPPUNIT_TEST(testPackedAttributes);
+    CPPUNIT_TEST(testThreadedRead);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -55,6 +66,28 @@ private:
 
     void testAppendDomains();
 
+    void testDomainIndex();
+
+    void testElementAccess();
+
+    void testDomainTable();
+
+    void testCollectiveRead();
+
+    void testStridedDomains();
+
+    void testPolyFiltered();
+
+    void testLazyPaging();
+
+    void testReadInto();
+
+    void testReadTiled();
+
+    void testPackedAttributes();
+
+    void testThreadedRead();
+
     int totalMpiSize;
     int totalMpiRank;
 
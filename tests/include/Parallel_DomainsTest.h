@@ -36,6 +36,10 @@ class Parallel_DomainsTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST(testGridDomains);
     CPPUNIT_TEST(testPolyDomains);
     CPPUNIT_TEST(testAppendDomains);
+    CPPUNIT_TEST(testCollectiveAppendDomains);
+    CPPUNIT_TEST(testRedistributionRead);
+    CPPUNIT_TEST(testDomainTable);
+    CPPUNIT_TEST(testStridedRead);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -48,6 +52,10 @@ private:
     void testGridDomains();
     void testPolyDomains();
     void testAppendDomains();
+    void testCollectiveAppendDomains();
+    void testRedistributionRead();
+    void testDomainTable();
+    void testStridedRead();
 
     void subTestGridDomains(int32_t iteration,
             int currentMpiRank,
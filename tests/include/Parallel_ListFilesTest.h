@@ -34,6 +34,7 @@ class Parallel_ListFilesTest  : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST_SUITE(Parallel_ListFilesTest);
 
     CPPUNIT_TEST(testListFiles);
+    CPPUNIT_TEST(testIterationIndex);
 
     CPPUNIT_TEST_SUITE_END();
 public:
@@ -41,6 +42,7 @@ public:
     virtual ~Parallel_ListFilesTest();
 private:
     void testListFiles();
+    void testIterationIndex();
 
     ColTypeInt32 ctInt;
     int mpiRank;
@@ -35,6 +35,8 @@ class Parallel_SimpleDataTest : public CPPUNIT_NS::TestFixture
 
     CPPUNIT_TEST(testWriteRead);
     CPPUNIT_TEST(testFill);
+    CPPUNIT_TEST(testTransferPolicy);
+    CPPUNIT_TEST(testMultiSelection);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -52,6 +54,17 @@ private:
 
     void testFill();
 
+    /**
+     * Writes data with forced and automatic transfer modes
+     * and checks the transfer reports.
+     */
+    void testTransferPolicy();
+
+    /**
+     * Writes and reads several blocks per process in one call.
+     */
+    void testMultiSelection();
+
     bool testData(const Dimensions mpiSize, const Dimensions gridSize,
             int32_t *data);
 
@@ -35,6 +35,13 @@ class SimpleDataTest : public CPPUNIT_NS::TestFixture
 
     CPPUNIT_TEST(testNullWrite);
     CPPUNIT_TEST(testWriteRead);
+    CPPUNIT_TEST(testSlices);
+    CPPUNIT_TEST(testIterationReader);
+    CPPUNIT_TEST(testTypedAccess);
+    CPPUNIT_TEST(testTypeRecognition);
+    CPPUNIT_TEST(testRecords);
+    CPPUNIT_TEST(testRecordsSoA);
+    CPPUNIT_TEST(testMemberView);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -55,6 +62,42 @@ private:
      */
     void testNullWrite();
 
+    /**
+     * Reads slices along all axes of a compressed dataset.
+     */
+    void testSlices();
+
+    /**
+     * Reads all iterations of a file with an IterationReader.
+     */
+    void testIterationReader();
+
+    /**
+     * Writes and reads data with the typed write<T> and read<T>.
+     */
+    void testTypedAccess();
+
+    /**
+     * Recognizes the types of datasets with and without
+     * the type cache and registered user types.
+     */
+    void testTypeRecognition();
+
+    /**
+     * Writes and reads records as one compound dataset.
+     */
+    void testRecords();
+
+    /**
+     * Writes and reads records as one dataset per member.
+     */
+    void testRecordsSoA();
+
+    /**
+     * Writes members of interleaved structs with MemberView.
+     */
+    void testMemberView();
+
     /**
      * sub function for testWriteRead to allow several data/border sizes to be tested.
      */
@@ -0,0 +1,61 @@
+/**
+ * Copyright 2026 libSplash contributors
+ *
+ * This file is part of libSplash.
+ *
+ * libSplash is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libSplash is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libSplash.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef STATISTICSTEST_H
+#define STATISTICSTEST_H
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdint.h>
+#include <vector>
+
+#include "splash/splash.h"
+
+using namespace splash;
+
+class StatisticsTest : public CPPUNIT_NS::TestFixture
+{
+    CPPUNIT_TEST_SUITE(StatisticsTest);
+
+    CPPUNIT_TEST(testGridRange);
+    CPPUNIT_TEST(testPolyRange);
+    CPPUNIT_TEST(testOutdatedStatistics);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    StatisticsTest();
+    virtual ~StatisticsTest();
+private:
+    void testGridRange();
+    void testPolyRange();
+    void testOutdatedStatistics();
+
+    template<typename T>
+    static void getExpected(const T *data, size_t elements,
+            double minValue, double maxValue, std::vector<uint64_t> &indices);
+
+    ColTypeFloat ctFloat;
+    ColTypeInt64 ctInt64;
+    SerialDataCollector *dataCollector;
+};
+
+#endif /* STATISTICSTEST_H */